@@ -0,0 +1,161 @@
+#pragma once
+
+// src/bench/BenchScenes.h – Scripted scenes driven by sdl_appBench
+#include "../scene/Scene2D.h"
+#include "../scenes/InputEnabledScene.h"
+#include "../ecs/components/CommonComponents.h"
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+    /**
+     * @brief Small xorshift generator, so every platform places the same entities
+     *
+     * The standard distributions are implementation-defined, which would make
+     * runs on different toolchains do different work.
+     */
+    class DeterministicRandom {
+        uint64_t state;
+    public:
+        explicit DeterministicRandom(uint64_t seed) : state(seed ? seed : 1) {}
+
+        uint64_t next() {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            return state;
+        }
+
+        /// Uniform float in [min, max)
+        float range(float min, float max) {
+            const float unit = static_cast<float>(next() >> 40) / static_cast<float>(1ull << 24);
+            return min + (max - min) * unit;
+        }
+    };
+
+    /**
+     * @brief Scene2D whose content is created by a benchmark script
+     *
+     * Registers the standard Scene2D systems (physics, health, 2D rendering),
+     * so update() runs the same ECS and render-queue path as the game.
+     */
+    class BenchScene : public scene::Scene2D {
+        std::deque<ecs::Entity> spawned;
+        DeterministicRandom random;
+        bool moving;
+
+    public:
+        /**
+         * @param moving Whether spawned quads get a velocity
+         * @param seed Seed for entity placement
+         */
+        BenchScene(bool moving, uint64_t seed) : random(seed), moving(moving) {
+            setName("BenchScene");
+        }
+
+        void onAttach(scene::SceneManager& manager) override {
+            initialize2D(manager);
+        }
+
+        /**
+         * @brief Spawns colored quads at deterministic positions
+         * @param count Quads to spawn
+         */
+        void spawn(size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                const math::Vec2f position(random.range(-960.0f, 960.0f), random.range(-540.0f, 540.0f));
+                const scene::Color color(random.range(0.0f, 1.0f), random.range(0.0f, 1.0f), random.range(0.0f, 1.0f), 1.0f);
+                const uint32_t layer = static_cast<uint32_t>(random.next() % 4);
+
+                ecs::Entity entity = createColoredQuad(position, math::Vec2f(8.0f, 8.0f), color, layer);
+                if (moving) {
+                    coordinator->addComponent(entity, ecs::components::Velocity(
+                        math::Vec3f(random.range(-50.0f, 50.0f), random.range(-50.0f, 50.0f), 0.0f)));
+                }
+                spawned.push_back(entity);
+            }
+        }
+
+        /**
+         * @brief Destroys the oldest spawned entities
+         * @param count Entities to destroy
+         */
+        void despawnOldest(size_t count) {
+            for (size_t i = 0; i < count && !spawned.empty(); ++i) {
+                coordinator->destroyEntity(spawned.front());
+                spawned.pop_front();
+            }
+        }
+
+        size_t getSpawnedCount() const { return spawned.size(); }
+
+        /**
+         * @brief Sums every entity position, to compare the end state of two runs
+         */
+        double positionChecksum() const {
+            double sum = 0.0;
+            for (ecs::Entity entity : spawned) {
+                const auto& transform = coordinator->getComponent<ecs::components::Transform>(entity);
+                sum += transform.position.x() + transform.position.y();
+            }
+            return sum;
+        }
+    };
+
+    /**
+     * @brief Input scene fed by a recorded event log, run on top of a BenchScene
+     *
+     * Replays the input systems of a recorded session at its fixed timestep,
+     * so the same session can be benchmarked again and again headlessly.
+     */
+    class ReplayScene : public game::InputEnabledScene {
+        std::string logPath;
+
+    public:
+        /**
+         * @param logPath Event log written by InputEnabledScene::startEventRecording()
+         */
+        explicit ReplayScene(std::string logPath) : InputEnabledScene("ReplayScene"), logPath(std::move(logPath)) {
+            setPausesUnderlying(false);
+        }
+
+        void onAttach(scene::SceneManager& manager) override {
+            InputEnabledScene::onAttach(manager);
+            startEventReplay(logPath);
+        }
+    };
+
+    /**
+     * @brief A named benchmark: how to build the scene and what to do every frame
+     */
+    struct Scenario {
+        std::string name;
+        std::string description;
+        bool moving;
+        /// Runs before every frame's update; receives the frame index and the entity count K
+        std::function<void(BenchScene&, size_t frame, size_t entityCount)> perFrame;
+    };
+
+    /**
+     * @brief Gets the scripted scenarios, in the order they run
+     */
+    inline const std::vector<Scenario>& getScenarios() {
+        static const std::vector<Scenario> scenarios = {
+            { "static_sprites", "K static quads: render-queue path only", false, {} },
+            { "moving_sprites", "K quads moved by PhysicsSystem every frame", true, {} },
+            { "spawn_churn", "K moving quads, 10% destroyed and respawned every frame", true,
+                [](BenchScene& scene, size_t, size_t entityCount) {
+                    const size_t churn = entityCount / 10;
+                    scene.despawnOldest(churn);
+                    scene.spawn(churn);
+                } },
+        };
+        return scenarios;
+    }
+
+} // namespace bench
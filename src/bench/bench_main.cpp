@@ -0,0 +1,364 @@
+// sdl_appBench – headless, deterministic frame benchmark
+//
+// Runs every scripted scenario of BenchScenes.h for a fixed number of frames
+// at a fixed timestep on scene::NullBackend (no window, no GPU), and prints
+// frames/sec, per-phase timings, per-system timings and peak RSS as JSON.
+// Peak RSS is the process high-water mark, so it is reported once for the
+// whole run; select one --scenario per process to measure a scenario alone.
+// Per-system timings cover only the last SystemProfiler::HISTORY_SIZE
+// measured frames, given as "systemStatsWindow" and per system "samples".
+// With --replay, a recorded input session runs on top of every scenario,
+// for the recording's frame count at its timestep.
+//
+//   sdl_appBench [--scenario NAME] [--entities K] [--frames N] [--warmup W]
+//                [--timestep SECONDS] [--replay EVENTLOG] [--output FILE] [--verbose]
+
+#include "BenchScenes.h"
+#include "../scene/SceneSystem.h"
+#include "../scene/rendering/NullBackend.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace {
+
+    struct Options {
+        std::string scenario;
+        size_t entities = 10000;
+        size_t frames = 600;
+        size_t warmup = 60;
+        float timestep = 1.0f / 60.0f;
+        std::string replay;
+        std::string output;
+        bool verbose = false;
+    };
+
+    /// Timings of one phase, one entry per measured frame
+    struct PhaseTimes {
+        std::vector<double> ms;
+
+        void writeJson(std::ostream& out) const {
+            std::vector<double> sorted = ms;
+            std::sort(sorted.begin(), sorted.end());
+            auto percentile = [&sorted](double p) {
+                const size_t rank = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+                return sorted[rank];
+            };
+            double total = 0.0;
+            for (double value : sorted) {
+                total += value;
+            }
+            out << "{\"min\":" << sorted.front() << ",\"avg\":" << total / static_cast<double>(sorted.size())
+                << ",\"p50\":" << percentile(0.50) << ",\"p99\":" << percentile(0.99)
+                << ",\"max\":" << sorted.back() << "}";
+        }
+    };
+
+    struct ScenarioResult {
+        const bench::Scenario* scenario = nullptr;
+        double spawnMs = 0.0;
+        double totalSeconds = 0.0;
+        PhaseTimes frame;
+        PhaseTimes script;
+        PhaseTimes update;
+        PhaseTimes render;
+        size_t finalEntityCount = 0;
+        double checksum = 0.0;
+        std::vector<ecs::SystemTimingStats> systems;
+    };
+
+    using Clock = std::chrono::steady_clock;
+
+    double elapsedMs(Clock::time_point start, Clock::time_point end) {
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    }
+
+    /// Peak resident set size of the process so far, or 0 where unsupported
+    uint64_t peakRssBytes() {
+#if defined(_WIN32)
+        PROCESS_MEMORY_COUNTERS counters{};
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+            return static_cast<uint64_t>(counters.PeakWorkingSetSize);
+        }
+        return 0;
+#else
+        rusage usage{};
+        if (getrusage(RUSAGE_SELF, &usage) != 0) {
+            return 0;
+        }
+#if defined(__APPLE__)
+        return static_cast<uint64_t>(usage.ru_maxrss);
+#else
+        return static_cast<uint64_t>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+    }
+
+    void printUsage(std::ostream& out) {
+        out << "Usage: sdl_appBench [--scenario NAME] [--entities K] [--frames N] [--warmup W]\n"
+            << "                    [--timestep SECONDS] [--replay EVENTLOG] [--output FILE] [--verbose]\n"
+            << "--replay runs a recorded input session over each scenario; it sets the frames\n"
+            << "and timestep from the recording and disables warmup.\n"
+            << "Scenarios:\n";
+        for (const auto& scenario : bench::getScenarios()) {
+            out << "  " << scenario.name << " - " << scenario.description << "\n";
+        }
+    }
+
+    bool parseOptions(int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            auto value = [&]() -> const char* {
+                return i + 1 < argc ? argv[++i] : nullptr;
+            };
+
+            if (arg == "--verbose") {
+                options.verbose = true;
+                continue;
+            }
+            if (arg == "--help") {
+                return false;
+            }
+
+            static const char* const valued[] = { "--scenario", "--entities", "--frames", "--warmup", "--timestep", "--replay", "--output" };
+            if (std::find(std::begin(valued), std::end(valued), arg) == std::end(valued)) {
+                std::cerr << "Unknown option " << arg << "\n";
+                return false;
+            }
+            const char* text = value();
+            if (!text) {
+                std::cerr << "Missing value for " << arg << "\n";
+                return false;
+            }
+            if (arg == "--scenario") {
+                options.scenario = text;
+            } else if (arg == "--entities") {
+                options.entities = std::strtoull(text, nullptr, 10);
+            } else if (arg == "--frames") {
+                options.frames = std::strtoull(text, nullptr, 10);
+            } else if (arg == "--warmup") {
+                options.warmup = std::strtoull(text, nullptr, 10);
+            } else if (arg == "--timestep") {
+                options.timestep = std::strtof(text, nullptr);
+            } else if (arg == "--replay") {
+                options.replay = text;
+            } else {
+                options.output = text;
+            }
+        }
+
+        if (options.frames == 0 || options.timestep <= 0.0f) {
+            std::cerr << "--frames and --timestep must be positive\n";
+            return false;
+        }
+        return true;
+    }
+
+    ScenarioResult runScenario(const bench::Scenario& scenario, const Options& options) {
+        ScenarioResult result;
+        result.scenario = &scenario;
+
+        auto manager = scene::createSceneManager(std::make_unique<scene::NullBackend>(), 1920, 1080);
+        if (!manager) {
+            throw std::runtime_error("Failed to initialize the scene manager");
+        }
+
+        auto ownedScene = std::make_unique<bench::BenchScene>(scenario.moving, 0x5eed5eedull);
+        bench::BenchScene& benchScene = *ownedScene;
+        manager->pushScene(std::move(ownedScene));
+
+        const Clock::time_point spawnStart = Clock::now();
+        benchScene.spawn(options.entities);
+        result.spawnMs = elapsedMs(spawnStart, Clock::now());
+
+        if (!options.replay.empty()) {
+            manager->pushScene(std::make_unique<bench::ReplayScene>(options.replay));
+        }
+
+        const size_t totalFrames = options.warmup + options.frames;
+        const Clock::time_point runStart = Clock::now();
+        Clock::time_point measureStart = runStart;
+
+        for (size_t frame = 0; frame < totalFrames; ++frame) {
+            if (frame == options.warmup) {
+                measureStart = Clock::now();
+                benchScene.getCoordinator()->getSystemProfiler().reset();
+            }
+
+            const Clock::time_point frameStart = Clock::now();
+            if (scenario.perFrame) {
+                scenario.perFrame(benchScene, frame, options.entities);
+            }
+            const Clock::time_point updateStart = Clock::now();
+            manager->update(options.timestep);
+            const Clock::time_point renderStart = Clock::now();
+            manager->render();
+            const Clock::time_point frameEnd = Clock::now();
+
+            if (frame >= options.warmup) {
+                result.frame.ms.push_back(elapsedMs(frameStart, frameEnd));
+                result.script.ms.push_back(elapsedMs(frameStart, updateStart));
+                result.update.ms.push_back(elapsedMs(updateStart, renderStart));
+                result.render.ms.push_back(elapsedMs(renderStart, frameEnd));
+            }
+        }
+
+        result.totalSeconds = elapsedMs(measureStart, Clock::now()) / 1000.0;
+        result.finalEntityCount = benchScene.getCoordinator()->getLivingEntityCount();
+        result.checksum = benchScene.positionChecksum();
+        result.systems = benchScene.getCoordinator()->getSystemProfiler().getStats();
+
+        manager->shutdown();
+        return result;
+    }
+
+    void writeString(std::ostream& out, const std::string& text) {
+        out << '"';
+        for (char c : text) {
+            if (c == '"' || c == '\\') {
+                out << '\\';
+            }
+            out << c;
+        }
+        out << '"';
+    }
+
+    void writeReport(std::ostream& out, const Options& options, const std::vector<ScenarioResult>& results, uint64_t peakRss) {
+        out << std::fixed << std::setprecision(4);
+        out << "{\n  \"benchmark\": \"sdl_appBench\",\n"
+            << "  \"entities\": " << options.entities << ",\n"
+            << "  \"frames\": " << options.frames << ",\n"
+            << "  \"warmupFrames\": " << options.warmup << ",\n"
+            << "  \"timestep\": " << options.timestep << ",\n"
+            << "  \"replay\": ";
+        if (options.replay.empty()) {
+            out << "null";
+        } else {
+            writeString(out, options.replay);
+        }
+        out << ",\n"
+            << "  \"systemProfiling\": " << (ecs::SYSTEM_PROFILING_ENABLED ? "true" : "false") << ",\n"
+            << "  \"allocationCounting\": " << (ecs::ALLOCATION_COUNTING_ENABLED ? "true" : "false") << ",\n"
+            << "  \"systemStatsWindow\": " << ecs::SystemProfiler::HISTORY_SIZE << ",\n"
+            << "  \"peakRssBytes\": " << peakRss << ",\n"
+            << "  \"scenarios\": [";
+
+        for (size_t i = 0; i < results.size(); ++i) {
+            const ScenarioResult& result = results[i];
+            out << (i ? "," : "") << "\n    {\n      \"name\": ";
+            writeString(out, result.scenario->name);
+            out << ",\n      \"fps\": " << static_cast<double>(options.frames) / result.totalSeconds
+                << ",\n      \"spawnMs\": " << result.spawnMs
+                << ",\n      \"frameMs\": ";
+            result.frame.writeJson(out);
+            out << ",\n      \"phasesMs\": {\"script\": ";
+            result.script.writeJson(out);
+            out << ", \"update\": ";
+            result.update.writeJson(out);
+            out << ", \"render\": ";
+            result.render.writeJson(out);
+            out << "},\n      \"systems\": [";
+            for (size_t s = 0; s < result.systems.size(); ++s) {
+                const auto& system = result.systems[s];
+                out << (s ? ", " : "") << "{\"name\": ";
+                writeString(out, system.name);
+                out << ", \"samples\": " << system.sampleCount
+                    << ", \"avgMs\": " << system.avgMs << ", \"p99Ms\": " << system.p99Ms
+                    << ", \"entities\": " << system.entityCount
+                    << ", \"allocationsPerFrame\": ";
+                if constexpr (ecs::ALLOCATION_COUNTING_ENABLED) {
+                    out << static_cast<double>(system.totalAllocations) / static_cast<double>(options.frames);
+                } else {
+                    out << "null";
+                }
+                out << "}";
+            }
+            out << "],\n      \"finalEntities\": " << result.finalEntityCount
+                << ",\n      \"checksum\": " << result.checksum
+                << "\n    }";
+        }
+        out << "\n  ]\n}\n";
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(std::cerr);
+        return 2;
+    }
+
+    std::vector<const bench::Scenario*> selected;
+    for (const auto& scenario : bench::getScenarios()) {
+        if (options.scenario.empty() || options.scenario == scenario.name) {
+            selected.push_back(&scenario);
+        }
+    }
+    if (selected.empty()) {
+        std::cerr << "Unknown scenario " << options.scenario << "\n";
+        printUsage(std::cerr);
+        return 2;
+    }
+
+    if (!options.replay.empty()) {
+        try {
+            const ecs::EventReplay replay(options.replay);
+            if (replay.getFrameCount() == 0 || replay.getTimestep() <= 0.0f) {
+                std::cerr << "Event log " << options.replay << " has no frames to replay\n";
+                return 2;
+            }
+            options.frames = replay.getFrameCount();
+            options.timestep = replay.getTimestep();
+            options.warmup = 0;
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << "\n";
+            return 2;
+        }
+    }
+
+    // The scene system logs to std::cout; keep stdout clean for the report
+    if (!options.verbose) {
+        std::cout.setstate(std::ios::failbit);
+    }
+
+    std::vector<ScenarioResult> results;
+    try {
+        for (const bench::Scenario* scenario : selected) {
+            results.push_back(runScenario(*scenario, options));
+        }
+    } catch (const std::exception& e) {
+        std::cout.clear();
+        std::cerr << "Benchmark failed: " << e.what() << "\n";
+        return 1;
+    }
+    std::cout.clear();
+    const uint64_t peakRss = peakRssBytes();
+
+    if (options.output.empty()) {
+        writeReport(std::cout, options, results, peakRss);
+    } else {
+        std::ofstream file(options.output);
+        writeReport(file, options, results, peakRss);
+        if (!file) {
+            std::cerr << "Failed to write " << options.output << "\n";
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+// src/core/ChromeTrace.h – Clock, thread ids and writer shared by the Chrome trace exporters
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <ostream>
+#include <string>
+
+namespace core::chrome {
+
+    /**
+     * @brief Gets the current time in nanoseconds since the process trace epoch
+     *
+     * Every exporter stamps events with this clock, so their output can be
+     * written into one trace and lines up.
+     */
+    inline int64_t now() {
+        static const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count();
+    }
+
+    namespace detail {
+        inline std::atomic<uint32_t> nextThreadId{ 1 };
+    }
+
+    /**
+     * @brief Gets the trace track of the calling thread
+     *
+     * Threads are numbered from 1 in the order they first ask, the same
+     * numbering for every exporter.
+     */
+    inline uint32_t threadId() {
+        thread_local const uint32_t id = detail::nextThreadId.fetch_add(1, std::memory_order_relaxed);
+        return id;
+    }
+
+    /**
+     * @brief Writes text as a JSON string literal
+     */
+    inline void writeJsonString(std::ostream& out, const std::string& text) {
+        out << '"';
+        for (char c : text) {
+            if (c == '"' || c == '\\') {
+                out << '\\';
+            }
+            out << c;
+        }
+        out << '"';
+    }
+
+    /**
+     * @brief Writes nanoseconds as microseconds with three decimals, the unit trace events use
+     */
+    inline void writeMicroseconds(std::ostream& out, int64_t nanoseconds) {
+        char text[32];
+        std::snprintf(text, sizeof(text), "%lld.%03lld",
+            static_cast<long long>(nanoseconds / 1000), static_cast<long long>(nanoseconds % 1000));
+        out << text;
+    }
+
+    /**
+     * @brief Writes one Chrome trace-event JSON document, to which several exporters add events
+     *
+     * The constructor opens the document and finish() closes it; every
+     * event starts with beginEvent(), which places the separator.
+     */
+    class TraceEventWriter {
+        std::ostream& mOut;
+        bool mFirst = true;
+
+    public:
+        explicit TraceEventWriter(std::ostream& out) : mOut(out) {
+            mOut << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        }
+
+        TraceEventWriter(const TraceEventWriter&) = delete;
+        TraceEventWriter& operator=(const TraceEventWriter&) = delete;
+
+        /**
+         * @brief Starts a new event and returns the stream to write it to
+         */
+        std::ostream& beginEvent() {
+            if (!mFirst) {
+                mOut << ',';
+            }
+            mFirst = false;
+            mOut << '\n';
+            return mOut;
+        }
+
+        /**
+         * @brief Writes a complete ("X") event up to its arguments, which the caller may add before closing it with '}'
+         */
+        std::ostream& beginComplete(const std::string& name, const char* category, uint32_t thread, int64_t startNs, int64_t durationNs) {
+            std::ostream& out = beginEvent();
+            out << "{\"name\":";
+            writeJsonString(out, name);
+            out << ",\"cat\":\"" << category << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << thread << ",\"ts\":";
+            writeMicroseconds(out, startNs);
+            out << ",\"dur\":";
+            writeMicroseconds(out, durationNs);
+            return out;
+        }
+
+        /**
+         * @brief Writes the metadata event naming a thread's track
+         */
+        void threadName(uint32_t thread, const std::string& name) {
+            std::ostream& out = beginEvent();
+            out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread << ",\"args\":{\"name\":";
+            writeJsonString(out, name);
+            out << "}}";
+        }
+
+        /**
+         * @brief Closes the document
+         */
+        void finish() {
+            mOut << "\n]}\n";
+        }
+    };
+
+} // namespace core::chrome
@@ -0,0 +1,125 @@
+#include "Trace.h"
+#include <atomic>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace core {
+
+    namespace {
+
+        /**
+         * One ring slot, guarded by a sequence lock: the sequence is odd
+         * while the owning thread rewrites the slot, so a reader that sees
+         * the same even value before and after copying it has a whole zone.
+         */
+        struct Slot {
+            std::atomic<uint64_t> sequence{ 0 };
+            std::atomic<const char*> name{ nullptr };
+            std::atomic<int64_t> start{ 0 };
+            std::atomic<int64_t> end{ 0 };
+        };
+
+        struct ThreadBuffer {
+            uint32_t thread = 0;
+            std::string name;
+            size_t next = 0;
+            Slot slots[Trace::THREAD_BUFFER_SIZE];
+        };
+
+        struct Registry {
+            std::mutex mutex;
+            std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+            std::atomic<int64_t> clearedAt{ INT64_MIN };
+        };
+
+        Registry& registry() {
+            // Never destroyed, so threads that outlive static destruction can still record
+            static Registry* instance = new Registry();
+            return *instance;
+        }
+
+        thread_local ThreadBuffer* tBuffer = nullptr;
+
+        ThreadBuffer& threadBuffer() {
+            if (!tBuffer) {
+                Registry& reg = registry();
+                std::lock_guard<std::mutex> lock(reg.mutex);
+                auto buffer = std::make_unique<ThreadBuffer>();
+                buffer->thread = chrome::threadId();
+                tBuffer = buffer.get();
+                reg.buffers.push_back(std::move(buffer));
+            }
+            return *tBuffer;
+        }
+    }
+
+    void Trace::record(const char* name, int64_t startNs, int64_t endNs) {
+        ThreadBuffer& buffer = threadBuffer();
+        Slot& slot = buffer.slots[buffer.next];
+        buffer.next = (buffer.next + 1) % THREAD_BUFFER_SIZE;
+
+        const uint64_t sequence = slot.sequence.load(std::memory_order_relaxed);
+        slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.name.store(name, std::memory_order_relaxed);
+        slot.start.store(startNs, std::memory_order_relaxed);
+        slot.end.store(endNs, std::memory_order_relaxed);
+        slot.sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    void Trace::setThreadName(const std::string& name) {
+        ThreadBuffer& buffer = threadBuffer();
+        std::lock_guard<std::mutex> lock(registry().mutex);
+        buffer.name = name;
+    }
+
+    void Trace::clear() {
+        registry().clearedAt.store(now(), std::memory_order_relaxed);
+    }
+
+    void Trace::writeEvents(chrome::TraceEventWriter& writer) {
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        const int64_t clearedAt = reg.clearedAt.load(std::memory_order_relaxed);
+
+        for (const auto& buffer : reg.buffers) {
+            if (!buffer->name.empty()) {
+                writer.threadName(buffer->thread, buffer->name);
+            }
+
+            for (const Slot& slot : buffer->slots) {
+                const uint64_t before = slot.sequence.load(std::memory_order_acquire);
+                if (before == 0 || (before & 1) != 0) {
+                    continue;
+                }
+                const char* name = slot.name.load(std::memory_order_relaxed);
+                const int64_t start = slot.start.load(std::memory_order_relaxed);
+                const int64_t end = slot.end.load(std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (slot.sequence.load(std::memory_order_relaxed) != before || start < clearedAt) {
+                    continue;
+                }
+
+                writer.beginComplete(name, "zone", buffer->thread, start, end - start) << "}";
+            }
+        }
+    }
+
+    void Trace::writeChromeTrace(std::ostream& out) {
+        chrome::TraceEventWriter writer(out);
+        writeEvents(writer);
+        writer.finish();
+    }
+
+    bool Trace::writeChromeTrace(const std::string& path) {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            return false;
+        }
+        writeChromeTrace(file);
+        return static_cast<bool>(file);
+    }
+
+} // namespace core
@@ -0,0 +1,119 @@
+#pragma once
+
+// src/core/Trace.h – Scoped trace zones exported as Chrome trace-event JSON
+#include "ChromeTrace.h"
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+// Trace zones are on in debug builds; define TRACE_ZONES to 0 or 1 to override
+#ifndef TRACE_ZONES
+#ifdef NDEBUG
+#define TRACE_ZONES 0
+#else
+#define TRACE_ZONES 1
+#endif
+#endif
+
+namespace core {
+
+    /// Whether TRACE_ZONE() records anything in this build
+    static constexpr bool TRACE_ZONES_ENABLED = TRACE_ZONES != 0;
+
+    /**
+     * @brief Process-wide recorder of timed zones
+     *
+     * Every thread writes its zones into its own fixed-size ring buffer,
+     * without locks: the first zone a thread records registers its buffer
+     * under a mutex, after which recording is a few relaxed stores. When a
+     * ring is full the oldest zones are overwritten, so a dump always holds
+     * the most recent THREAD_BUFFER_SIZE zones of each thread.
+     *
+     * writeChromeTrace() may run on any thread while others keep recording;
+     * zones being overwritten during the dump are skipped. The output loads
+     * in chrome://tracing and Perfetto. Zones use the clock and thread
+     * tracks of core::chrome, so writeEvents() can share a document with
+     * other exporters such as ecs::SystemProfiler.
+     *
+     * Use the TRACE_ZONE() macro rather than this class directly, so the
+     * zones compile out when TRACE_ZONES is 0.
+     */
+    class Trace {
+    public:
+        /// Zones kept per thread
+        static constexpr size_t THREAD_BUFFER_SIZE = 8192;
+
+        /**
+         * @brief Gets the current time in nanoseconds since the trace epoch
+         */
+        static int64_t now() {
+            return chrome::now();
+        }
+
+        /**
+         * @brief Records a finished zone on the calling thread
+         * @param name Zone name; must outlive the trace (a string literal)
+         * @param startNs Start time from now()
+         * @param endNs End time from now()
+         */
+        static void record(const char* name, int64_t startNs, int64_t endNs);
+
+        /**
+         * @brief Names the calling thread in the exported trace
+         */
+        static void setThreadName(const std::string& name);
+
+        /**
+         * @brief Drops every zone recorded so far from later dumps
+         */
+        static void clear();
+
+        /**
+         * @brief Adds the recorded zones and thread names to a trace document
+         * @param writer Document being written
+         */
+        static void writeEvents(chrome::TraceEventWriter& writer);
+
+        /**
+         * @brief Writes the recorded zones as Chrome trace-event JSON
+         * @param out Stream to write to
+         */
+        static void writeChromeTrace(std::ostream& out);
+
+        /**
+         * @brief Writes the recorded zones as Chrome trace-event JSON to a file
+         * @param path File to create or replace
+         * @return true if the file was written
+         */
+        static bool writeChromeTrace(const std::string& path);
+    };
+
+    /**
+     * @brief Records the time between its construction and destruction as a zone
+     */
+    class TraceZone {
+        const char* name;
+        int64_t start;
+    public:
+        explicit TraceZone(const char* name) : name(name), start(Trace::now()) {}
+        ~TraceZone() { Trace::record(name, start, Trace::now()); }
+
+        TraceZone(const TraceZone&) = delete;
+        TraceZone& operator=(const TraceZone&) = delete;
+    };
+
+} // namespace core
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+
+#if TRACE_ZONES
+/// Times the rest of the enclosing scope; name must be a string literal
+#define TRACE_ZONE(name) ::core::TraceZone TRACE_CONCAT(traceZone_, __LINE__)(name)
+/// Names the calling thread in the exported trace
+#define TRACE_THREAD_NAME(name) ::core::Trace::setThreadName(name)
+#else
+#define TRACE_ZONE(name) ((void)0)
+#define TRACE_THREAD_NAME(name) ((void)0)
+#endif
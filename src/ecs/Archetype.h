@@ -0,0 +1,518 @@
+#pragma once
+
+#include "ECSTypes.h"
+#include "WorldSnapshot.h"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ecs {
+
+    /**
+     * @brief Type-erased description of a component type
+     *
+     * Lets storage that is not templated on the component type (such as
+     * archetype chunks) construct, move and destroy components.
+     */
+    struct ComponentInfo {
+        size_t size = 0;
+        size_t alignment = 1;
+        bool triviallyCopyable = false;
+        void (*moveConstruct)(void* destination, void* source) = nullptr;
+        void (*copyConstruct)(void* destination, const void* source) = nullptr;
+        void (*destroy)(void* component) = nullptr;
+
+        /**
+         * @brief Builds the description for a component type
+         * @tparam T Component type
+         */
+        template<typename T>
+        static ComponentInfo create() {
+            ComponentInfo info;
+            info.size = sizeof(T);
+            info.alignment = alignof(T);
+            info.triviallyCopyable = std::is_trivially_copyable_v<T>;
+            info.moveConstruct = [](void* destination, void* source) {
+                ::new (destination) T(std::move(*static_cast<T*>(source)));
+            };
+            info.copyConstruct = [](void* destination, const void* source) {
+                ::new (destination) T(*static_cast<const T*>(source));
+            };
+            info.destroy = [](void* component) {
+                static_cast<T*>(component)->~T();
+            };
+            return info;
+        }
+    };
+
+    /**
+     * @brief Storage for all entities that share one exact Signature
+     *
+     * Entities are packed into fixed-size chunks. Each chunk is laid out as a
+     * structure of arrays: one array of entity handles followed by one array
+     * per component type, each starting on a cache line. Iterating a chunk
+     * therefore reads every component column linearly.
+     *
+     * A row too large for a chunk gets chunks of its own, sized for one row,
+     * and chunks are aligned for the most aligned column.
+     *
+     * Rows are numbered across chunks; all chunks except the last are full.
+     * Removing a row moves the archetype's last row into the hole, so pointers
+     * into an archetype are invalidated by any structural change to it.
+     *
+     * Change tracking is per chunk: each column of each chunk keeps the
+     * newest ChangeTick of its components. Rows moved between chunks carry
+     * their chunk's stamps along, so a chunk never looks older than the
+     * components it holds.
+     */
+    class Archetype {
+    public:
+        /// Size of one chunk in bytes
+        static constexpr size_t CHUNK_BYTES = 16 * 1024;
+
+        /// Alignment of every column inside a chunk
+        static constexpr size_t COLUMN_ALIGNMENT = CACHE_LINE_SIZE;
+
+        /// Marker for component types without a column in this archetype
+        static constexpr std::uint16_t NO_COLUMN = 0xFFFF;
+
+    private:
+        struct ChunkDeleter {
+            size_t alignment = COLUMN_ALIGNMENT;
+
+            void operator()(std::byte* chunk) const {
+                ::operator delete(chunk, std::align_val_t{ alignment });
+            }
+        };
+
+        using ChunkPtr = std::unique_ptr<std::byte, ChunkDeleter>;
+
+        struct Column {
+            ComponentType type;
+            ComponentInfo info;
+            size_t offset; // Byte offset of the column inside a chunk
+        };
+
+        /// Components every entity in this archetype has
+        Signature mSignature;
+
+        /// One column per component type, ordered by type ID
+        std::vector<Column> mColumns;
+
+        /// Column index per component type, NO_COLUMN if absent (16-bit to keep the table small)
+        std::array<std::uint16_t, MAX_COMPONENTS> mColumnOfType;
+
+        /// Rows per chunk
+        size_t mChunkCapacity = 0;
+
+        /// Bytes per chunk: CHUNK_BYTES, or one row if a row is larger
+        size_t mChunkBytes = CHUNK_BYTES;
+
+        /// Alignment of every chunk: COLUMN_ALIGNMENT, or the largest column alignment above it
+        size_t mChunkAlignment = COLUMN_ALIGNMENT;
+
+        /// Allocated chunks
+        std::vector<ChunkPtr> mChunks;
+
+        /// Newest change stamp per chunk and column, at [chunk * column count + column]
+        mutable std::vector<ChangeTick> mChangeTicks;
+
+        /// Number of occupied rows
+        size_t mSize = 0;
+
+        struct Edge {
+            ComponentType type;
+            Archetype* add;
+            Archetype* remove;
+        };
+
+        /// Cached transitions to the archetype with one component added/removed.
+        /// An archetype links to few others, so a short list searched linearly
+        /// replaces two tables with one slot per possible component type.
+        std::vector<Edge> mEdges;
+
+        const Edge* findEdge(ComponentType type) const {
+            for (const Edge& edge : mEdges) {
+                if (edge.type == type) {
+                    return &edge;
+                }
+            }
+            return nullptr;
+        }
+
+        Edge& edgeFor(ComponentType type) {
+            for (Edge& edge : mEdges) {
+                if (edge.type == type) {
+                    return edge;
+                }
+            }
+            return mEdges.emplace_back(Edge{ type, nullptr, nullptr });
+        }
+
+        static constexpr size_t alignUp(size_t value, size_t alignment) {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+
+        /**
+         * @brief Lays out the columns for a given row count
+         * @return Bytes needed, or a value above CHUNK_BYTES if it does not fit
+         */
+        size_t layoutColumns(size_t rows) {
+            size_t offset = alignUp(rows * sizeof(Entity), COLUMN_ALIGNMENT);
+            for (auto& column : mColumns) {
+                offset = alignUp(offset, std::max(column.info.alignment, COLUMN_ALIGNMENT));
+                column.offset = offset;
+                offset += rows * column.info.size;
+            }
+            return offset;
+        }
+
+        std::byte* rowAddress(size_t columnIndex, size_t row) const {
+            const Column& column = mColumns[columnIndex];
+            std::byte* chunk = mChunks[row / mChunkCapacity].get();
+            return chunk + column.offset + (row % mChunkCapacity) * column.info.size;
+        }
+
+        Entity& entityAt(size_t row) const {
+            std::byte* chunk = mChunks[row / mChunkCapacity].get();
+            return reinterpret_cast<Entity*>(chunk)[row % mChunkCapacity];
+        }
+
+        void addChunk() {
+            mChunks.emplace_back(static_cast<std::byte*>(::operator new(mChunkBytes, std::align_val_t{ mChunkAlignment })),
+                ChunkDeleter{ mChunkAlignment });
+            // Snapshots copy whole chunks, so unused rows and padding must not be left uninitialized
+            std::memset(mChunks.back().get(), 0, mChunkBytes);
+            mChangeTicks.resize(mChunks.size() * mColumns.size(), 0);
+        }
+
+        ChangeTick& changeTickAt(size_t columnIndex, size_t chunkIndex) const {
+            return mChangeTicks[chunkIndex * mColumns.size() + columnIndex];
+        }
+
+        static void raise(ChangeTick& stamp, ChangeTick tick) {
+            stamp = tick > stamp ? tick : stamp;
+        }
+
+    public:
+        /**
+         * @brief Constructor
+         * @param signature Exact component set of this archetype
+         * @param infos Type information indexed by component type ID
+         */
+        Archetype(const Signature& signature, const std::array<ComponentInfo, MAX_COMPONENTS>& infos)
+            : mSignature(signature) {
+            mColumnOfType.fill(NO_COLUMN);
+
+            size_t rowBytes = sizeof(Entity);
+            signature.forEachSet([&](size_t type) {
+                assert(infos[type].size > 0 && "Archetype built from an unregistered component.");
+                mColumnOfType[type] = static_cast<std::uint16_t>(mColumns.size());
+                mColumns.push_back({ static_cast<ComponentType>(type), infos[type], 0 });
+                rowBytes += infos[type].size;
+                mChunkAlignment = std::max(mChunkAlignment, infos[type].alignment);
+            });
+
+            // Start from the unpadded estimate and shrink until padding fits too
+            mChunkCapacity = std::max<size_t>(1, CHUNK_BYTES / rowBytes);
+            while (mChunkCapacity > 1 && layoutColumns(mChunkCapacity) > CHUNK_BYTES) {
+                --mChunkCapacity;
+            }
+            // A single row may still overflow the default size; its chunks grow to fit it
+            mChunkBytes = std::max(CHUNK_BYTES, layoutColumns(mChunkCapacity));
+        }
+
+        ~Archetype() {
+            while (mSize > 0) {
+                removeRow(mSize - 1);
+            }
+        }
+
+        Archetype(const Archetype&) = delete;
+        Archetype& operator=(const Archetype&) = delete;
+
+        /**
+         * @brief Reserves a row for an entity (component columns stay unconstructed)
+         * @param entity Entity that will own the row
+         * @return Index of the new row
+         */
+        size_t allocateRow(Entity entity) {
+            if (mSize == mChunks.size() * mChunkCapacity) {
+                addChunk();
+            }
+            size_t row = mSize++;
+            entityAt(row) = entity;
+            return row;
+        }
+
+        /**
+         * @brief Allocates chunks so that at least the given number of rows fit
+         * @param rowCount Number of rows to make room for
+         */
+        void reserve(size_t rowCount) {
+            while (mChunks.size() * mChunkCapacity < rowCount) {
+                addChunk();
+            }
+        }
+
+        /**
+         * @brief Destroys a row's components and fills the hole with the last row
+         * @param row Row to remove
+         * @return Entity that was moved into the row, or NULL_ENTITY if none moved
+         */
+        Entity removeRow(size_t row) {
+            for (size_t column = 0; column < mColumns.size(); ++column) {
+                mColumns[column].info.destroy(rowAddress(column, row));
+            }
+            return fillHole(row);
+        }
+
+        /**
+         * @brief Moves a row into another archetype
+         *
+         * Components present in both archetypes are moved; components missing
+         * from the destination are destroyed. The destination row is allocated
+         * here; columns only the destination has are left unconstructed.
+         *
+         * @param row Row to move out of this archetype
+         * @param destination Archetype receiving the entity
+         * @param movedEntity Set to the entity moved into the vacated row, or NULL_ENTITY
+         * @return Row index in the destination archetype
+         */
+        size_t moveRowTo(size_t row, Archetype& destination, Entity& movedEntity) {
+            size_t destinationRow = destination.allocateRow(entityAt(row));
+
+            const size_t sourceChunk = row / mChunkCapacity;
+            const size_t destinationChunk = destinationRow / destination.mChunkCapacity;
+            for (size_t column = 0; column < mColumns.size(); ++column) {
+                void* source = rowAddress(column, row);
+                const size_t destinationColumn = destination.mColumnOfType[mColumns[column].type];
+                if (destinationColumn != NO_COLUMN) {
+                    mColumns[column].info.moveConstruct(destination.rowAddress(destinationColumn, destinationRow), source);
+                    raise(destination.changeTickAt(destinationColumn, destinationChunk), changeTickAt(column, sourceChunk));
+                }
+                mColumns[column].info.destroy(source);
+            }
+
+            movedEntity = fillHole(row);
+            return destinationRow;
+        }
+
+        /**
+         * @brief Destroys every row (allocated chunks are kept)
+         */
+        void clear() {
+            while (mSize > 0) {
+                removeRow(mSize - 1);
+            }
+        }
+
+        /**
+         * @brief Checks whether the rows can be copied into a snapshot
+         * @return true if every column is trivially copyable, whether or not there are rows
+         */
+        bool canSnapshot() const {
+            return std::all_of(mColumns.begin(), mColumns.end(),
+                [](const Column& column) { return column.info.triviallyCopyable; });
+        }
+
+        /**
+         * @brief Writes the occupied chunks to a snapshot, one block per chunk
+         *
+         * An empty archetype that cannot be snapshotted saves its size only:
+         * its chunks may still hold bytes of destroyed non-trivial components.
+         */
+        void saveSnapshot(WorldSnapshot& snapshot) const {
+            assert((mSize == 0 || canSnapshot()) && "Only trivially copyable components can be snapshotted.");
+            snapshot.writeValue(mSignature);
+            snapshot.writeValue(mSize);
+            if (!canSnapshot()) {
+                return;
+            }
+            for (size_t chunk = 0; chunk < getChunkCount(); ++chunk) {
+                snapshot.write(mChunks[chunk].get(), mChunkBytes);
+            }
+        }
+
+        /**
+         * @brief Replaces the rows with those saved by saveSnapshot()
+         * @param reader Reader positioned at this archetype's data
+         * @param tick Change stamp given to every restored chunk
+         */
+        void restoreSnapshot(SnapshotReader& reader, ChangeTick tick) {
+            [[maybe_unused]] const Signature signature = reader.readValue<Signature>();
+            assert(signature == mSignature && "Snapshot restored into a different world.");
+            const size_t size = reader.readValue<size_t>();
+
+            // Trivially copyable rows are simply overwritten
+            if (!canSnapshot()) {
+                assert(size == 0 && "Only trivially copyable components can be snapshotted.");
+                clear();
+                return;
+            }
+
+            reserve(size);
+            mSize = size;
+            for (size_t chunk = 0; chunk < getChunkCount(); ++chunk) {
+                reader.read(mChunks[chunk].get(), mChunkBytes);
+            }
+            std::fill(mChangeTicks.begin(), mChangeTicks.end(), tick);
+        }
+
+        /**
+         * @brief Gets the address of a component in a row
+         * @param type Component type (must have a column here)
+         * @param row Row index
+         */
+        void* getComponent(ComponentType type, size_t row) const {
+            assert(mColumnOfType[type] != NO_COLUMN && "Component not part of archetype.");
+            return rowAddress(mColumnOfType[type], row);
+        }
+
+        /**
+         * @brief Stamps a component of a row as changed
+         *
+         * The whole chunk column takes the stamp. Stamping is bookkeeping
+         * and allowed on a const archetype; different threads may stamp
+         * different chunks at once.
+         *
+         * @param type Component type (must have a column here)
+         * @param row Row index
+         * @param tick Change stamp to record
+         */
+        void markChanged(ComponentType type, size_t row, ChangeTick tick) const {
+            assert(mColumnOfType[type] != NO_COLUMN && "Component not part of archetype.");
+            raise(changeTickAt(mColumnOfType[type], row / mChunkCapacity), tick);
+        }
+
+        /**
+         * @brief Stamps a whole chunk column as changed
+         * @param type Component type (must have a column here)
+         * @param chunkIndex Chunk to stamp
+         * @param tick Change stamp to record
+         */
+        void markChunkChanged(ComponentType type, size_t chunkIndex, ChangeTick tick) const {
+            assert(mColumnOfType[type] != NO_COLUMN && "Component not part of archetype.");
+            raise(changeTickAt(mColumnOfType[type], chunkIndex), tick);
+        }
+
+        /**
+         * @brief Gets the newest change stamp of a component column in a chunk
+         * @param type Component type (must have a column here)
+         * @param chunkIndex Chunk to query
+         */
+        ChangeTick getChangeTick(ComponentType type, size_t chunkIndex) const {
+            assert(mColumnOfType[type] != NO_COLUMN && "Component not part of archetype.");
+            return changeTickAt(mColumnOfType[type], chunkIndex);
+        }
+
+        /**
+         * @brief Gets the entity that owns a row
+         */
+        Entity getEntity(size_t row) const {
+            return entityAt(row);
+        }
+
+        /**
+         * @brief Gets the start of a component column inside a chunk
+         * @param type Component type (must have a column here)
+         * @param chunkIndex Chunk to access
+         */
+        void* getColumn(ComponentType type, size_t chunkIndex) const {
+            assert(mColumnOfType[type] != NO_COLUMN && "Component not part of archetype.");
+            return mChunks[chunkIndex].get() + mColumns[mColumnOfType[type]].offset;
+        }
+
+        /**
+         * @brief Gets the entity handles stored in a chunk
+         */
+        const Entity* getEntities(size_t chunkIndex) const {
+            return reinterpret_cast<const Entity*>(mChunks[chunkIndex].get());
+        }
+
+        /**
+         * @brief Gets the number of occupied rows in a chunk
+         */
+        size_t getChunkSize(size_t chunkIndex) const {
+            size_t chunkStart = chunkIndex * mChunkCapacity;
+            return std::min(mChunkCapacity, mSize - std::min(mSize, chunkStart));
+        }
+
+        /**
+         * @brief Gets the number of chunks holding at least one row
+         */
+        size_t getChunkCount() const {
+            return (mSize + mChunkCapacity - 1) / mChunkCapacity;
+        }
+
+        /**
+         * @brief Gets the number of rows a chunk can hold
+         */
+        size_t getChunkCapacity() const {
+            return mChunkCapacity;
+        }
+
+        /**
+         * @brief Gets the size of each chunk in bytes
+         */
+        size_t getChunkBytes() const {
+            return mChunkBytes;
+        }
+
+        /**
+         * @brief Checks whether this archetype stores a component type
+         */
+        bool hasColumn(ComponentType type) const {
+            return mColumnOfType[type] != NO_COLUMN;
+        }
+
+        const Signature& getSignature() const { return mSignature; }
+        size_t size() const { return mSize; }
+
+        Archetype* getAddEdge(ComponentType type) const {
+            const Edge* edge = findEdge(type);
+            return edge ? edge->add : nullptr;
+        }
+        Archetype* getRemoveEdge(ComponentType type) const {
+            const Edge* edge = findEdge(type);
+            return edge ? edge->remove : nullptr;
+        }
+        void setAddEdge(ComponentType type, Archetype* archetype) { edgeFor(type).add = archetype; }
+        void setRemoveEdge(ComponentType type, Archetype* archetype) { edgeFor(type).remove = archetype; }
+
+    private:
+        /**
+         * @brief Moves the last row into a vacated row and shrinks the archetype
+         * @return Entity that was moved, or NULL_ENTITY if the vacated row was last
+         */
+        Entity fillHole(size_t row) {
+            size_t last = mSize - 1;
+            Entity moved = NULL_ENTITY;
+
+            if (row != last) {
+                const size_t chunk = row / mChunkCapacity;
+                const size_t lastChunk = last / mChunkCapacity;
+                for (size_t column = 0; column < mColumns.size(); ++column) {
+                    void* lastAddress = rowAddress(column, last);
+                    mColumns[column].info.moveConstruct(rowAddress(column, row), lastAddress);
+                    mColumns[column].info.destroy(lastAddress);
+                    raise(changeTickAt(column, chunk), changeTickAt(column, lastChunk));
+                }
+                moved = entityAt(last);
+                entityAt(row) = moved;
+            }
+
+            --mSize;
+            return moved;
+        }
+    };
+
+} // namespace ecs
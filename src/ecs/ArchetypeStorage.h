@@ -0,0 +1,380 @@
+#pragma once
+
+#include "Archetype.h"
+#include "ECSTypes.h"
+#include "WorldSnapshot.h"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <memory>
+#include <span>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ecs {
+
+    /**
+     * @brief Component storage that groups entities by archetype
+     *
+     * Alternative to the per-type ComponentArray layout. Every distinct
+     * Signature gets an Archetype whose chunks hold the components of all
+     * its entities side by side, so a loop over several component types
+     * reads each chunk linearly instead of doing one random access per
+     * component type.
+     *
+     * Adding or removing a component moves the entity's row to another
+     * archetype. Transitions are cached on the archetypes, so after warm-up
+     * a structural change costs no lookup.
+     */
+    class ArchetypeStorage {
+    private:
+        /// Where an entity's row lives
+        struct EntityLocation {
+            Archetype* archetype = nullptr;
+            size_t row = 0;
+        };
+
+        /// Type information indexed by component type ID
+        std::array<ComponentInfo, MAX_COMPONENTS> mComponentInfos{};
+
+        /// All archetypes, in creation order
+        std::vector<std::unique_ptr<Archetype>> mArchetypes;
+
+        /// Archetype lookup by exact signature
+        std::unordered_map<Signature, Archetype*> mArchetypeBySignature;
+
+        /// Location per entity slot (archetype is null for entities without components)
+        std::vector<EntityLocation> mLocations;
+
+        EntityLocation& locationOf(Entity entity) {
+            size_t index = entityIndex(entity);
+            if (index >= mLocations.size()) {
+                mLocations.resize(index + 1);
+            }
+            return mLocations[index];
+        }
+
+        Archetype* getOrCreateArchetype(const Signature& signature) {
+            auto it = mArchetypeBySignature.find(signature);
+            if (it != mArchetypeBySignature.end()) {
+                return it->second;
+            }
+
+            mArchetypes.push_back(std::make_unique<Archetype>(signature, mComponentInfos));
+            Archetype* archetype = mArchetypes.back().get();
+            mArchetypeBySignature[signature] = archetype;
+            return archetype;
+        }
+
+        Archetype* getTransition(Archetype* from, ComponentType type, bool add) {
+            if (from) {
+                Archetype* cached = add ? from->getAddEdge(type) : from->getRemoveEdge(type);
+                if (cached) {
+                    return cached;
+                }
+            }
+
+            Signature signature = from ? from->getSignature() : Signature{};
+            signature.set(type, add);
+
+            Archetype* to = signature.none() ? nullptr : getOrCreateArchetype(signature);
+            if (from) {
+                add ? from->setAddEdge(type, to) : from->setRemoveEdge(type, to);
+            }
+            return to;
+        }
+
+        void updateMovedEntity(Entity moved, size_t row) {
+            if (moved != NULL_ENTITY) {
+                mLocations[entityIndex(moved)].row = row;
+            }
+        }
+
+    public:
+        /**
+         * @brief Records type information for a component type
+         * @tparam T Component type
+         * @param type Component type ID assigned by the ComponentManager
+         */
+        template<typename T>
+        void registerComponent(ComponentType type) {
+            if (mComponentInfos[type].size == 0) {
+                mComponentInfos[type] = ComponentInfo::create<T>();
+            }
+        }
+
+        /**
+         * @brief Adds a component, moving the entity to the matching archetype
+         * @param entity Entity to add component to
+         * @param type Component type ID
+         * @param component Component data
+         * @param tick Change stamp of the new component
+         */
+        template<typename T>
+        void addComponent(Entity entity, ComponentType type, const T& component, ChangeTick tick = 0) {
+            EntityLocation& location = locationOf(entity);
+            assert((!location.archetype || !location.archetype->hasColumn(type)) && "Component added to same entity more than once.");
+
+            Archetype* from = location.archetype;
+            Archetype* to = getTransition(from, type, true);
+
+            size_t row;
+            if (from) {
+                Entity moved;
+                row = from->moveRowTo(location.row, *to, moved);
+                updateMovedEntity(moved, location.row);
+            } else {
+                row = to->allocateRow(entity);
+            }
+
+            ::new (to->getComponent(type, row)) T(component);
+            to->markChanged(type, row, tick);
+            location = { to, row };
+        }
+
+        /**
+         * @brief Adds several components to many entities at once
+         *
+         * Each entity moves straight to its final archetype instead of once
+         * per component. Consecutive entities coming from the same archetype
+         * share one target lookup, and the target reserves room for the rest
+         * of the batch up front.
+         *
+         * @param entities Entities to add the components to (none may have any of them)
+         * @param types Component type IDs, in the order of Ts
+         * @param tick Change stamp of the new components
+         * @param components Component data copied to every entity
+         */
+        template<typename... Ts>
+        void addComponents(std::span<const Entity> entities, const std::array<ComponentType, sizeof...(Ts)>& types,
+            ChangeTick tick, const Ts&... components) {
+            Signature added;
+            for (ComponentType type : types) {
+                added.set(type);
+            }
+
+            Archetype* source = nullptr;
+            Archetype* to = nullptr;
+            for (size_t i = 0; i < entities.size(); ++i) {
+                EntityLocation& location = locationOf(entities[i]);
+                Archetype* from = location.archetype;
+                assert((!from || !from->getSignature().intersects(added)) && "Component added to same entity more than once.");
+
+                if (!to || from != source) {
+                    source = from;
+                    to = getOrCreateArchetype((from ? from->getSignature() : Signature{}) | added);
+                    to->reserve(to->size() + entities.size() - i);
+                }
+
+                size_t row;
+                if (from) {
+                    Entity moved;
+                    row = from->moveRowTo(location.row, *to, moved);
+                    updateMovedEntity(moved, location.row);
+                } else {
+                    row = to->allocateRow(entities[i]);
+                }
+
+                [&]<size_t... I>(std::index_sequence<I...>) {
+                    (::new (to->getComponent(types[I], row)) Ts(components), ...);
+                }(std::index_sequence_for<Ts...>{});
+                for (ComponentType type : types) {
+                    to->markChanged(type, row, tick);
+                }
+                location = { to, row };
+            }
+        }
+
+        /**
+         * @brief Places an entity without components in the archetype of a signature
+         *
+         * The row's components are left unconstructed, for loaders that copy
+         * trivially copyable components into place with getComponent().
+         *
+         * @param entity Entity that has no components in this storage yet
+         * @param signature Data components of the entity (no tags, not empty)
+         * @param tick Change stamp of the new components
+         */
+        void allocateEntity(Entity entity, const Signature& signature, ChangeTick tick) {
+            EntityLocation& location = locationOf(entity);
+            assert(!location.archetype && "Entity already has components.");
+
+            Archetype* archetype = getOrCreateArchetype(signature);
+            const size_t row = archetype->allocateRow(entity);
+            signature.forEachSet([archetype, row, tick](size_t type) {
+                archetype->markChanged(static_cast<ComponentType>(type), row, tick);
+            });
+            location = { archetype, row };
+        }
+
+        /**
+         * @brief Removes a component, moving the entity to the matching archetype
+         * @param entity Entity to remove component from
+         * @param type Component type ID
+         */
+        void removeComponent(Entity entity, ComponentType type) {
+            EntityLocation& location = locationOf(entity);
+            assert(location.archetype && location.archetype->hasColumn(type) && "Removing non-existent component.");
+
+            Archetype* from = location.archetype;
+            Archetype* to = getTransition(from, type, false);
+
+            Entity moved;
+            if (to) {
+                size_t row = from->moveRowTo(location.row, *to, moved);
+                updateMovedEntity(moved, location.row);
+                location = { to, row };
+            } else {
+                moved = from->removeRow(location.row);
+                updateMovedEntity(moved, location.row);
+                location = {};
+            }
+        }
+
+        /**
+         * @brief Gets a component of an entity
+         * @param entity Entity to get component from
+         * @param type Component type ID (entity must have it)
+         * @return Pointer to the component
+         */
+        void* getComponent(Entity entity, ComponentType type) const {
+            const EntityLocation& location = mLocations[entityIndex(entity)];
+            assert(location.archetype && "Retrieving non-existent component.");
+            return location.archetype->getComponent(type, location.row);
+        }
+
+        /**
+         * @brief Gets a component of an entity for writing and stamps its chunk
+         * @param entity Entity to get component from
+         * @param type Component type ID (entity must have it)
+         * @param tick Change stamp to record
+         * @return Pointer to the component
+         */
+        void* getComponentForWrite(Entity entity, ComponentType type, ChangeTick tick) {
+            const EntityLocation& location = mLocations[entityIndex(entity)];
+            assert(location.archetype && "Retrieving non-existent component.");
+            location.archetype->markChanged(type, location.row, tick);
+            return location.archetype->getComponent(type, location.row);
+        }
+
+        /**
+         * @brief Removes all components of a destroyed entity
+         * @param entity The destroyed entity
+         */
+        void entityDestroyed(Entity entity) {
+            size_t index = entityIndex(entity);
+            if (index >= mLocations.size() || !mLocations[index].archetype) {
+                return;
+            }
+
+            EntityLocation& location = mLocations[index];
+            Entity moved = location.archetype->removeRow(location.row);
+            updateMovedEntity(moved, location.row);
+            location = {};
+        }
+
+        /**
+         * @brief Counts entities that have a component type
+         * @param type Component type ID
+         */
+        size_t getComponentCount(ComponentType type) const {
+            size_t count = 0;
+            for (const auto& archetype : mArchetypes) {
+                if (archetype->hasColumn(type)) {
+                    count += archetype->size();
+                }
+            }
+            return count;
+        }
+
+        /**
+         * @brief Calls a function for every non-empty archetype that includes a signature
+         * @param required Components the archetype must contain
+         * @param func Callable taking (Archetype&)
+         */
+        template<typename Func>
+        void forEachArchetype(const Signature& required, Func&& func) const {
+            for (const auto& archetype : mArchetypes) {
+                if (archetype->getSignature().containsAll(required) && archetype->size() > 0) {
+                    func(*archetype);
+                }
+            }
+        }
+
+        /**
+         * @brief Calls a function for every chunk whose archetype includes a signature
+         *
+         * The callback receives the archetype and the chunk index. Structural
+         * changes (adding/removing components, destroying entities) are not
+         * allowed while iterating.
+         *
+         * @param required Components the archetype must contain
+         * @param func Callable taking (const Archetype&, size_t chunkIndex)
+         */
+        template<typename Func>
+        void forEachChunk(const Signature& required, Func&& func) const {
+            forEachArchetype(required, [&func](const Archetype& archetype) {
+                for (size_t chunk = 0; chunk < archetype.getChunkCount(); ++chunk) {
+                    func(archetype, chunk);
+                }
+            });
+        }
+
+        /**
+         * @brief Checks whether every archetype can be copied into a snapshot
+         *
+         * Archetypes with non-trivially copyable columns are accepted while
+         * they have no rows.
+         */
+        bool canSnapshot() const {
+            return std::all_of(mArchetypes.begin(), mArchetypes.end(),
+                [](const auto& archetype) { return archetype->size() == 0 || archetype->canSnapshot(); });
+        }
+
+        /**
+         * @brief Writes all archetypes and entity locations to a snapshot
+         */
+        void saveSnapshot(WorldSnapshot& snapshot) const {
+            snapshot.writeValue(mArchetypes.size());
+            for (const auto& archetype : mArchetypes) {
+                archetype->saveSnapshot(snapshot);
+            }
+            snapshot.writeValue(mLocations.size());
+            snapshot.write(mLocations.data(), mLocations.size() * sizeof(EntityLocation));
+        }
+
+        /**
+         * @brief Replaces all rows and locations with those saved by saveSnapshot()
+         *
+         * Archetypes are never destroyed, so those that existed when the
+         * snapshot was taken are found at the same position and the saved
+         * locations still point at them. Archetypes created later are emptied.
+         *
+         * @param reader Reader positioned at the archetype data
+         * @param tick Change stamp given to every restored chunk
+         */
+        void restoreSnapshot(SnapshotReader& reader, ChangeTick tick) {
+            const size_t archetypeCount = reader.readValue<size_t>();
+            assert(archetypeCount <= mArchetypes.size() && "Snapshot restored into a different world.");
+            for (size_t i = 0; i < mArchetypes.size(); ++i) {
+                if (i < archetypeCount) {
+                    mArchetypes[i]->restoreSnapshot(reader, tick);
+                } else {
+                    mArchetypes[i]->clear();
+                }
+            }
+
+            mLocations.resize(reader.readValue<size_t>());
+            reader.read(mLocations.data(), mLocations.size() * sizeof(EntityLocation));
+        }
+
+        /**
+         * @brief Gets the number of archetypes created so far
+         */
+        size_t getArchetypeCount() const {
+            return mArchetypes.size();
+        }
+    };
+
+} // namespace ecs
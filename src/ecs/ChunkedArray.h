@@ -0,0 +1,257 @@
+#pragma once
+
+#include "ECSTypes.h"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ecs {
+
+    /**
+     * @brief Growable array that allocates its storage in fixed-size chunks
+     *
+     * Capacity grows one chunk at a time as elements are appended, so memory
+     * follows actual use instead of a compile-time maximum. Chunks are never
+     * moved once allocated: references to elements stay valid while other
+     * elements are appended, which a std::vector cannot guarantee.
+     *
+     * Only the first size() slots hold constructed objects.
+     *
+     * adoptChunks() lets the array use chunks it does not own, such as pages
+     * of a memory-mapped world file; those are never freed by the array.
+     *
+     * @tparam T Element type
+     */
+    template<typename T>
+    class ChunkedArray {
+    public:
+        /// Target size of one chunk in bytes
+        static constexpr size_t CHUNK_BYTES = 16 * 1024;
+
+        /// Elements per chunk (a power of two, so indexing is a shift and a mask)
+        static constexpr size_t CHUNK_SIZE = std::bit_floor(sizeof(T) >= CHUNK_BYTES ? size_t{ 1 } : CHUNK_BYTES / sizeof(T));
+
+        /// Chunks start on a cache line, so element ranges can be split along cache lines
+        static constexpr size_t CHUNK_ALIGNMENT = std::max(alignof(T), CACHE_LINE_SIZE);
+
+    private:
+        static constexpr size_t CHUNK_SHIFT = std::countr_zero(CHUNK_SIZE);
+        static constexpr size_t CHUNK_MASK = CHUNK_SIZE - 1;
+
+        struct ChunkDeleter {
+            /// False for chunks handed in by adoptChunks()
+            bool owned = true;
+
+            void operator()(T* chunk) const {
+                if (owned) {
+                    ::operator delete(chunk, std::align_val_t{ CHUNK_ALIGNMENT });
+                }
+            }
+        };
+
+        using ChunkPtr = std::unique_ptr<T, ChunkDeleter>;
+
+        /// Allocated chunks (raw storage, constructed up to mSize)
+        std::vector<ChunkPtr> mChunks;
+
+        /// Number of constructed elements
+        size_t mSize = 0;
+
+        static ChunkPtr allocateChunk() {
+            return ChunkPtr(static_cast<T*>(::operator new(CHUNK_SIZE * sizeof(T), std::align_val_t{ CHUNK_ALIGNMENT })));
+        }
+
+        T* slot(size_t index) const {
+            return mChunks[index >> CHUNK_SHIFT].get() + (index & CHUNK_MASK);
+        }
+
+    public:
+        ChunkedArray() = default;
+
+        ~ChunkedArray() {
+            clear();
+        }
+
+        ChunkedArray(const ChunkedArray&) = delete;
+        ChunkedArray& operator=(const ChunkedArray&) = delete;
+
+        ChunkedArray(ChunkedArray&& other) noexcept
+            : mChunks(std::move(other.mChunks)), mSize(std::exchange(other.mSize, 0)) {}
+
+        ChunkedArray& operator=(ChunkedArray&& other) noexcept {
+            if (this != &other) {
+                clear();
+                mChunks = std::move(other.mChunks);
+                mSize = std::exchange(other.mSize, 0);
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Constructs a new element at the end of the array
+         * @param args Constructor arguments
+         * @return Reference to the new element
+         */
+        template<typename... Args>
+        T& emplaceBack(Args&&... args) {
+            if (mSize == capacity()) {
+                mChunks.push_back(allocateChunk());
+            }
+            T* element = ::new (static_cast<void*>(slot(mSize))) T(std::forward<Args>(args)...);
+            ++mSize;
+            return *element;
+        }
+
+        /**
+         * @brief Appends a copy of an element
+         */
+        T& pushBack(const T& value) {
+            return emplaceBack(value);
+        }
+
+        /**
+         * @brief Destroys the last element
+         */
+        void popBack() {
+            assert(mSize > 0 && "popBack on empty ChunkedArray.");
+            --mSize;
+            slot(mSize)->~T();
+        }
+
+        /**
+         * @brief Destroys all elements (chunks are kept for reuse)
+         */
+        void clear() {
+            while (mSize > 0) {
+                popBack();
+            }
+        }
+
+        /**
+         * @brief Allocates chunks so that at least the given number of elements fit
+         * @param newCapacity Requested capacity in elements
+         */
+        void reserve(size_t newCapacity) {
+            while (capacity() < newCapacity) {
+                mChunks.push_back(allocateChunk());
+            }
+        }
+
+        /**
+         * @brief Sets the element count without constructing or destroying elements
+         *
+         * Only for trivially copyable types whose contents are written right
+         * after, such as arrays restored from a WorldSnapshot.
+         *
+         * @param newSize New number of elements
+         */
+        void resizeForOverwrite(size_t newSize) {
+            static_assert(std::is_trivially_copyable_v<T>, "Elements are left for the caller to overwrite.");
+            reserve(newSize);
+            mSize = newSize;
+        }
+
+        /**
+         * @brief Replaces the storage with chunks owned by someone else
+         *
+         * The array drops its own chunks and uses the given memory as its
+         * first chunks, holding newSize elements that are already in place.
+         * Growing past them allocates owned chunks as usual. The memory must
+         * stay valid and writable for the lifetime of the array.
+         *
+         * @param firstChunk Start of the first chunk (aligned to CHUNK_ALIGNMENT)
+         * @param chunkStride Bytes from one chunk to the next (at least CHUNK_SIZE elements)
+         * @param newSize Number of elements, filling the chunks in order
+         */
+        void adoptChunks(std::byte* firstChunk, size_t chunkStride, size_t newSize) {
+            static_assert(std::is_trivially_copyable_v<T>, "Adopted elements are not constructed by the array.");
+            assert(reinterpret_cast<std::uintptr_t>(firstChunk) % CHUNK_ALIGNMENT == 0 && "Adopted chunk is misaligned.");
+            assert(chunkStride >= CHUNK_SIZE * sizeof(T) && chunkStride % CHUNK_ALIGNMENT == 0 && "Adopted chunk stride too small.");
+
+            clear();
+            mChunks.clear();
+            const size_t chunkCount = (newSize + CHUNK_MASK) >> CHUNK_SHIFT;
+            mChunks.reserve(chunkCount);
+            for (size_t chunk = 0; chunk < chunkCount; ++chunk) {
+                mChunks.emplace_back(reinterpret_cast<T*>(firstChunk + chunk * chunkStride), ChunkDeleter{ false });
+            }
+            mSize = newSize;
+        }
+
+        /**
+         * @brief Releases chunks that hold no elements
+         */
+        void shrinkToFit() {
+            size_t usedChunks = (mSize + CHUNK_MASK) >> CHUNK_SHIFT;
+            mChunks.resize(usedChunks);
+            mChunks.shrink_to_fit();
+        }
+
+        T& operator[](size_t index) {
+            assert(index < mSize && "ChunkedArray index out of range.");
+            return *slot(index);
+        }
+
+        const T& operator[](size_t index) const {
+            assert(index < mSize && "ChunkedArray index out of range.");
+            return *slot(index);
+        }
+
+        T& back() {
+            return (*this)[mSize - 1];
+        }
+
+        /**
+         * @brief Gets the number of constructed elements
+         */
+        size_t size() const {
+            return mSize;
+        }
+
+        bool empty() const {
+            return mSize == 0;
+        }
+
+        /**
+         * @brief Gets the number of elements that fit without allocating
+         */
+        size_t capacity() const {
+            return mChunks.size() * CHUNK_SIZE;
+        }
+
+        /**
+         * @brief Gets the number of allocated chunks
+         */
+        size_t getChunkCount() const {
+            return mChunks.size();
+        }
+
+        /**
+         * @brief Gets the first element of a chunk
+         * @param chunkIndex Chunk to access
+         * @return Pointer to contiguous storage of up to CHUNK_SIZE elements
+         */
+        T* getChunk(size_t chunkIndex) {
+            return mChunks[chunkIndex].get();
+        }
+
+        const T* getChunk(size_t chunkIndex) const {
+            return mChunks[chunkIndex].get();
+        }
+
+        /**
+         * @brief Gets the bytes currently reserved by the array
+         */
+        size_t getMemoryUsage() const {
+            return capacity() * sizeof(T) + mChunks.capacity() * sizeof(ChunkPtr);
+        }
+    };
+
+} // namespace ecs
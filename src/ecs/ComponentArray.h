@@ -2,55 +2,71 @@
 
 #include "IComponentArray.h"
 #include "ECSTypes.h"
-#include <array>
-#include <unordered_map>
+#include "SparseSet.h"
+#include "ChunkedArray.h"
+#include "WorldSnapshot.h"
+#include <algorithm>
 #include <cassert>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+#include <utility>
 
 namespace ecs {
 
     /**
      * @brief Dense array storage for components of type T
      *
-     * Maintains components in a contiguous array for cache efficiency.
-     * Uses entity-to-index and index-to-entity mappings for O(1) access.
+     * Maintains components in a packed array for cache efficiency.
+     * A paged sparse set maps entities to array indices, giving O(1)
+     * insertion, removal and lookup without hashing. Storage grows in
+     * fixed-size chunks as components are added, so an unused component
+     * type costs no component memory, and references returned by getData()
+     * stay valid while other components are inserted.
+     *
+     * Every component carries the ChangeTick at which it was last added or
+     * written, and the array keeps the newest of those stamps as its
+     * version, so a reader can skip the whole array when nothing changed.
+     * getData() does not stamp; writers go through getDataForWrite() or
+     * markChanged().
      *
      * @tparam T Component type to store
      */
     template<typename T>
     class ComponentArray : public IComponentArray {
     private:
-        /// Dense array of components
-        std::array<T, MAX_ENTITIES> mComponentArray;
+        /// Dense array of components, parallel to the sparse set's dense entity list
+        ChunkedArray<T> mComponentArray;
 
-        /// Map from entity ID to array index
-        std::unordered_map<Entity, size_t> mEntityToIndexMap;
+        /// Entity to array index mapping
+        SparseSet mEntitySet;
 
-        /// Map from array index to entity ID (for efficient removal)
-        std::unordered_map<size_t, Entity> mIndexToEntityMap;
+        /// Change stamp per component, parallel to mComponentArray
+        ChunkedArray<ChangeTick> mChangeTicks;
 
-        /// Current number of valid components in the array
-        size_t mSize;
+        /// Newest change stamp in the array
+        ChangeTick mVersion = 0;
 
     public:
         /**
          * @brief Constructor
          */
-        ComponentArray() : mSize(0) {}
+        ComponentArray() = default;
 
         /**
          * @brief Adds a component for an entity
          * @param entity Entity to add component to
          * @param component Component data to add
+         * @param tick Change stamp of the new component
          */
-        void insertData(Entity entity, const T& component) {
-            assert(mEntityToIndexMap.find(entity) == mEntityToIndexMap.end() && "Component added to same entity more than once.");
+        void insertData(Entity entity, const T& component, ChangeTick tick = 0) {
+            assert(!mEntitySet.contains(entity) && "Component added to same entity more than once.");
 
-            // Put new entry at end and update the maps
-            size_t newIndex = mSize;
-            mEntityToIndexMap[entity] = newIndex;
-            mIndexToEntityMap[newIndex] = entity;
-            mComponentArray[newIndex] = component;
-            ++mSize;
+            // Put new entry at end of the dense array
+            mEntitySet.insert(entity);
+            mComponentArray.pushBack(component);
+            mChangeTicks.pushBack(tick);
+            mVersion = tick > mVersion ? tick : mVersion;
         }
 
         /**
@@ -58,22 +74,17 @@ namespace ecs {
          * @param entity Entity to remove component from
          */
         void removeData(Entity entity) {
-            assert(mEntityToIndexMap.find(entity) != mEntityToIndexMap.end() && "Removing non-existent component.");
+            assert(mEntitySet.contains(entity) && "Removing non-existent component.");
 
             // Copy element at end into deleted element's place to maintain density
-            size_t indexOfRemovedEntity = mEntityToIndexMap[entity];
-            size_t indexOfLastElement = mSize - 1;
-            mComponentArray[indexOfRemovedEntity] = mComponentArray[indexOfLastElement];
-
-            // Update map to point to moved spot
-            Entity entityOfLastElement = mIndexToEntityMap[indexOfLastElement];
-            mEntityToIndexMap[entityOfLastElement] = indexOfRemovedEntity;
-            mIndexToEntityMap[indexOfRemovedEntity] = entityOfLastElement;
-
-            mEntityToIndexMap.erase(entity);
-            mIndexToEntityMap.erase(indexOfLastElement);
-
-            --mSize;
+            size_t indexOfLastElement = mEntitySet.size() - 1;
+            size_t indexOfRemovedEntity = mEntitySet.erase(entity);
+            if (indexOfRemovedEntity != indexOfLastElement) {
+                mComponentArray[indexOfRemovedEntity] = std::move(mComponentArray[indexOfLastElement]);
+                mChangeTicks[indexOfRemovedEntity] = mChangeTicks[indexOfLastElement];
+            }
+            mComponentArray.popBack();
+            mChangeTicks.popBack();
         }
 
         /**
@@ -82,8 +93,8 @@ namespace ecs {
          * @return Reference to the component
          */
         T& getData(Entity entity) {
-            assert(mEntityToIndexMap.find(entity) != mEntityToIndexMap.end() && "Retrieving non-existent component.");
-            return mComponentArray[mEntityToIndexMap[entity]];
+            assert(mEntitySet.contains(entity) && "Retrieving non-existent component.");
+            return mComponentArray[mEntitySet.index(entity)];
         }
 
         /**
@@ -92,8 +103,83 @@ namespace ecs {
          * @return Const reference to the component
          */
         const T& getData(Entity entity) const {
-            assert(mEntityToIndexMap.find(entity) != mEntityToIndexMap.end() && "Retrieving non-existent component.");
-            return mComponentArray[mEntityToIndexMap.at(entity)];
+            assert(mEntitySet.contains(entity) && "Retrieving non-existent component.");
+            return mComponentArray[mEntitySet.index(entity)];
+        }
+
+        /**
+         * @brief Gets component data for an entity and stamps it as changed
+         * @param entity Entity to get component from
+         * @param tick Change stamp to record
+         * @return Reference to the component
+         */
+        T& getDataForWrite(Entity entity, ChangeTick tick) {
+            assert(mEntitySet.contains(entity) && "Retrieving non-existent component.");
+            const size_t index = mEntitySet.index(entity);
+            mChangeTicks[index] = tick;
+            raiseVersion(tick);
+            return mComponentArray[index];
+        }
+
+        /**
+         * @brief Stamps a component as changed by dense position
+         *
+         * Only the element is stamped, so different threads may stamp
+         * different elements at once; the caller raises the array version
+         * with raiseVersion().
+         *
+         * @param denseIndex Position in the packed array
+         * @param tick Change stamp to record
+         */
+        void markChangedAtIndex(size_t denseIndex, ChangeTick tick) {
+            mChangeTicks[denseIndex] = tick;
+        }
+
+        /**
+         * @brief Gets the change stamp of a component by dense position
+         */
+        ChangeTick getChangeTickAtIndex(size_t denseIndex) const {
+            return mChangeTicks[denseIndex];
+        }
+
+        /**
+         * @brief Gets the newest change stamp of any component in the array
+         */
+        ChangeTick getVersion() const {
+            return mVersion;
+        }
+
+        /**
+         * @brief Raises the array version without stamping a component
+         *
+         * Used before handing out many components for writing at once, so
+         * that concurrent writers only need to stamp their own elements.
+         *
+         * @param tick Change stamp to record
+         */
+        void raiseVersion(ChangeTick tick) {
+            mVersion = tick > mVersion ? tick : mVersion;
+        }
+
+        /**
+         * @brief Gets component data for an entity if present
+         * @param entity Entity to look up
+         * @return Pointer to the component, or nullptr if the entity has none
+         */
+        T* tryGetData(Entity entity) {
+            if (!mEntitySet.contains(entity)) {
+                return nullptr;
+            }
+            return &mComponentArray[mEntitySet.index(entity)];
+        }
+
+        /**
+         * @brief Gets component data by dense position
+         * @param denseIndex Position in the packed array (must be < getSize())
+         * @return Reference to the component owned by getEntitySet()[denseIndex]
+         */
+        T& getDataAtIndex(size_t denseIndex) {
+            return mComponentArray[denseIndex];
         }
 
         /**
@@ -102,7 +188,7 @@ namespace ecs {
          * @return true if entity has component, false otherwise
          */
         bool hasData(Entity entity) const {
-            return mEntityToIndexMap.find(entity) != mEntityToIndexMap.end();
+            return mEntitySet.contains(entity);
         }
 
         /**
@@ -110,7 +196,103 @@ namespace ecs {
          * @return Component count
          */
         size_t getSize() const {
-            return mSize;
+            return mEntitySet.size();
+        }
+
+        /**
+         * @brief Gets the number of components that fit without allocating
+         * @return Allocated capacity in components
+         */
+        size_t getCapacity() const {
+            return mComponentArray.capacity();
+        }
+
+        /**
+         * @brief Reserves storage for a number of components
+         * @param capacity Number of components to reserve room for
+         */
+        void reserve(size_t capacity) {
+            mEntitySet.reserve(capacity);
+            mComponentArray.reserve(capacity);
+            mChangeTicks.reserve(capacity);
+        }
+
+        /**
+         * @brief Gets the sparse set of entities owning a component
+         * @return Entity set whose dense order matches the component array
+         */
+        const SparseSet& getEntitySet() const {
+            return mEntitySet;
+        }
+
+        /**
+         * @brief Removes every component (allocated chunks are kept)
+         */
+        void clear() override {
+            mEntitySet.clear();
+            mComponentArray.clear();
+            mChangeTicks.clear();
+        }
+
+        bool canSnapshot() const override {
+            return std::is_trivially_copyable_v<T> || mEntitySet.empty();
+        }
+
+        void saveSnapshot(WorldSnapshot& snapshot) const override {
+            assert(canSnapshot() && "Only trivially copyable components can be snapshotted.");
+            const size_t size = mEntitySet.size();
+            snapshot.writeValue(size);
+            snapshot.write(mEntitySet.entities().data(), size * sizeof(Entity));
+            if constexpr (std::is_trivially_copyable_v<T>) {
+                snapshot.writeChunked(mComponentArray);
+            }
+        }
+
+        void restoreSnapshot(SnapshotReader& reader, ChangeTick tick) override {
+            const size_t size = reader.readValue<size_t>();
+            mEntitySet.assign(size, [&reader, size](Entity* entities) {
+                reader.read(entities, size * sizeof(Entity));
+            });
+            if constexpr (std::is_trivially_copyable_v<T>) {
+                reader.readChunked(mComponentArray);
+            } else {
+                assert(size == 0 && "Only trivially copyable components can be snapshotted.");
+                mComponentArray.clear();
+            }
+
+            // Restored values count as written now
+            mChangeTicks.resizeForOverwrite(size);
+            for (size_t i = 0; i < size; ++i) {
+                mChangeTicks[i] = tick;
+            }
+            raiseVersion(tick);
+        }
+
+        std::span<const Entity> getEntities() const override {
+            return mEntitySet.entities();
+        }
+
+        const void* getChunkData(size_t chunkIndex) const override {
+            return mComponentArray.getChunk(chunkIndex);
+        }
+
+        void adoptChunks(std::span<const Entity> entities, std::byte* firstChunk, size_t chunkStride, ChangeTick tick) override {
+            const size_t size = entities.size();
+            mEntitySet.assign(size, [entities](Entity* destination) {
+                std::copy(entities.begin(), entities.end(), destination);
+            });
+            if constexpr (std::is_trivially_copyable_v<T>) {
+                mComponentArray.adoptChunks(firstChunk, chunkStride, size);
+            } else {
+                assert(size == 0 && "Only trivially copyable components can be adopted.");
+                mComponentArray.clear();
+            }
+
+            mChangeTicks.resizeForOverwrite(size);
+            for (size_t i = 0; i < size; ++i) {
+                mChangeTicks[i] = tick;
+            }
+            raiseVersion(tick);
         }
 
         /**
@@ -118,7 +300,7 @@ namespace ecs {
          * @param entity The entity that was destroyed
          */
         void entityDestroyed(Entity entity) override {
-            if (mEntityToIndexMap.find(entity) != mEntityToIndexMap.end()) {
+            if (mEntitySet.contains(entity)) {
                 removeData(entity);
             }
         }
@@ -3,10 +3,12 @@
 #include "IComponentArray.h"
 #include "ComponentArray.h"
 #include "ECSTypes.h"
+#include "WorldSnapshot.h"
+#include <algorithm>
 #include <array>
 #include <iostream>
 #include <memory>
-#include <unordered_map>
+#include <span>
 #include <typeindex>
 #include <cassert>
 
@@ -23,19 +25,20 @@ namespace ecs {
      * Responsibilities:
      * - Register new component types and assign unique IDs
      * - Create and manage ComponentArray instances for each type
+     *   (tag components get no array, see isTagComponent)
      * - Provide type-safe access to component data
      * - Handle entity destruction cleanup across all component types
      */
     class ComponentManager {
     private:
-        /// Map from component type to unique component ID
-        std::unordered_map<std::type_index, ComponentType> mComponentTypes;
-
         /// Array of component array pointers indexed by component type ID
         std::array<std::shared_ptr<IComponentArray>, MAX_COMPONENTS> mComponentArrays;
 
-        /// Next available component type ID
-        ComponentType mNextComponentType;
+        /// Registered tag component types, which have no array
+        Signature mTagComponents;
+
+        /// Number of component types registered with this manager
+        size_t mRegisteredComponentCount = 0;
 
         /**
          * @brief Gets the component array for type T
@@ -43,54 +46,65 @@ namespace ecs {
          * @return Pointer to ComponentArray<T>
          */
         template<typename T>
-        std::shared_ptr<ComponentArray<T>> getComponentArray() {
-            std::type_index typeIndex = std::type_index(typeid(T));
+        ComponentArray<T>* getComponentArray() const {
+            static_assert(!isTagComponent<T>, "Tag components have no array; test the entity signature instead.");
+            const ComponentType type = typeId<T>();
 
-            //std::cout << "[ComponentManager] Accessing component array for type: " << typeIndex.name() << std::endl;
+            assert(mComponentArrays[type] && "Component not registered before use.");
 
-            assert(mComponentTypes.find(typeIndex) != mComponentTypes.end() && "Component not registered before use.");
-
-            return std::static_pointer_cast<ComponentArray<T>>(mComponentArrays[mComponentTypes[typeIndex]]);
+            return static_cast<ComponentArray<T>*>(mComponentArrays[type].get());
         }
 
     public:
         /**
          * @brief Constructor
          */
-        ComponentManager() : mNextComponentType(0) {}
+        ComponentManager() = default;
 
         /**
          * @brief Helper function to get global component type (implemented in .cpp)
          */
         static ComponentType getGlobalComponentType(std::type_index typeIndex);
 
+        /**
+         * @brief Gets the global type ID of a component type
+         *
+         * The ID is fetched from the global ComponentTypeRegistry the first
+         * time a type is used and cached in a per-type static afterwards, so
+         * every later call is a single load with no hashing or locking. IDs
+         * are therefore identical across all coordinators.
+         *
+         * @tparam T Component type
+         * @return Component type ID
+         */
+        template<typename T>
+        static ComponentType typeId() {
+            static const ComponentType id = getGlobalComponentType(std::type_index(typeid(T)));
+            return id;
+        }
+
         /**
          * @brief Registers a new component type
          * @tparam T Component type to register
          */
         template<typename T>
         void registerComponent() {
-            std::type_index typeIndex = std::type_index(typeid(T));
+            const ComponentType type = typeId<T>();
+            assert(type < MAX_COMPONENTS && "Too many component types registered.");
 
             // If component is already registered, return early (no error)
-            if (mComponentTypes.find(typeIndex) != mComponentTypes.end()) {
+            if (mComponentArrays[type] || mTagComponents.test(type)) {
                 return;
             }
 
-            // Get the global component type ID from registry
-            // This ensures consistency across all coordinators
-            ecs::ComponentType globalTypeId = getGlobalComponentType(typeIndex);
-
-            // Add this component type to the component type map using global ID
-            mComponentTypes[typeIndex] = globalTypeId;
-
-            // Create a ComponentArray pointer and add it to the component arrays array
-            mComponentArrays[globalTypeId] = std::make_shared<ComponentArray<T>>();
-
-            // Update next component type to ensure we don't conflict
-            if (globalTypeId >= mNextComponentType) {
-                mNextComponentType = globalTypeId + 1;
+            if constexpr (isTagComponent<T>) {
+                // Tags only exist as signature bits
+                mTagComponents.set(type);
+            } else {
+                // Create a ComponentArray pointer and add it to the component arrays array
+                mComponentArrays[type] = std::make_shared<ComponentArray<T>>();
             }
+            ++mRegisteredComponentCount;
         }
 
         /**
@@ -99,14 +113,29 @@ namespace ecs {
          * @return Component type ID
          */
         template<typename T>
-        ComponentType getComponentType() {
-            std::type_index typeIndex = std::type_index(typeid(T));
+        ComponentType getComponentType() const {
+            const ComponentType type = typeId<T>();
 
-            //std::cout << "[ComponentManager] Getting component type ID for: " << typeIndex.name() << std::endl;
+            assert((mComponentArrays[type] || mTagComponents.test(type)) && "Component not registered before use.");
 
-            assert(mComponentTypes.find(typeIndex) != mComponentTypes.end() && "Component not registered before use.");
+            return type;
+        }
+
+        /**
+         * @brief Checks whether a component type ID is registered, as data or tag
+         * @param type Component type ID
+         */
+        bool isRegistered(ComponentType type) const {
+            return type < MAX_COMPONENTS && (mComponentArrays[type] || mTagComponents.test(type));
+        }
 
-            return mComponentTypes[typeIndex];
+        /**
+         * @brief Gets the type-erased storage of a component type
+         * @param type Component type ID
+         * @return The array, or nullptr for tags and unregistered types
+         */
+        IComponentArray* getArray(ComponentType type) const {
+            return mComponentArrays[type].get();
         }
 
         /**
@@ -114,10 +143,27 @@ namespace ecs {
          * @tparam T Component type
          * @param entity Entity to add component to
          * @param component Component data
+         * @param tick Change stamp of the new component
          */
         template<typename T>
-        void addComponent(Entity entity, const T& component) {
-            getComponentArray<T>()->insertData(entity, component);
+        void addComponent(Entity entity, const T& component, ChangeTick tick = 0) {
+            getComponentArray<T>()->insertData(entity, component, tick);
+        }
+
+        /**
+         * @brief Adds the same component to many entities
+         * @tparam T Component type
+         * @param entities Entities to add the component to (none may have it yet)
+         * @param component Component data copied to every entity
+         * @param tick Change stamp of the new components
+         */
+        template<typename T>
+        void addComponents(std::span<const Entity> entities, const T& component, ChangeTick tick = 0) {
+            ComponentArray<T>* array = getComponentArray<T>();
+            array->reserve(batchCapacity(array->getSize(), entities.size()));
+            for (Entity entity : entities) {
+                array->insertData(entity, component, tick);
+            }
         }
 
         /**
@@ -149,7 +195,17 @@ namespace ecs {
          */
         template<typename T>
         const T& getComponent(Entity entity) const {
-            return const_cast<ComponentManager*>(this)->getComponentArray<T>()->getData(entity);
+            return getComponentArray<T>()->getData(entity);
+        }
+
+        /**
+         * @brief Gets the storage of a component type
+         * @tparam T Component type (must be registered)
+         * @return Reference to the component array
+         */
+        template<typename T>
+        ComponentArray<T>& getComponentStorage() {
+            return *getComponentArray<T>();
         }
 
         /**
@@ -160,7 +216,7 @@ namespace ecs {
          */
         template<typename T>
         bool hasComponent(Entity entity) const {
-            return const_cast<ComponentManager*>(this)->getComponentArray<T>()->hasData(entity);
+            return getComponentArray<T>()->hasData(entity);
         }
 
         /**
@@ -177,12 +233,57 @@ namespace ecs {
             }
         }
 
+        /**
+         * @brief Checks whether every component array can be copied into a snapshot
+         */
+        bool canSnapshot() const {
+            return std::all_of(mComponentArrays.begin(), mComponentArrays.end(),
+                [](const auto& componentArray) { return !componentArray || componentArray->canSnapshot(); });
+        }
+
+        /**
+         * @brief Writes every component array to a snapshot, in type ID order
+         */
+        void saveSnapshot(WorldSnapshot& snapshot) const {
+            const size_t arrayCount = static_cast<size_t>(std::count_if(mComponentArrays.begin(), mComponentArrays.end(),
+                [](const auto& componentArray) { return componentArray != nullptr; }));
+            snapshot.writeValue(arrayCount);
+            for (size_t type = 0; type < MAX_COMPONENTS; ++type) {
+                if (mComponentArrays[type]) {
+                    snapshot.writeValue(static_cast<ComponentType>(type));
+                    mComponentArrays[type]->saveSnapshot(snapshot);
+                }
+            }
+        }
+
+        /**
+         * @brief Replaces every component array with its contents saved by saveSnapshot()
+         *
+         * Arrays registered after the snapshot was taken are emptied.
+         *
+         * @param reader Reader positioned at the component data
+         * @param tick Change stamp given to every restored component
+         */
+        void restoreSnapshot(SnapshotReader& reader, ChangeTick tick) {
+            size_t remaining = reader.readValue<size_t>();
+            size_t nextType = remaining > 0 ? reader.readValue<ComponentType>() : MAX_COMPONENTS;
+            for (size_t type = 0; type < MAX_COMPONENTS; ++type) {
+                if (type == nextType) {
+                    assert(mComponentArrays[type] && "Snapshot restored into a different world.");
+                    mComponentArrays[type]->restoreSnapshot(reader, tick);
+                    nextType = --remaining > 0 ? reader.readValue<ComponentType>() : MAX_COMPONENTS;
+                } else if (mComponentArrays[type]) {
+                    mComponentArrays[type]->clear();
+                }
+            }
+        }
+
         /**
          * @brief Gets the number of registered component types
          * @return Number of component types
          */
         size_t getRegisteredComponentCount() const {
-            return mComponentTypes.size();
+            return mRegisteredComponentCount;
         }
 
         /**
@@ -192,7 +293,7 @@ namespace ecs {
          */
         template<typename T>
         size_t getComponentCount() const {
-            return const_cast<ComponentManager*>(this)->getComponentArray<T>()->getSize();
+            return getComponentArray<T>()->getSize();
         }
     };
 
@@ -4,11 +4,38 @@
 #include "ComponentManager.h"
 #include "SystemManager.h"
 #include "RuntimeResourceManager.h"
+#include "ArchetypeStorage.h"
+#include "EntityCommandBuffer.h"
+#include "View.h"
+#include "WorldSnapshot.h"
 #include "ECSTypes.h"
+#include <atomic>
+#include <cassert>
+#include <cstddef>
 #include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace ecs {
 
+    class WorldSchema;
+    class MappedFile;
+
+    /**
+     * @brief Component storage layout used by a Coordinator
+     */
+    enum class StorageMode {
+        /// One packed array per component type (default)
+        Sparse,
+        /// Entities grouped by signature into 16KiB SoA chunks (see ArchetypeStorage)
+        Archetype
+    };
+
     /**
      * @brief Main coordinator class providing unified access to ECS functionality
      *
@@ -22,23 +49,127 @@ namespace ecs {
      * - Handle entity lifecycle management
      * - Manage component registration and manipulation
      * - Coordinate system registration and updates
+     *
+     * In StorageMode::Archetype, component data lives in ArchetypeStorage and
+     * the ComponentManager only assigns type IDs. Adding or removing a
+     * component moves the entity's whole row, so references returned by
+     * getComponent() are invalidated by any structural change (add, remove,
+     * destroy) in that mode.
+     *
+     * Component changes are tracked with a ChangeTick clock. Adding a
+     * component, the non-const getComponent(), markChanged() and views over
+     * non-const component types stamp the components with the current tick.
+     * A consumer remembers the tick returned by advanceChangeTick() and
+     * later visits only what changed after it, using View::changedSince().
+     * Stamps are per entity with sparse storage and per chunk with
+     * archetype storage.
+     *
+     * Tag components (empty structs, see isTagComponent) are only bits in
+     * the entity signature in both storage modes. They can be added,
+     * removed, tested and used in system signatures, but have no data to
+     * get or view.
+     *
+     * snapshot() and restore() copy the whole world (entities, signatures
+     * and trivially copyable components) to and from a WorldSnapshot, for
+     * save states and rollback.
+     *
+     * saveWorld() and loadWorld() write and read the world as a versioned
+     * binary file with one column per component type (see WorldFile.h).
      */
     class Coordinator {
     private:
+        /// World files whose pages component storage uses in place (declared first, so released last)
+        std::vector<std::shared_ptr<MappedFile>> mMappedFiles;
+
         std::unique_ptr<EntityManager> mEntityManager;
         std::unique_ptr<ComponentManager> mComponentManager;
         std::unique_ptr<SystemManager> mSystemManager;
         std::unique_ptr<RuntimeResourceManager> mRuntimeResourceManager;
 
+        /// Archetype storage, only created in StorageMode::Archetype
+        std::unique_ptr<ArchetypeStorage> mArchetypeStorage;
+
+        /// Pool systems may use for parallel iteration (not owned, optional)
+        JobSystem* mJobSystem = nullptr;
+
+        /// Structural changes recorded by systems, applied after they update
+        EntityCommandBuffer mCommandBuffer;
+
+        /// Current change tracking tick (starts at 1 so that 0 means "never")
+        std::atomic<ChangeTick> mChangeTick{ 1 };
+
+        /**
+         * @brief Wraps a component for insertComponents(), or nothing for a tag
+         */
+        template<typename T>
+        static auto storedPart(const T& component) {
+            if constexpr (isTagComponent<T>) {
+                return std::tuple<>();
+            } else {
+                return std::tuple<const T&>(component);
+            }
+        }
+
+        /**
+         * @brief Stores the same components for many entities (signatures untouched)
+         *
+         * Tags are skipped, since they only exist in the signatures.
+         */
+        template<typename... Ts>
+        void insertComponents(std::span<const Entity> entities, const Ts&... components) {
+            std::apply([&](const auto&... stored) {
+                if constexpr (sizeof...(stored) > 0) {
+                    insertStoredComponents<std::remove_cvref_t<decltype(stored)>...>(entities, stored...);
+                }
+            }, std::tuple_cat(storedPart(components)...));
+        }
+
+        template<typename... Ts>
+        void insertStoredComponents(std::span<const Entity> entities, const Ts&... components) {
+            const ChangeTick tick = getChangeTick();
+            if (mArchetypeStorage) {
+                mArchetypeStorage->addComponents<Ts...>(entities, { mComponentManager->getComponentType<Ts>()... }, tick, components...);
+            } else {
+                (mComponentManager->addComponents<Ts>(entities, components, tick), ...);
+            }
+        }
+
+        void writeSnapshot(WorldSnapshot& snapshot, const WorldSnapshot* base) const {
+            if (!canSnapshot()) {
+                throw std::runtime_error("World holds components that are not trivially copyable");
+            }
+
+            snapshot.begin(this, base);
+            snapshot.writeValue(getStorageMode());
+            mEntityManager->saveSnapshot(snapshot);
+            if (mArchetypeStorage) {
+                mArchetypeStorage->saveSnapshot(snapshot);
+            } else {
+                mComponentManager->saveSnapshot(snapshot);
+            }
+        }
+
     public:
         /**
          * @brief Constructor - initializes all managers
+         * @param mode Component storage layout
          */
-        Coordinator() {
+        explicit Coordinator(StorageMode mode = StorageMode::Sparse) {
             mEntityManager = std::make_unique<EntityManager>();
             mComponentManager = std::make_unique<ComponentManager>();
             mSystemManager = std::make_unique<SystemManager>();
             mRuntimeResourceManager = std::make_unique<RuntimeResourceManager>();
+
+            if (mode == StorageMode::Archetype) {
+                mArchetypeStorage = std::make_unique<ArchetypeStorage>();
+            }
+        }
+
+        /**
+         * @brief Gets the component storage layout
+         */
+        StorageMode getStorageMode() const {
+            return mArchetypeStorage ? StorageMode::Archetype : StorageMode::Sparse;
         }
 
         // Entity methods
@@ -51,16 +182,63 @@ namespace ecs {
             return mEntityManager->createEntity();
         }
 
+        /**
+         * @brief Creates many entities that start with the same components
+         *
+         * Storage is reserved once for the whole batch, every entity receives
+         * its final signature directly, and systems are updated in a single
+         * batched pass instead of once per added component.
+         *
+         * @tparam Ts Component types (must be registered, each listed once)
+         * @param count Number of entities to create
+         * @param components Component data copied to every new entity
+         * @return The new entities
+         */
+        template<typename... Ts>
+        std::vector<Entity> createEntities(size_t count, const Ts&... components) {
+            std::vector<Entity> entities;
+            entities.reserve(count);
+            mEntityManager->reserve(batchCapacity(mEntityManager->getEntitySlotCount(), count));
+            for (size_t i = 0; i < count; ++i) {
+                entities.push_back(mEntityManager->createEntity());
+            }
+
+            if constexpr (sizeof...(Ts) > 0) {
+                insertComponents(std::span<const Entity>(entities), components...);
+
+                Signature signature;
+                (signature.set(mComponentManager->getComponentType<Ts>()), ...);
+                for (Entity entity : entities) {
+                    mEntityManager->setSignature(entity, signature);
+                }
+                mSystemManager->entitiesSignatureChanged(entities, signature);
+            }
+            return entities;
+        }
+
         /**
          * @brief Destroys an entity and cleans up all associated data
-         * @param entity Entity to destroy
+         * @param entity Entity to destroy (must be alive)
          */
         void destroyEntity(Entity entity) {
+            if (mArchetypeStorage) {
+                mArchetypeStorage->entityDestroyed(entity);
+            } else {
+                mComponentManager->entityDestroyed(entity);
+            }
             mEntityManager->destroyEntity(entity);
-            mComponentManager->entityDestroyed(entity);
             mSystemManager->entityDestroyed(entity);
         }
 
+        /**
+         * @brief Checks whether a handle refers to a living entity
+         * @param entity Handle to check
+         * @return false once the entity has been destroyed, even if its slot was reused
+         */
+        bool isAlive(Entity entity) const {
+            return mEntityManager->isAlive(entity);
+        }
+
         /**
          * @brief Gets the number of living entities
          * @return Current active entity count
@@ -78,6 +256,11 @@ namespace ecs {
         template<typename T>
         void registerComponent() {
             mComponentManager->registerComponent<T>();
+            if constexpr (!isTagComponent<T>) {
+                if (mArchetypeStorage) {
+                    mArchetypeStorage->registerComponent<T>(mComponentManager->getComponentType<T>());
+                }
+            }
         }
 
         /**
@@ -88,7 +271,13 @@ namespace ecs {
          */
         template<typename T>
         void addComponent(Entity entity, const T& component) {
-            mComponentManager->addComponent<T>(entity, component);
+            if constexpr (!isTagComponent<T>) {
+                if (mArchetypeStorage) {
+                    mArchetypeStorage->addComponent<T>(entity, mComponentManager->getComponentType<T>(), component, getChangeTick());
+                } else {
+                    mComponentManager->addComponent<T>(entity, component, getChangeTick());
+                }
+            }
 
             auto signature = mEntityManager->getSignature(entity);
             signature.set(mComponentManager->getComponentType<T>(), true);
@@ -97,6 +286,37 @@ namespace ecs {
             mSystemManager->entitySignatureChanged(entity, signature);
         }
 
+        /**
+         * @brief Adds the same components to many entities
+         *
+         * Like calling addComponent() for every entity and component, but
+         * storage is reserved once, each entity's signature is computed once,
+         * and systems are updated in a single batched pass. In archetype
+         * storage every entity moves once, straight to its final archetype.
+         *
+         * @tparam Ts Component types (must be registered, each listed once)
+         * @param entities Living entities that have none of the components yet
+         * @param components Component data copied to every entity
+         */
+        template<typename... Ts>
+        void addComponents(std::span<const Entity> entities, const Ts&... components) {
+            static_assert(sizeof...(Ts) > 0, "addComponents needs at least one component.");
+
+            insertComponents(entities, components...);
+
+            Signature added;
+            (added.set(mComponentManager->getComponentType<Ts>()), ...);
+
+            std::vector<Signature> signatures;
+            signatures.reserve(entities.size());
+            for (Entity entity : entities) {
+                Signature signature = mEntityManager->getSignature(entity) | added;
+                mEntityManager->setSignature(entity, signature);
+                signatures.push_back(signature);
+            }
+            mSystemManager->entitiesSignatureChanged(entities, signatures);
+        }
+
         /**
          * @brief Removes a component from an entity
          * @tparam T Component type
@@ -104,7 +324,13 @@ namespace ecs {
          */
         template<typename T>
         void removeComponent(Entity entity) {
-            mComponentManager->removeComponent<T>(entity);
+            if constexpr (!isTagComponent<T>) {
+                if (mArchetypeStorage) {
+                    mArchetypeStorage->removeComponent(entity, mComponentManager->getComponentType<T>());
+                } else {
+                    mComponentManager->removeComponent<T>(entity);
+                }
+            }
 
             auto signature = mEntityManager->getSignature(entity);
             signature.set(mComponentManager->getComponentType<T>(), false);
@@ -114,14 +340,22 @@ namespace ecs {
         }
 
         /**
-         * @brief Gets a component from an entity
+         * @brief Gets a component from an entity for writing
+         *
+         * The component is stamped as changed; read through the const
+         * overload to avoid that.
+         *
          * @tparam T Component type
          * @param entity Entity to get component from
          * @return Reference to the component
          */
         template<typename T>
         T& getComponent(Entity entity) {
-            return mComponentManager->getComponent<T>(entity);
+            static_assert(!isTagComponent<T>, "Tag components carry no data; use hasComponent().");
+            if (mArchetypeStorage) {
+                return *static_cast<T*>(mArchetypeStorage->getComponentForWrite(entity, mComponentManager->getComponentType<T>(), getChangeTick()));
+            }
+            return mComponentManager->getComponentStorage<T>().getDataForWrite(entity, getChangeTick());
         }
 
         /**
@@ -132,9 +366,50 @@ namespace ecs {
          */
         template<typename T>
         const T& getComponent(Entity entity) const {
+            static_assert(!isTagComponent<T>, "Tag components carry no data; use hasComponent().");
+            if (mArchetypeStorage) {
+                return *static_cast<const T*>(mArchetypeStorage->getComponent(entity, mComponentManager->getComponentType<T>()));
+            }
             return mComponentManager->getComponent<T>(entity);
         }
 
+        /**
+         * @brief Stamps a component as changed
+         *
+         * For code that keeps a reference to a component and writes through
+         * it later, outside of getComponent() and views.
+         *
+         * @tparam T Component type
+         * @param entity Entity that owns the component
+         */
+        template<typename T>
+        void markChanged(Entity entity) {
+            (void)getComponent<T>(entity);
+        }
+
+        /**
+         * @brief Gets the current change tracking tick
+         * @return Stamp given to components changed from now on
+         */
+        ChangeTick getChangeTick() const {
+            return mChangeTick.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Ends the current change tracking tick
+         *
+         * Consumers call this when they start processing and keep the result.
+         * Every change made before the call is stamped with at most the
+         * returned tick and every change after it with a later one, so the
+         * next run can pass the kept value to View::changedSince() and see
+         * each change exactly once. Safe to call from concurrent systems.
+         *
+         * @return The tick that just ended
+         */
+        ChangeTick advanceChangeTick() {
+            return mChangeTick.fetch_add(1, std::memory_order_relaxed);
+        }
+
         /**
          * @brief Checks if an entity has a specific component
          * @tparam T Component type
@@ -143,7 +418,14 @@ namespace ecs {
          */
         template<typename T>
         bool hasComponent(Entity entity) const {
-            return mComponentManager->hasComponent<T>(entity);
+            // Archetype storage and tags keep presence in the signature only
+            if constexpr (!isTagComponent<T>) {
+                if (!mArchetypeStorage) {
+                    return mComponentManager->hasComponent<T>(entity);
+                }
+            }
+            return mEntityManager->isAlive(entity) &&
+                mEntityManager->getSignature(entity).test(mComponentManager->getComponentType<T>());
         }
 
         /**
@@ -158,14 +440,187 @@ namespace ecs {
 
         /**
          * @brief Gets the current size of a specific component array
+         *
+         * Tags have no array, so counting one visits every living entity.
+         *
          * @tparam T Component type
          * @return Number of components of type T
          */
         template<typename T>
         size_t getComponentCount() const {
-            return mComponentManager->getComponentCount<T>();
+            if constexpr (isTagComponent<T>) {
+                const ComponentType type = mComponentManager->getComponentType<T>();
+                size_t count = 0;
+                mEntityManager->forEachEntity([&](Entity entity) {
+                    count += mEntityManager->getSignature(entity).test(type) ? 1 : 0;
+                });
+                return count;
+            } else {
+                if (mArchetypeStorage) {
+                    return mArchetypeStorage->getComponentCount(mComponentManager->getComponentType<T>());
+                }
+                return mComponentManager->getComponentCount<T>();
+            }
+        }
+
+        /**
+         * @brief Creates a view over all entities that have every given component
+         *
+         * Component storages are resolved here once; iterating the view then
+         * hands out references without per-entity type lookups. Works with
+         * both storage modes.
+         *
+         * Components of non-const types in Ts are stamped as changed when
+         * the view visits them; list read-only components as const.
+         *
+         * @tparam Ts Required component types (must be registered), optionally const
+         * @return View supporting range-for with structured bindings and each()
+         */
+        template<typename... Ts>
+        View<Ts...> view() {
+            static_assert((!isTagComponent<std::remove_const_t<Ts>> && ...), "Tag components have no data to view; use hasComponent() or a system signature.");
+            if (mArchetypeStorage) {
+                return View<Ts...>(*mArchetypeStorage, { mComponentManager->getComponentType<std::remove_const_t<Ts>>()... }, getChangeTick());
+            }
+            return View<Ts...>(getChangeTick(), mComponentManager->getComponentStorage<std::remove_const_t<Ts>>()...);
         }
 
+        /**
+         * @brief Iterates every archetype chunk holding all of the given components
+         *
+         * Only available in StorageMode::Archetype. The callback receives the
+         * number of rows in the chunk, the chunk's entity handles and one
+         * pointer per component type to its contiguous column, so the body can
+         * be a plain indexed loop. Components must not be added or removed and
+         * entities must not be destroyed from inside the callback. Columns of
+         * non-const types are stamped as changed.
+         *
+         * @tparam Ts Required component types, optionally const
+         * @param func Callable taking (size_t count, const Entity* entities, Ts*... columns)
+         */
+        template<typename... Ts, typename Func>
+        void forEachChunk(Func&& func) {
+            static_assert((!isTagComponent<std::remove_const_t<Ts>> && ...), "Tag components have no data to view; use hasComponent() or a system signature.");
+            assert(mArchetypeStorage && "forEachChunk requires StorageMode::Archetype.");
+
+            const std::array<ComponentType, sizeof...(Ts)> types{ mComponentManager->getComponentType<std::remove_const_t<Ts>>()... };
+            Signature required;
+            for (ComponentType type : types) {
+                required.set(type);
+            }
+
+            const ChangeTick tick = getChangeTick();
+            mArchetypeStorage->forEachChunk(required, [&](const Archetype& archetype, size_t chunk) {
+                [&]<size_t... I>(std::index_sequence<I...>) {
+                    ((std::is_const_v<Ts> ? void() : archetype.markChunkChanged(types[I], chunk, tick)), ...);
+                    func(archetype.getChunkSize(chunk), archetype.getEntities(chunk),
+                        static_cast<Ts*>(archetype.getColumn(types[I], chunk))...);
+                }(std::index_sequence_for<Ts...>{});
+            });
+        }
+
+        // Snapshot methods
+
+        /**
+         * @brief Checks whether the world can be copied into a snapshot
+         * @return false if any entity has a component that is not trivially copyable
+         */
+        bool canSnapshot() const {
+            return mArchetypeStorage ? mArchetypeStorage->canSnapshot() : mComponentManager->canSnapshot();
+        }
+
+        /**
+         * @brief Copies entities, signatures and components into a snapshot
+         *
+         * Component storage is copied chunk by chunk with memcpy into the
+         * snapshot's arena, which is reused when the same snapshot is taken
+         * again. System entity lists, runtime resources and the command
+         * buffer are not part of the snapshot.
+         *
+         * @param snapshot Snapshot to overwrite
+         * @throws std::runtime_error if canSnapshot() is false
+         */
+        void snapshot(WorldSnapshot& snapshot) const {
+            writeSnapshot(snapshot, nullptr);
+        }
+
+        /**
+         * @brief Copies the world into a delta snapshot
+         *
+         * Only the blocks (component chunks, archetype chunks, slices of the
+         * entity tables) that differ from the base are stored; restoring
+         * reads the rest from the base.
+         *
+         * @param snapshot Snapshot to overwrite
+         * @param base Earlier snapshot of this coordinator, full or delta (must outlive snapshot)
+         * @throws std::runtime_error if canSnapshot() is false
+         */
+        void snapshot(WorldSnapshot& snapshot, const WorldSnapshot& base) const {
+            assert(base.getSource() == this && "Delta base taken from another coordinator.");
+            writeSnapshot(snapshot, &base);
+        }
+
+        /**
+         * @brief Puts the world back into the state captured by snapshot()
+         *
+         * Entities created since are dropped and destroyed ones come back
+         * with their old handles. Every restored component counts as changed
+         * at the current tick, so change tracking consumers see the jump.
+         * System entity lists are rebuilt. Must not run while systems update
+         * or with commands waiting for playback.
+         *
+         * @param snapshot Snapshot taken from this coordinator
+         */
+        void restore(const WorldSnapshot& snapshot) {
+            assert(snapshot.getSource() == this && "Snapshot taken from another coordinator.");
+            assert(mCommandBuffer.isEmpty() && "Restoring with commands waiting for playback.");
+
+            SnapshotReader reader(snapshot);
+            [[maybe_unused]] const StorageMode mode = reader.readValue<StorageMode>();
+            assert(mode == getStorageMode() && "Snapshot taken with another storage mode.");
+
+            const ChangeTick tick = getChangeTick();
+            mEntityManager->restoreSnapshot(reader);
+            if (mArchetypeStorage) {
+                mArchetypeStorage->restoreSnapshot(reader, tick);
+            } else {
+                mComponentManager->restoreSnapshot(reader, tick);
+            }
+            mSystemManager->rebuildEntityLists(*mEntityManager);
+        }
+
+        // World file methods
+
+        /**
+         * @brief Writes all entities and components to a world file
+         *
+         * Defined in WorldFile.cpp. Every component type present in the
+         * world must be listed in the schema.
+         *
+         * @param path File to create or overwrite
+         * @param schema Names and encodings of the component types
+         * @throws std::runtime_error if a component type is missing from the schema or the file cannot be written
+         */
+        void saveWorld(const std::string& path, const WorldSchema& schema) const;
+
+        /**
+         * @brief Loads the entities and components of a world file
+         *
+         * Defined in WorldFile.cpp. The file is memory-mapped copy-on-write.
+         * In StorageMode::Sparse, trivially copyable columns are used in
+         * place as component storage without copying, and the mapping stays
+         * open for the lifetime of the coordinator; in StorageMode::Archetype
+         * they are copied into archetype chunks. Entities keep the handles
+         * they had when saved. Loaded components count as changed at the
+         * current tick, and system entity lists are rebuilt. Must be called
+         * before the coordinator has created any entity.
+         *
+         * @param path World file written by saveWorld()
+         * @param schema Names and encodings of the component types (must all be registered)
+         * @throws std::runtime_error if the file is missing, malformed, or does not match the schema
+         */
+        void loadWorld(const std::string& path, const WorldSchema& schema);
+
         // System methods
 
         /**
@@ -186,18 +641,15 @@ namespace ecs {
          * @param signature Required component signature
          */
         template<typename T>
-        void setSystemSignature(Signature signature) {
+        void setSystemSignature(const Signature& signature) {
             mSystemManager->setSignature<T>(signature);
 
-            // Update system entity lists for all existing entities
-            for (Entity entity = 0; entity < MAX_ENTITIES; ++entity) {
-                if (mEntityManager->getLivingEntityCount() == 0) break;
-
-                auto entitySignature = mEntityManager->getSignature(entity);
-                if (entitySignature.any()) { // Entity is alive if it has any signature
-                    mSystemManager->entitySignatureChanged(entity, entitySignature);
-                }
-            }
+            // Only this system's entity list depends on the new signature
+            std::shared_ptr<T> system = mSystemManager->getSystem<T>();
+            system->clearEntities();
+            mEntityManager->forEachMatching(signature, [&system](Entity entity) {
+                system->addEntity(entity);
+            });
         }
 
         /**
@@ -211,11 +663,77 @@ namespace ecs {
         }
 
         /**
-         * @brief Updates all systems
+         * @brief Updates all systems, then plays back the command buffer
          * @param deltaTime Time elapsed since last update
          */
         void updateSystems(float deltaTime) {
             mSystemManager->updateAllSystems(deltaTime);
+            playbackCommands();
+        }
+
+        /**
+         * @brief Updates all systems, running non-conflicting ones in parallel
+         *
+         * Systems that declared their component reads and writes are spread
+         * over the job pool. Exclusive systems (including any that declared
+         * nothing) still run alone on the calling thread, in registration order.
+         * The command buffer is played back once every system has finished.
+         *
+         * @param deltaTime Time elapsed since last update
+         * @param jobs Pool that runs the systems
+         */
+        void updateSystems(float deltaTime, JobSystem& jobs) {
+            mSystemManager->updateAllSystems(deltaTime, jobs);
+            playbackCommands();
+        }
+
+        /**
+         * @brief Gets the per-system update timings
+         *
+         * Empty statistics when profiling is compiled out (see
+         * SYSTEM_PROFILING_ENABLED).
+         */
+        SystemProfiler& getSystemProfiler() {
+            return mSystemManager->getProfiler();
+        }
+
+        const SystemProfiler& getSystemProfiler() const {
+            return mSystemManager->getProfiler();
+        }
+
+        /**
+         * @brief Gets the buffer systems record structural changes into
+         *
+         * Commands may be recorded from any thread while systems update and
+         * are applied by playbackCommands(), which updateSystems() calls.
+         */
+        EntityCommandBuffer& getCommandBuffer() {
+            return mCommandBuffer;
+        }
+
+        /**
+         * @brief Applies the structural changes recorded in the command buffer
+         *
+         * Must not run while systems are updating or recording.
+         */
+        void playbackCommands() {
+            mCommandBuffer.playback(*this);
+        }
+
+        /**
+         * @brief Sets the job pool systems use for parallel iteration
+         * @param jobs Pool to share, or nullptr to keep systems single-threaded (must outlive its use)
+         */
+        void setJobSystem(JobSystem* jobs) {
+            mJobSystem = jobs;
+        }
+
+        /**
+         * @brief Gets the job pool shared with systems
+         * @return The pool, or nullptr if none was set
+         */
+        JobSystem* getJobSystem() const {
+            return mJobSystem;
         }
 
         /**
@@ -15,22 +15,33 @@
 #include "IComponentArray.h"
 
 // Component management
+#include "ChunkedArray.h"
+#include "WorldSnapshot.h"
+#include "SparseSet.h"
 #include "ComponentArray.h"
 #include "ComponentManager.h"
+#include "Archetype.h"
+#include "ArchetypeStorage.h"
+#include "View.h"
+#include "EntityCommandBuffer.h"
 
 // Entity management
 #include "EntityManager.h"
 
 // System management
+#include "JobSystem.h"
 #include "System.h"
+#include "SystemProfiler.h"
 #include "SystemManager.h"
 
 // Main coordinator
 #include "Coordinator.h"
+#include "WorldFile.h"
 
 // Input and Event System
 #include "InputState.h"
 #include "EventBus.h"
+#include "EventLog.h"
 #include "GlobalFlags.h"
 #include "RuntimeResourceManager.h"
 
@@ -45,10 +56,11 @@ namespace ecs {
 
     /**
      * @brief Creates a default ECS coordinator instance
+     * @param mode Component storage layout
      * @return Unique pointer to a new Coordinator
      */
-    inline std::unique_ptr<Coordinator> createCoordinator() {
-        return std::make_unique<Coordinator>();
+    inline std::unique_ptr<Coordinator> createCoordinator(StorageMode mode = StorageMode::Sparse) {
+        return std::make_unique<Coordinator>(mode);
     }
 
 } // namespace ecs
@@ -1,33 +1,137 @@
 #pragma once
 
-#include <bitset>
+#include "Signature.h"
+#include <cstddef>
 #include <cstdint>
+#include <type_traits>
 
 namespace ecs {
 
     /**
-     * @brief Maximum number of entities that can exist simultaneously
+     * @brief Unique identifier for an entity
+     *
+     * A handle packs a slot index (low ENTITY_INDEX_BITS) and the generation of
+     * that slot (high bits). Destroying an entity bumps its slot's generation,
+     * so handles kept past destruction no longer compare equal to the entity
+     * that later reuses the slot.
+     */
+    using Entity = std::uint32_t;
+
+    /**
+     * @brief Number of handle bits used for the slot index
+     */
+    static constexpr unsigned ENTITY_INDEX_BITS = 20;
+
+    /**
+     * @brief Number of handle bits used for the slot generation
+     */
+    static constexpr unsigned ENTITY_GENERATION_BITS = 32 - ENTITY_INDEX_BITS;
+
+    /**
+     * @brief Mask selecting the slot index of a handle
      */
-    static constexpr size_t MAX_ENTITIES = 5000;
+    static constexpr Entity ENTITY_INDEX_MASK = (Entity{ 1 } << ENTITY_INDEX_BITS) - 1;
+
+    /**
+     * @brief Mask selecting the generation of a handle (after shifting)
+     */
+    static constexpr Entity ENTITY_GENERATION_MASK = (Entity{ 1 } << ENTITY_GENERATION_BITS) - 1;
+
+    /**
+     * @brief Upper bound on entities that can exist simultaneously
+     *
+     * This is an addressing limit, not a preallocation: entity and component
+     * storage grows on demand and only pays for the entities actually created.
+     * The last slot index is reserved so that no live handle equals NULL_ENTITY.
+     */
+    static constexpr size_t MAX_ENTITIES = size_t{ 1 } << ENTITY_INDEX_BITS;
+
+    /**
+     * @brief Handle that never refers to a living entity
+     */
+    static constexpr Entity NULL_ENTITY = ~Entity{ 0 };
+
+    /**
+     * @brief Extracts the slot index of an entity handle
+     */
+    constexpr Entity entityIndex(Entity entity) {
+        return entity & ENTITY_INDEX_MASK;
+    }
+
+    /**
+     * @brief Extracts the generation of an entity handle
+     */
+    constexpr Entity entityGeneration(Entity entity) {
+        return entity >> ENTITY_INDEX_BITS;
+    }
+
+    /**
+     * @brief Builds an entity handle from a slot index and generation
+     */
+    constexpr Entity makeEntity(Entity index, Entity generation) {
+        return (index & ENTITY_INDEX_MASK) | ((generation & ENTITY_GENERATION_MASK) << ENTITY_INDEX_BITS);
+    }
+
+#ifndef ECS_MAX_COMPONENTS
+#define ECS_MAX_COMPONENTS 128
+#endif
 
     /**
      * @brief Maximum number of component types that can be registered
+     *
+     * Set with the ECS_MAX_COMPONENTS compile definition (64, 128 or 256).
+     * 128 keeps a signature in one SSE register.
      */
-    static constexpr size_t MAX_COMPONENTS = 32;
+    static constexpr size_t MAX_COMPONENTS = ECS_MAX_COMPONENTS;
 
     /**
-     * @brief Unique identifier for an entity
+     * @brief Assumed size of a CPU cache line, used to align storage and work splits
      */
-    using Entity = std::uint32_t;
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+    /**
+     * @brief Capacity to reserve before appending a batch to a container
+     *
+     * Never less than twice the current size, so a series of small batches
+     * keeps the amortized growth of single appends instead of reallocating
+     * on every batch.
+     *
+     * @param currentSize Elements already stored
+     * @param batchSize Elements about to be appended
+     */
+    constexpr size_t batchCapacity(size_t currentSize, size_t batchSize) {
+        return currentSize + batchSize > currentSize * 2 ? currentSize + batchSize : currentSize * 2;
+    }
+
+    /**
+     * @brief Point in time used for component change tracking
+     *
+     * Every Coordinator keeps a clock of these ticks. Components are stamped
+     * with the current tick whenever they are added or handed out for
+     * writing, so comparing stamps with a tick remembered earlier tells
+     * which components changed since then. Tick 0 means "never changed".
+     */
+    using ChangeTick = std::uint32_t;
 
     /**
      * @brief Component type identifier
      */
-    using ComponentType = std::uint8_t;
+    using ComponentType = std::uint16_t;
 
     /**
      * @brief Bitset representing which components an entity possesses
      */
-    using Signature = std::bitset<MAX_COMPONENTS>;
+    using Signature = BasicSignature<MAX_COMPONENTS>;
+
+    /**
+     * @brief Whether a component type is a tag
+     *
+     * Tags are empty structs whose presence is the only information they
+     * carry, so they are kept only as bits in the entity Signature: adding,
+     * removing and testing one is a bit operation and no storage is
+     * allocated for the type.
+     */
+    template<typename T>
+    inline constexpr bool isTagComponent = std::is_empty_v<T>;
 
 } // namespace ecs
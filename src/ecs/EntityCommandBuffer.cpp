@@ -0,0 +1,118 @@
+#include "EntityCommandBuffer.h"
+#include "Coordinator.h"
+#include <algorithm>
+#include <iterator>
+
+namespace ecs {
+
+    namespace {
+        /// Source of buffer IDs; 0 is never issued so an empty cache matches no buffer
+        std::atomic<std::uint64_t> gNextBufferId{ 1 };
+    }
+
+    thread_local EntityCommandBuffer::StreamCache EntityCommandBuffer::sStreamCache;
+
+    EntityCommandBuffer::EntityCommandBuffer()
+        : mId(gNextBufferId.fetch_add(1, std::memory_order_relaxed)) {}
+
+    EntityCommandBuffer::Stream& EntityCommandBuffer::currentStream() {
+        if (sStreamCache.bufferId == mId) {
+            return *sStreamCache.stream;
+        }
+
+        // A thread alternating between buffers misses the cache on every
+        // switch; it finds its stream again instead of starting another
+        const std::thread::id thread = std::this_thread::get_id();
+        std::lock_guard<std::mutex> lock(mStreamsMutex);
+        auto stream = std::find_if(mStreams.begin(), mStreams.end(),
+            [thread](const std::unique_ptr<Stream>& candidate) { return candidate->owner == thread; });
+        if (stream == mStreams.end()) {
+            mStreams.push_back(std::make_unique<Stream>(thread));
+            stream = std::prev(mStreams.end());
+        }
+        sStreamCache = { mId, stream->get() };
+        return *sStreamCache.stream;
+    }
+
+    void EntityCommandBuffer::playback(Coordinator& coordinator) {
+        mSorted.clear();
+        for (const auto& stream : mStreams) {
+            for (const Command& command : stream->commands) {
+                mSorted.push_back(&command);
+            }
+        }
+        if (mSorted.empty()) {
+            return;
+        }
+
+        // Group by entity slot, creations last, each in schedule order; stable
+        // so commands of threads recording at the same order keep stream order
+        std::stable_sort(mSorted.begin(), mSorted.end(), [](const Command* a, const Command* b) {
+            const bool aCreates = a->type == CommandType::Create;
+            const bool bCreates = b->type == CommandType::Create;
+            if (aCreates != bCreates) {
+                return bCreates;
+            }
+            if (entityIndex(a->entity) != entityIndex(b->entity)) {
+                return entityIndex(a->entity) < entityIndex(b->entity);
+            }
+            if (a->order != b->order) {
+                return a->order < b->order;
+            }
+            return a->sequence < b->sequence;
+        });
+
+        size_t groupBegin = 0;
+        while (groupBegin < mSorted.size() && mSorted[groupBegin]->type != CommandType::Create) {
+            const Entity slot = entityIndex(mSorted[groupBegin]->entity);
+            size_t groupEnd = groupBegin;
+            Entity destroyed = NULL_ENTITY;
+            while (groupEnd < mSorted.size() && mSorted[groupEnd]->type != CommandType::Create &&
+                entityIndex(mSorted[groupEnd]->entity) == slot) {
+                const Command& command = *mSorted[groupEnd];
+                if (command.type == CommandType::Destroy && coordinator.isAlive(command.entity)) {
+                    destroyed = command.entity;
+                }
+                ++groupEnd;
+            }
+
+            // Nothing is created before this loop ends, so a stale handle in the
+            // group can never alias a new entity in the same slot
+            if (destroyed != NULL_ENTITY) {
+                coordinator.destroyEntity(destroyed);
+            } else {
+                for (size_t i = groupBegin; i < groupEnd; ++i) {
+                    const Command& command = *mSorted[i];
+                    if (coordinator.isAlive(command.entity)) {
+                        command.apply(coordinator, command.entity, command.payload);
+                    }
+                }
+            }
+            groupBegin = groupEnd;
+        }
+
+        for (size_t i = groupBegin; i < mSorted.size(); ++i) {
+            mSorted[i]->apply(coordinator, NULL_ENTITY, mSorted[i]->payload);
+        }
+
+        mSorted.clear();
+        clear();
+    }
+
+    void EntityCommandBuffer::clear() {
+        std::lock_guard<std::mutex> lock(mStreamsMutex);
+        for (const auto& stream : mStreams) {
+            stream->reset();
+        }
+    }
+
+    size_t EntityCommandBuffer::getCommandCount() const {
+        std::lock_guard<std::mutex> lock(mStreamsMutex);
+        size_t count = 0;
+        for (const auto& stream : mStreams) {
+            count += stream->commands.size();
+        }
+        return count;
+    }
+
+} // namespace ecs
@@ -0,0 +1,312 @@
+#pragma once
+
+#include "ECSTypes.h"
+#include "ExecutionOrder.h"
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <span>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace ecs {
+
+    class Coordinator;
+
+    /**
+     * @brief Records structural changes and applies them later at a sync point
+     *
+     * Systems must not create or destroy entities or add or remove components
+     * while other code iterates the ECS. Instead they record the change here;
+     * the Coordinator plays the buffer back after the systems have updated.
+     *
+     * Recording is thread-safe: every thread appends to its own stream, so
+     * jobs of a parallel system can record without locking. Each command is
+     * stamped with the ExecutionOrder it was recorded at. Playback gathers
+     * all streams and sorts the commands by entity, then by that order,
+     * which groups the changes to each entity and makes the outcome
+     * independent of which thread recorded first:
+     * - Commands on an entity apply in schedule order: by recording system,
+     *   then by the system's parallelFor() jobs, then in recording order
+     * - Only commands recorded at the same order by several threads, such as
+     *   threads outside the JobSystem, keep the order the threads first recorded in
+     * - An entity that is destroyed in the buffer skips its other commands
+     * - Commands on entities that are dead at playback are dropped
+     * - Created entities are spawned last, with all their components at once
+     *
+     * Adding a component the entity already has overwrites it, and removing
+     * one it lacks does nothing, so commands from several systems coalesce
+     * instead of asserting. Recording must not overlap playback or clear().
+     */
+    class EntityCommandBuffer {
+    private:
+        using ApplyFn = void (*)(Coordinator&, Entity, void*);
+        using DestroyFn = void (*)(void*);
+
+        enum class CommandType : std::uint8_t {
+            Create,
+            Destroy,
+            Add,
+            Remove
+        };
+
+        struct Command {
+            CommandType type;
+            Entity entity;
+            /// Type-erased operation (create/add/remove)
+            ApplyFn apply;
+            /// Payload destructor, null when there is nothing to destroy
+            DestroyFn destroy;
+            /// Component data owned by the stream's arena (create/add)
+            void* payload;
+            /// Where in the schedule the command was recorded
+            ExecutionOrder order;
+            /// Position in the recording stream, to keep the order within an ExecutionOrder
+            std::uint32_t sequence;
+        };
+
+        /**
+         * @brief Commands recorded by one thread, with an arena for their payloads
+         *
+         * Payloads are placed in fixed blocks that are never reallocated, so
+         * components need not be trivially copyable. Blocks are kept across
+         * frames and reused.
+         */
+        class Stream {
+        private:
+            struct Block {
+                std::byte* data;
+                size_t size;
+            };
+
+            std::vector<Block> mBlocks;
+            size_t mBlockIndex = 0;
+            size_t mOffset = 0;
+
+        public:
+            static constexpr size_t BLOCK_BYTES = 16 * 1024;
+
+            std::vector<Command> commands;
+
+            /// Thread recording into this stream
+            const std::thread::id owner;
+
+            explicit Stream(std::thread::id owner) : owner(owner) {}
+            Stream(const Stream&) = delete;
+            Stream& operator=(const Stream&) = delete;
+
+            ~Stream() {
+                reset();
+                for (const Block& block : mBlocks) {
+                    ::operator delete(block.data, std::align_val_t{ CACHE_LINE_SIZE });
+                }
+            }
+
+            void* allocate(size_t size, size_t alignment) {
+                while (true) {
+                    if (mBlockIndex < mBlocks.size()) {
+                        const Block& block = mBlocks[mBlockIndex];
+                        const size_t offset = (mOffset + alignment - 1) & ~(alignment - 1);
+                        if (offset + size <= block.size) {
+                            mOffset = offset + size;
+                            return block.data + offset;
+                        }
+                        ++mBlockIndex;
+                        mOffset = 0;
+                        continue;
+                    }
+
+                    const size_t bytes = size > BLOCK_BYTES ? size : BLOCK_BYTES;
+                    mBlocks.push_back({ static_cast<std::byte*>(::operator new(bytes, std::align_val_t{ CACHE_LINE_SIZE })), bytes });
+                }
+            }
+
+            /// Destroys the payloads and forgets the commands (blocks are kept)
+            void reset() {
+                for (const Command& command : commands) {
+                    if (command.destroy) {
+                        command.destroy(command.payload);
+                    }
+                }
+                commands.clear();
+                mBlockIndex = 0;
+                mOffset = 0;
+            }
+        };
+
+        /// One stream per recording thread, in the order the threads first recorded (guarded by mStreamsMutex)
+        std::vector<std::unique_ptr<Stream>> mStreams;
+        mutable std::mutex mStreamsMutex;
+
+        /// Process-unique ID, so a thread's cached stream is never mistaken for another buffer's
+        const std::uint64_t mId;
+
+        /// Last buffer the current thread recorded into, and its stream there
+        struct StreamCache {
+            std::uint64_t bufferId = 0;
+            Stream* stream = nullptr;
+        };
+        static thread_local StreamCache sStreamCache;
+
+        /// Scratch list of commands sorted for playback, kept to reuse its capacity
+        std::vector<const Command*> mSorted;
+
+        /**
+         * @brief Gets the calling thread's stream, creating it on first use
+         */
+        Stream& currentStream();
+
+        static void record(Stream& stream, CommandType type, Entity entity, ApplyFn apply, DestroyFn destroy, void* payload) {
+            stream.commands.push_back({ type, entity, apply, destroy, payload, detail::currentExecutionOrder,
+                static_cast<std::uint32_t>(stream.commands.size()) });
+        }
+
+        template<typename T>
+        T* emplacePayload(Stream& stream, const T& value) {
+            static_assert(alignof(T) <= CACHE_LINE_SIZE, "Over-aligned components cannot be recorded.");
+            return ::new (stream.allocate(sizeof(T), alignof(T))) T(value);
+        }
+
+        template<typename T>
+        static DestroyFn destroyerOf() {
+            if constexpr (std::is_trivially_destructible_v<T>) {
+                return nullptr;
+            } else {
+                return [](void* payload) { static_cast<T*>(payload)->~T(); };
+            }
+        }
+
+        // Thunks take the coordinator as a template parameter so they only
+        // need the complete Coordinator type where a command is recorded.
+
+        template<typename C, typename... Ts>
+        static void applyCreate(C& coordinator, Entity, void* payload) {
+            Entity entity = coordinator.createEntity();
+            if constexpr (sizeof...(Ts) > 0) {
+                std::apply([&](const Ts&... components) {
+                    coordinator.addComponents(std::span<const Entity>(&entity, 1), components...);
+                }, *static_cast<std::tuple<Ts...>*>(payload));
+            }
+        }
+
+        template<typename C, typename T>
+        static void applyAdd(C& coordinator, Entity entity, void* payload) {
+            if constexpr (isTagComponent<T>) {
+                // Tags are recorded without a payload
+                if (!coordinator.template hasComponent<T>(entity)) {
+                    coordinator.addComponent(entity, T{});
+                }
+            } else {
+                T& component = *static_cast<T*>(payload);
+                if (coordinator.template hasComponent<T>(entity)) {
+                    coordinator.template getComponent<T>(entity) = std::move(component);
+                } else {
+                    coordinator.addComponent(entity, component);
+                }
+            }
+        }
+
+        template<typename C, typename T>
+        static void applyRemove(C& coordinator, Entity entity, void*) {
+            if (coordinator.template hasComponent<T>(entity)) {
+                coordinator.template removeComponent<T>(entity);
+            }
+        }
+
+    public:
+        EntityCommandBuffer();
+
+        /**
+         * @brief Discards every command that was not played back
+         */
+        ~EntityCommandBuffer() = default;
+
+        EntityCommandBuffer(const EntityCommandBuffer&) = delete;
+        EntityCommandBuffer& operator=(const EntityCommandBuffer&) = delete;
+
+        /**
+         * @brief Records the creation of an entity
+         *
+         * The handle only exists after playback, so the entity's initial
+         * components are given here and added together in one step.
+         *
+         * @tparam Ts Component types (must be registered, each listed once)
+         * @param components Initial component data
+         */
+        template<typename... Ts>
+        void createEntity(const Ts&... components) {
+            Stream& stream = currentStream();
+            void* payload = nullptr;
+            DestroyFn destroy = nullptr;
+            if constexpr (sizeof...(Ts) > 0) {
+                payload = emplacePayload(stream, std::tuple<Ts...>(components...));
+                destroy = destroyerOf<std::tuple<Ts...>>();
+            }
+            record(stream, CommandType::Create, NULL_ENTITY, &applyCreate<Coordinator, Ts...>, destroy, payload);
+        }
+
+        /**
+         * @brief Records the destruction of an entity
+         * @param entity Entity to destroy (ignored at playback if already dead)
+         */
+        void destroyEntity(Entity entity) {
+            record(currentStream(), CommandType::Destroy, entity, nullptr, nullptr, nullptr);
+        }
+
+        /**
+         * @brief Records adding (or overwriting) a component
+         * @tparam T Component type (must be registered)
+         * @param entity Target entity
+         * @param component Component data, copied into the buffer
+         */
+        template<typename T>
+        void addComponent(Entity entity, const T& component) {
+            Stream& stream = currentStream();
+            T* payload = nullptr;
+            if constexpr (!isTagComponent<T>) {
+                payload = emplacePayload(stream, component);
+            }
+            record(stream, CommandType::Add, entity, &applyAdd<Coordinator, T>, destroyerOf<T>(), payload);
+        }
+
+        /**
+         * @brief Records removing a component
+         * @tparam T Component type (must be registered)
+         * @param entity Target entity
+         */
+        template<typename T>
+        void removeComponent(Entity entity) {
+            record(currentStream(), CommandType::Remove, entity, &applyRemove<Coordinator, T>, nullptr, nullptr);
+        }
+
+        /**
+         * @brief Applies every recorded command and empties the buffer
+         * @param coordinator Coordinator the commands were recorded for
+         */
+        void playback(Coordinator& coordinator);
+
+        /**
+         * @brief Discards every recorded command
+         */
+        void clear();
+
+        /**
+         * @brief Gets the number of recorded commands
+         */
+        size_t getCommandCount() const;
+
+        /**
+         * @brief Checks whether no command is waiting for playback
+         */
+        bool isEmpty() const {
+            return getCommandCount() == 0;
+        }
+    };
+
+} // namespace ecs
@@ -1,9 +1,11 @@
 #pragma once
 
 #include "ECSTypes.h"
-#include <array>
-#include <queue>
+#include "ChunkedArray.h"
+#include "WorldSnapshot.h"
+#include <vector>
 #include <cassert>
+#include <span>
 
 namespace ecs {
 
@@ -11,71 +13,113 @@ namespace ecs {
      * @brief Manages entity creation, destruction, and signatures
      *
      * Responsibilities:
-     * - Provide unique entity IDs through ID recycling
+     * - Provide generation-tagged entity handles through slot recycling
+     * - Answer liveness queries for handles
      * - Maintain entity signatures (component bitsets)
      * - Track active entity count
+     *
+     * Every slot stores a handle. For a living entity it is the entity's current
+     * handle, so isAlive() is a single comparison. For a free slot, the index
+     * bits link to the next free slot and the generation bits hold the
+     * generation the slot will be reissued with: the free list is threaded
+     * through the slot array itself, and create/destroy never allocate once
+     * the slot array has grown to the working set.
      */
     class EntityManager {
+    public:
+        /// Sentinel index terminating the free list
+        static constexpr Entity NULL_INDEX = ENTITY_INDEX_MASK;
+
     private:
-        /// Queue of available entity IDs for recycling
-        std::queue<Entity> mAvailableEntities;
 
-        /// Array storing signature for each entity
-        std::array<Signature, MAX_ENTITIES> mSignatures;
+        /// Handle per slot (living entity handle, or free-list link)
+        std::vector<Entity> mSlots;
+
+        /// Signature per slot
+        ChunkedArray<Signature> mSignatures;
+
+        /// Head of the intrusive free list
+        Entity mFreeHead;
 
         /// Number of currently active entities
         size_t mLivingEntityCount;
 
     public:
         /**
-         * @brief Constructor - initializes available entity queue
+         * @brief Constructor
          */
-        EntityManager() : mLivingEntityCount(0) {
-            // Initialize all entity IDs as available
-            for (Entity entity = 0; entity < MAX_ENTITIES; ++entity) {
-                mAvailableEntities.push(entity);
-            }
-        }
+        EntityManager() : mFreeHead(NULL_INDEX), mLivingEntityCount(0) {}
 
         /**
          * @brief Creates a new entity
-         * @return Unique entity ID
-         * @throws std::runtime_error if no entities are available
+         * @return Generation-tagged entity handle
          */
         Entity createEntity() {
-            assert(mLivingEntityCount < MAX_ENTITIES && "Too many entities in existence.");
+            if (mFreeHead != NULL_INDEX) {
+                // Pop a recycled slot; its link already carries the new generation
+                Entity index = mFreeHead;
+                Entity link = mSlots[index];
+                mFreeHead = entityIndex(link);
+                mSlots[index] = makeEntity(index, entityGeneration(link));
+                ++mLivingEntityCount;
+                return mSlots[index];
+            }
+
+            assert(mSlots.size() < NULL_INDEX && "Too many entities in existence.");
 
-            // Take an ID from the front of the queue
-            Entity id = mAvailableEntities.front();
-            mAvailableEntities.pop();
+            // Issue a fresh slot and grow signature storage for it
+            Entity index = static_cast<Entity>(mSlots.size());
+            mSlots.push_back(makeEntity(index, 0));
+            mSignatures.emplaceBack();
             ++mLivingEntityCount;
+            return mSlots[index];
+        }
 
-            return id;
+        /**
+         * @brief Reserves slot and signature storage
+         * @param slotCount Number of entity slots to make room for
+         */
+        void reserve(size_t slotCount) {
+            mSlots.reserve(slotCount);
+            mSignatures.reserve(slotCount);
         }
 
         /**
-         * @brief Destroys an entity and recycles its ID
-         * @param entity Entity to destroy
+         * @brief Destroys an entity and recycles its slot
+         * @param entity Entity to destroy (must be alive)
          */
         void destroyEntity(Entity entity) {
-            assert(entity < MAX_ENTITIES && "Entity out of range.");
+            assert(isAlive(entity) && "Destroying a dead or stale entity.");
+
+            Entity index = entityIndex(entity);
 
             // Invalidate the destroyed entity's signature
-            mSignatures[entity].reset();
+            mSignatures[index].reset();
 
-            // Put the destroyed ID at the back of the queue
-            mAvailableEntities.push(entity);
+            // Bump the generation and push the slot onto the free list
+            mSlots[index] = makeEntity(mFreeHead, entityGeneration(entity) + 1);
+            mFreeHead = index;
             --mLivingEntityCount;
         }
 
+        /**
+         * @brief Checks whether a handle refers to a living entity
+         * @param entity Handle to check
+         * @return false for destroyed, recycled or never-issued handles
+         */
+        bool isAlive(Entity entity) const {
+            Entity index = entityIndex(entity);
+            return index < mSlots.size() && mSlots[index] == entity;
+        }
+
         /**
          * @brief Sets the signature for an entity
          * @param entity Entity to modify
          * @param signature New signature to assign
          */
         void setSignature(Entity entity, const Signature& signature) {
-            assert(entity < MAX_ENTITIES && "Entity out of range.");
-            mSignatures[entity] = signature;
+            assert(isAlive(entity) && "Entity out of range.");
+            mSignatures[entityIndex(entity)] = signature;
         }
 
         /**
@@ -83,9 +127,9 @@ namespace ecs {
          * @param entity Entity to query
          * @return Current signature of the entity
          */
-        Signature getSignature(Entity entity) const {
-            assert(entity < MAX_ENTITIES && "Entity out of range.");
-            return mSignatures[entity];
+        const Signature& getSignature(Entity entity) const {
+            assert(isAlive(entity) && "Entity out of range.");
+            return mSignatures[entityIndex(entity)];
         }
 
         /**
@@ -95,6 +139,108 @@ namespace ecs {
         size_t getLivingEntityCount() const {
             return mLivingEntityCount;
         }
+
+        /**
+         * @brief Gets the number of entity slots issued so far (living or free)
+         * @return One past the highest slot index in use
+         */
+        size_t getEntitySlotCount() const {
+            return mSlots.size();
+        }
+
+        /**
+         * @brief Writes slots, signatures and the free list to a snapshot
+         */
+        void saveSnapshot(WorldSnapshot& snapshot) const {
+            snapshot.writeValue(mFreeHead);
+            snapshot.writeValue(mLivingEntityCount);
+            snapshot.writeValue(mSlots.size());
+            snapshot.write(mSlots.data(), mSlots.size() * sizeof(Entity));
+            snapshot.writeChunked(mSignatures);
+        }
+
+        /**
+         * @brief Replaces all entities with those saved by saveSnapshot()
+         *
+         * Slots issued after the snapshot are dropped, so creating entities
+         * again hands out the same handles as the first time.
+         *
+         * @param reader Reader positioned at the entity data
+         */
+        void restoreSnapshot(SnapshotReader& reader) {
+            mFreeHead = reader.readValue<Entity>();
+            mLivingEntityCount = reader.readValue<size_t>();
+            mSlots.resize(reader.readValue<size_t>());
+            reader.read(mSlots.data(), mSlots.size() * sizeof(Entity));
+            reader.readChunked(mSignatures);
+        }
+
+        /**
+         * @brief Replaces all entities with a saved slot table
+         *
+         * Signatures are cleared; the caller sets them afterwards. Used to
+         * load world files.
+         *
+         * @param slots Handle or free-list link per slot, as kept by this class
+         * @param freeHead First free slot index
+         * @param livingCount Number of living entities among the slots
+         */
+        void assignSlots(std::span<const Entity> slots, Entity freeHead, size_t livingCount) {
+            mSlots.assign(slots.begin(), slots.end());
+            mFreeHead = freeHead;
+            mLivingEntityCount = livingCount;
+            mSignatures.resizeForOverwrite(slots.size());
+            for (size_t index = 0; index < slots.size(); ++index) {
+                mSignatures[index].reset();
+            }
+        }
+
+        /**
+         * @brief Gets the raw slot table (handles of living entities, links of free slots)
+         */
+        std::span<const Entity> getSlots() const {
+            return mSlots;
+        }
+
+        /**
+         * @brief Gets the head of the free-slot list
+         */
+        Entity getFreeHead() const {
+            return mFreeHead;
+        }
+
+        /**
+         * @brief Calls a function for every living entity, in slot order
+         * @param func Callable taking an Entity
+         */
+        template<typename Func>
+        void forEachEntity(Func&& func) const {
+            for (Entity index = 0; index < mSlots.size(); ++index) {
+                if (entityIndex(mSlots[index]) == index) {
+                    func(mSlots[index]);
+                }
+            }
+        }
+
+        /**
+         * @brief Calls a function for every entity whose signature contains the given bits
+         *
+         * Scans the packed signature array with Signature::containsAll(), one
+         * SIMD test per slot. Entities without any component are skipped, as
+         * are free slots, whose signatures are cleared on destruction.
+         *
+         * @param required Bits an entity must have
+         * @param func Callable taking an Entity, in slot order
+         */
+        template<typename Func>
+        void forEachMatching(const Signature& required, Func&& func) const {
+            for (Entity index = 0; index < mSlots.size(); ++index) {
+                const Signature& signature = mSignatures[index];
+                if (signature.containsAll(required) && signature.any()) {
+                    func(mSlots[index]);
+                }
+            }
+        }
     };
 
 } // namespace ecs
@@ -1,35 +1,396 @@
 #pragma once
 
-#include <unordered_map>
-#include <vector>
+#include "ECSTypes.h"
+#include "ExecutionOrder.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
 #include <memory>
-#include <typeindex>
 #include <mutex>
-#include <functional>
-#include <any>
+#include <span>
+#include <utility>
+#include <vector>
 
 namespace ecs {
 
+    /// Identifies an event type; dense, starting at 0
+    using EventType = uint32_t;
+
+    /// Maximum number of event types, across all buses
+    static constexpr size_t MAX_EVENT_TYPES = 256;
+
+    /// Emission lanes per event type; threads beyond MAX_EVENT_THREADS - 1 share the last one
+    static constexpr size_t MAX_EVENT_THREADS = 64;
+
+    /// Lane shared, under a lock, by the threads that found every other lane taken
+    static constexpr uint32_t OVERFLOW_EVENT_LANE = MAX_EVENT_THREADS - 1;
+
+    namespace detail {
+        inline std::atomic<EventType> nextEventType{ 0 };
+
+        /**
+         * @brief Hands out emission lanes to threads, reusing those of exited threads
+         *
+         * Once every private lane is taken, further threads get
+         * OVERFLOW_EVENT_LANE, which is never marked as used.
+         */
+        class EventLaneAllocator {
+            std::mutex mMutex;
+            uint64_t mUsed = 0;
+
+        public:
+            uint32_t acquire() {
+                std::lock_guard<std::mutex> lock(mMutex);
+                const uint32_t lane = static_cast<uint32_t>(std::countr_one(mUsed));
+                if (lane >= OVERFLOW_EVENT_LANE) {
+                    return OVERFLOW_EVENT_LANE;
+                }
+                mUsed |= uint64_t{ 1 } << lane;
+                return lane;
+            }
+
+            void release(uint32_t lane) {
+                if (lane == OVERFLOW_EVENT_LANE) {
+                    return;
+                }
+                std::lock_guard<std::mutex> lock(mMutex);
+                mUsed &= ~(uint64_t{ 1 } << lane);
+            }
+
+            static EventLaneAllocator& instance() {
+                // Never destroyed, so threads exiting during static destruction can release their lane
+                static EventLaneAllocator* allocator = new EventLaneAllocator();
+                return *allocator;
+            }
+        };
+
+        struct ThreadEventLane {
+            uint32_t lane = EventLaneAllocator::instance().acquire();
+            ~ThreadEventLane() { EventLaneAllocator::instance().release(lane); }
+        };
+
+        /// Lane of the calling thread, taken on its first emit
+        inline uint32_t threadEventLane() {
+            thread_local ThreadEventLane lane;
+            return lane.lane;
+        }
+
+        /// Handler dispatches in progress on the calling thread, across all buses
+        inline thread_local uint32_t eventDispatchDepth = 0;
+
+        struct EventDispatchScope {
+            EventDispatchScope() { ++eventDispatchDepth; }
+            ~EventDispatchScope() { --eventDispatchDepth; }
+        };
+    }
+
+    /**
+     * @brief Gets the type ID of an event type
+     *
+     * IDs are handed out the first time a type is used and cached in a
+     * per-type static afterwards, so every later call is a single load.
+     * They are shared by every EventBus and index its queue table directly.
+     *
+     * @tparam T Event type
+     * @return Event type ID
+     */
+    template<typename T>
+    EventType eventTypeId() {
+        static const EventType id = detail::nextEventType.fetch_add(1, std::memory_order_relaxed);
+        assert(id < MAX_EVENT_TYPES && "Too many event types.");
+        return id;
+    }
+
+    /**
+     * @brief Handle of an event handler, returned by EventBus::subscribe()
+     */
+    struct EventSubscription {
+        EventType type = 0;
+        uint32_t id = 0;    // 0 for no subscription
+
+        explicit operator bool() const { return id != 0; }
+    };
+
     /**
-     * @brief Thread-safe event bus for ECS communication
+     * @brief Event bus for ECS communication, emitted into without locks
      *
      * Provides a centralized mechanism for systems to communicate through events.
-     * Events are stored by type and can be emitted and consumed by systems.
+     * Each event type has its own contiguous std::vector<T> queue, found by
+     * eventTypeId<T>() without hashing, which is read back as a span.
+     *
+     * Events are double-buffered by frame. emit() writes to the frame being
+     * built and read() sees the frame before it, so every event emitted in
+     * frame N is readable by every system, in any order, throughout frame
+     * N + 1, and is recycled by the update() that ends N + 1. No consumer
+     * takes events away from another, and none has to clear them.
+     *
+     * emit() may be called from any number of threads at once: every thread
+     * appends to its own lane of the queue, with no lock and no shared
+     * write. Threads beyond the first MAX_EVENT_THREADS - 1 alive at once
+     * share one overflow lane behind a lock instead. Reads touch only the previous frame, so they may run alongside
+     * emits too. update() merges the lanes in a deterministic order, the
+     * ExecutionOrder they were emitted at: by emitting system, in schedule
+     * order (events emitted outside systems first), then by the system's
+     * parallelFor() jobs, in job order, then in emission order. Only events
+     * emitted at the same order from several threads, such as by threads
+     * outside the JobSystem, are ordered by thread, or by arrival within
+     * the overflow lane.
+     *
+     * Call update() once at the end of every frame, with no emit or read in
+     * flight. Every buffer keeps its capacity, so a steady-state frame does
+     * not allocate.
+     *
+     * Reactions that cannot wait a frame subscribe a handler instead: emit()
+     * calls the handlers of its type synchronously, on the emitting thread,
+     * before it returns. Each type keeps its handlers in a contiguous array
+     * of function pointer and context pairs, reached through the same
+     * type-indexed table as the queue, so a dispatch is one indirect call
+     * per handler. The event is still queued for read() as usual.
      */
     class EventBus {
+    public:
+        /**
+         * @brief Called for every emitted event, for serialization/replay
+         *
+         * Receives the event type ID, the event and its size in bytes. The
+         * hook runs when events are merged, on the syncing thread and in the
+         * merged order; the event pointer is only valid during the call.
+         */
+        using LoggingHook = std::function<void(EventType type, const void* event, size_t size)>;
+
     private:
-        // Storage for events by type
-        std::unordered_map<std::type_index, std::vector<std::any>> mEvents;
+        /// Type-erased interface of a per-type queue, for operations on every queue
+        class IEventQueue {
+        public:
+            virtual ~IEventQueue() = default;
+            virtual void swapBuffers(const LoggingHook& hook) = 0;
+            virtual size_t size() const = 0;
+            virtual bool unsubscribe(uint32_t id) = 0;
+        };
+
+        template<typename T>
+        class EventQueue : public IEventQueue {
+            /// Consecutive events of one lane emitted at the same execution order
+            struct Run {
+                ExecutionOrder order;
+                uint32_t lane;
+                size_t begin;
+                size_t end;
+            };
+
+            /// One thread's emissions; a cache line of its own so emitting threads share nothing
+            struct alignas(CACHE_LINE_SIZE) Lane {
+                std::vector<T> pending;
+                std::vector<Run> runs;
+            };
+
+            /// Subscribed handler; a null invoke marks one unsubscribed during a dispatch
+            struct Handler {
+                void (*invoke)(void* context, const T& event);
+                void* context;
+                uint32_t id;
+            };
+
+            std::array<Lane, MAX_EVENT_THREADS> mLanes;
+            std::atomic<uint64_t> mActiveLanes{ 0 };
+
+            /// Serializes the threads sharing the overflow lane; recursive for handlers that emit again
+            std::recursive_mutex mOverflowMutex;
+            std::vector<Run> mMergeOrder;
+
+            std::vector<Handler> mHandlers;
+            bool mHasUnsubscribed = false;
+
+            /// Calls the handlers subscribed before the dispatch started, skipping ones unsubscribed since
+            void dispatch(const std::vector<T>& pending, size_t index) {
+                detail::EventDispatchScope scope;
+                // Handlers may subscribe, unsubscribe or emit T again: index both arrays afresh every call
+                const size_t count = mHandlers.size();
+                for (size_t handler = 0; handler < count; ++handler) {
+                    const Handler entry = mHandlers[handler];
+                    if (entry.invoke) {
+                        entry.invoke(entry.context, pending[index]);
+                    }
+                }
+            }
+
+            void removeUnsubscribed() {
+                std::erase_if(mHandlers, [](const Handler& handler) { return handler.invoke == nullptr; });
+                mHasUnsubscribed = false;
+            }
+
+            /// Appends an event to a lane the calling thread owns, or holds the lock of, and runs the handlers
+            template<typename... Args>
+            void emitToLane(uint32_t laneIndex, Args&&... args) {
+                const ExecutionOrder& order = detail::currentExecutionOrder;
+                Lane& lane = mLanes[laneIndex];
+                if (lane.pending.empty()) {
+                    mActiveLanes.fetch_or(uint64_t{ 1 } << laneIndex, std::memory_order_relaxed);
+                }
+                if (lane.runs.empty() || lane.runs.back().order != order) {
+                    lane.runs.push_back({ order, laneIndex, lane.pending.size(), 0 });
+                }
+                lane.pending.emplace_back(std::forward<Args>(args)...);
+                if (!mHandlers.empty()) {
+                    dispatch(lane.pending, lane.pending.size() - 1);
+                }
+            }
+
+        public:
+            /// Events of the previous frame, the ones read() sees
+            std::vector<T> events;
+
+            template<typename... Args>
+            void emit(Args&&... args) {
+                const uint32_t laneIndex = detail::threadEventLane();
+                if (laneIndex == OVERFLOW_EVENT_LANE) [[unlikely]] {
+                    // Held through the handlers too, as they get a reference into the shared lane
+                    std::lock_guard<std::recursive_mutex> lock(mOverflowMutex);
+                    emitToLane(laneIndex, std::forward<Args>(args)...);
+                    return;
+                }
+                emitToLane(laneIndex, std::forward<Args>(args)...);
+            }
+
+            void subscribe(void (*invoke)(void* context, const T& event), void* context, uint32_t id) {
+                mHandlers.push_back({ invoke, context, id });
+            }
+
+            bool unsubscribe(uint32_t id) override {
+                auto handler = std::find_if(mHandlers.begin(), mHandlers.end(),
+                    [id](const Handler& entry) { return entry.id == id && entry.invoke; });
+                if (handler == mHandlers.end()) {
+                    return false;
+                }
+                // Dispatches in progress walk the array by index, so only tombstone the entry under them
+                handler->invoke = nullptr;
+                mHasUnsubscribed = true;
+                if (detail::eventDispatchDepth == 0) {
+                    removeUnsubscribed();
+                }
+                return true;
+            }
+
+            size_t subscriberCount() const {
+                return static_cast<size_t>(std::count_if(mHandlers.begin(), mHandlers.end(),
+                    [](const Handler& handler) { return handler.invoke != nullptr; }));
+            }
+
+            /// Replaces the readable events by the lanes' events, ordered by execution order, then lane, then emission
+            void swapBuffers(const LoggingHook& hook) override {
+                if (mHasUnsubscribed) {
+                    removeUnsubscribed();
+                }
+                events.clear();
+                const uint64_t active = mActiveLanes.exchange(0, std::memory_order_acquire);
+                if (active == 0) {
+                    return;
+                }
+
+                // Sort whole runs rather than events: a system rarely switches threads mid-frame
+                mMergeOrder.clear();
+                size_t pendingCount = 0;
+                for (uint64_t bits = active; bits != 0; bits &= bits - 1) {
+                    Lane& lane = mLanes[std::countr_zero(bits)];
+                    for (size_t run = 0; run < lane.runs.size(); ++run) {
+                        lane.runs[run].end = run + 1 < lane.runs.size() ? lane.runs[run + 1].begin : lane.pending.size();
+                        mMergeOrder.push_back(lane.runs[run]);
+                    }
+                    pendingCount += lane.pending.size();
+                }
+                // A total order, so std::sort needs no scratch buffer unlike std::stable_sort
+                std::sort(mMergeOrder.begin(), mMergeOrder.end(), [](const Run& a, const Run& b) {
+                    return a.order != b.order ? a.order < b.order
+                        : a.lane != b.lane ? a.lane < b.lane : a.begin < b.begin;
+                });
+
+                events.reserve(pendingCount);
+                for (const Run& run : mMergeOrder) {
+                    std::vector<T>& pending = mLanes[run.lane].pending;
+                    std::move(pending.begin() + static_cast<std::ptrdiff_t>(run.begin),
+                        pending.begin() + static_cast<std::ptrdiff_t>(run.end), std::back_inserter(events));
+                }
+                for (uint64_t bits = active; bits != 0; bits &= bits - 1) {
+                    Lane& lane = mLanes[std::countr_zero(bits)];
+                    lane.pending.clear();
+                    lane.runs.clear();
+                }
+
+                if (hook) {
+                    const EventType type = eventTypeId<T>();
+                    for (const T& event : events) {
+                        hook(type, &event, sizeof(T));
+                    }
+                }
+            }
+
+            size_t size() const override { return events.size(); }
+        };
+
+        // Queues indexed by event type ID; null for types never emitted on this bus
+        std::array<std::atomic<IEventQueue*>, MAX_EVENT_TYPES> mQueues{};
+
+        // One past the highest type ID with a queue, to bound loops over every queue
+        std::atomic<size_t> mQueueEnd{ 0 };
 
         // Optional logging hook for serialization/replay
-        std::function<void(const std::type_index&, const std::any&)> mLoggingHook;
+        LoggingHook mLoggingHook;
+
+        // Frames ended by update()
+        uint64_t mFrame = 0;
+
+        // Last subscription ID handed out; IDs are never reused, so stale handles stay harmless
+        std::atomic<uint32_t> mLastSubscription{ 0 };
+
+        template<typename T, auto Method, typename Owner>
+        static void invokeMember(void* context, const T& event) {
+            (static_cast<Owner*>(context)->*Method)(event);
+        }
 
-        // Thread safety
-        mutable std::mutex mMutex;
+        template<typename T>
+        EventQueue<T>* findQueue() const {
+            return static_cast<EventQueue<T>*>(mQueues[eventTypeId<T>()].load(std::memory_order_acquire));
+        }
+
+        /// Finds or creates the queue of T; threads racing to create it agree on one
+        template<typename T>
+        EventQueue<T>& getOrCreateQueue() {
+            const EventType type = eventTypeId<T>();
+            IEventQueue* queue = mQueues[type].load(std::memory_order_acquire);
+            if (!queue) {
+                auto created = std::make_unique<EventQueue<T>>();
+                if (mQueues[type].compare_exchange_strong(queue, created.get(), std::memory_order_acq_rel)) {
+                    queue = created.release();
+                    size_t end = mQueueEnd.load(std::memory_order_relaxed);
+                    while (end < type + 1 && !mQueueEnd.compare_exchange_weak(end, type + 1, std::memory_order_relaxed)) {
+                    }
+                }
+            }
+            return static_cast<EventQueue<T>&>(*queue);
+        }
+
+        template<typename Function>
+        void forEachQueue(Function&& function) const {
+            const size_t end = mQueueEnd.load(std::memory_order_acquire);
+            for (size_t type = 0; type < end; ++type) {
+                if (IEventQueue* queue = mQueues[type].load(std::memory_order_acquire)) {
+                    function(*queue);
+                }
+            }
+        }
 
     public:
         EventBus() = default;
-        ~EventBus() = default;
+
+        ~EventBus() {
+            forEachQueue([](IEventQueue& queue) { delete &queue; });
+        }
 
         // Non-copyable, non-movable for safety
         EventBus(const EventBus&) = delete;
@@ -38,143 +399,162 @@ namespace ecs {
         EventBus& operator=(EventBus&&) = delete;
 
         /**
-         * @brief Emit an event of type T
+         * @brief Emit an event of type T, constructed in place in the calling thread's lane
+         *
+         * Safe to call from any number of threads at once, and lock-free
+         * unless more than MAX_EVENT_THREADS - 1 threads emit. The
+         * event becomes readable after the next update(); the handlers of T
+         * are called with it before emit() returns.
+         *
          * @tparam T Event type
          * @tparam Args Constructor argument types
          * @param args Arguments to construct the event
          */
         template<typename T, typename... Args>
         void emit(Args&&... args) {
-            std::lock_guard<std::mutex> lock(mMutex);
-
-            auto typeIndex = std::type_index(typeid(T));
-            T event(std::forward<Args>(args)...);
-
-            // Call logging hook if set
-            if (mLoggingHook) {
-                mLoggingHook(typeIndex, std::make_any<T>(event));
-            }
-
-            mEvents[typeIndex].emplace_back(std::make_any<T>(std::move(event)));
+            getOrCreateQueue<T>().emit(std::forward<Args>(args)...);
         }
 
         /**
-         * @brief Read all events of type T
+         * @brief Subscribe a handler called by every emit() of T
+         *
+         * Handlers run in subscription order, on the emitting thread, so a
+         * handler of an event emitted by a system runs wherever the scheduler
+         * runs that system. Subscribing and unsubscribing must not race with
+         * emits of T on other threads; from inside a handler, on the
+         * dispatching thread, both are safe: a handler unsubscribed during a
+         * dispatch is not called again, even for the event being dispatched,
+         * and one subscribed during a dispatch is first called for the next
+         * event. clearAll() drops every subscription.
+         *
          * @tparam T Event type
-         * @return Vector of events of type T
+         * @param handler Function called with context and the event; the event is only valid during
+         *                the call, and only until the handler emits another T
+         * @param context Passed back to handler, typically the subscribing object
+         * @return Handle for unsubscribe()
          */
         template<typename T>
-        std::vector<T> read() {
-            std::lock_guard<std::mutex> lock(mMutex);
-
-            auto typeIndex = std::type_index(typeid(T));
-            std::vector<T> result;
-
-            auto it = mEvents.find(typeIndex);
-            if (it != mEvents.end()) {
-                result.reserve(it->second.size());
-
-                for (const auto& anyEvent : it->second) {
-                    try {
-                        result.push_back(std::any_cast<T>(anyEvent));
-                    } catch (const std::bad_any_cast& e) {
-                        // This should not happen if used correctly
-                        // Log error if logging is available
-                    }
-                }
-            }
-
-            return result;
+        EventSubscription subscribe(void (*handler)(void* context, const T& event), void* context) {
+            assert(handler && "Event handler must not be null.");
+            const uint32_t id = mLastSubscription.fetch_add(1, std::memory_order_relaxed) + 1;
+            getOrCreateQueue<T>().subscribe(handler, context, id);
+            return { eventTypeId<T>(), id };
         }
 
         /**
-         * @brief Read all events of type T and clear them
+         * @brief Subscribe a member function of owner, bound at compile time
+         *
+         * Usage: bus.subscribe<SceneTransition, &Scene::onSceneTransition>(*this);
+         * The call goes through a thunk generated for Method, with no
+         * std::function in between. owner must outlive the subscription.
+         *
          * @tparam T Event type
-         * @return Vector of events of type T
+         * @tparam Method Member function of Owner taking const T&
+         * @param owner Object Method is called on
+         * @return Handle for unsubscribe()
          */
-        template<typename T>
-        std::vector<T> readAndClear() {
-            std::lock_guard<std::mutex> lock(mMutex);
-
-            auto typeIndex = std::type_index(typeid(T));
-            std::vector<T> result;
-
-            auto it = mEvents.find(typeIndex);
-            if (it != mEvents.end()) {
-                result.reserve(it->second.size());
-
-                for (const auto& anyEvent : it->second) {
-                    try {
-                        result.push_back(std::any_cast<T>(anyEvent));
-                    } catch (const std::bad_any_cast& e) {
-                        // This should not happen if used correctly
-                    }
-                }
+        template<typename T, auto Method, typename Owner>
+        EventSubscription subscribe(Owner& owner) {
+            return subscribe<T>(&invokeMember<T, Method, Owner>, &owner);
+        }
 
-                // Clear the events after reading
-                it->second.clear();
+        /**
+         * @brief Unsubscribe a handler; safe from inside any handler on the dispatching thread
+         * @param subscription Handle returned by subscribe()
+         * @return true if the handler was subscribed until now
+         */
+        bool unsubscribe(EventSubscription subscription) {
+            if (!subscription || subscription.type >= MAX_EVENT_TYPES) {
+                return false;
             }
+            IEventQueue* queue = mQueues[subscription.type].load(std::memory_order_acquire);
+            return queue && queue->unsubscribe(subscription.id);
+        }
 
-            return result;
+        /**
+         * @brief Get the number of handlers subscribed to T
+         */
+        template<typename T>
+        size_t getSubscriberCount() const {
+            const EventQueue<T>* queue = findQueue<T>();
+            return queue ? queue->subscriberCount() : 0;
         }
 
         /**
-         * @brief Clear all events of type T
+         * @brief Read all events of type T emitted during the previous frame
+         *
+         * The span points into the queue itself: it stays valid until the
+         * next update() and must not be held across frames.
+         *
          * @tparam T Event type
+         * @return Events of type T, in merged order
          */
         template<typename T>
-        void clear() {
-            std::lock_guard<std::mutex> lock(mMutex);
+        std::span<const T> read() const {
+            const EventQueue<T>* queue = findQueue<T>();
+            return queue ? std::span<const T>(queue->events) : std::span<const T>();
+        }
 
-            auto typeIndex = std::type_index(typeid(T));
-            auto it = mEvents.find(typeIndex);
-            if (it != mEvents.end()) {
-                it->second.clear();
-            }
+        /**
+         * @brief Ends the frame: the events emitted during it become the readable ones
+         *
+         * Events readable until now are dropped, keeping their storage.
+         */
+        void update() {
+            forEachQueue([this](IEventQueue& queue) { queue.swapBuffers(mLoggingHook); });
+            ++mFrame;
         }
 
         /**
-         * @brief Clear all events
+         * @brief Gets the number of frames ended by update()
+         *
+         * This is also the frame being built: the events emitted now, and
+         * the ones the logging hook sees during update(), belong to it.
+         */
+        uint64_t getFrame() const { return mFrame; }
+
+        /**
+         * @brief Drop all events, readable and pending, and release every queue's storage
+         *
+         * Must not be called while events are being emitted or read.
          */
         void clearAll() {
-            std::lock_guard<std::mutex> lock(mMutex);
-            mEvents.clear();
+            forEachQueue([](IEventQueue& queue) { delete &queue; });
+            for (auto& queue : mQueues) {
+                queue.store(nullptr, std::memory_order_relaxed);
+            }
+            mQueueEnd.store(0, std::memory_order_release);
         }
 
         /**
          * @brief Set a logging hook for event serialization/replay
-         * @param hook Function to call when events are emitted
+         *
+         * Must not be called while events are being emitted or during update().
+         *
+         * @param hook Function to call for every event as update() makes it readable
          */
-        void setLoggingHook(std::function<void(const std::type_index&, const std::any&)> hook) {
-            std::lock_guard<std::mutex> lock(mMutex);
+        void setLoggingHook(LoggingHook hook) {
             mLoggingHook = std::move(hook);
         }
 
         /**
-         * @brief Get the number of events of type T
+         * @brief Get the number of readable events of type T
          * @tparam T Event type
          * @return Number of events
          */
         template<typename T>
         size_t getEventCount() const {
-            std::lock_guard<std::mutex> lock(mMutex);
-
-            auto typeIndex = std::type_index(typeid(T));
-            auto it = mEvents.find(typeIndex);
-            return (it != mEvents.end()) ? it->second.size() : 0;
+            const EventQueue<T>* queue = findQueue<T>();
+            return queue ? queue->events.size() : 0;
         }
 
         /**
-         * @brief Get total number of events across all types
+         * @brief Get total number of readable events across all types
          * @return Total event count
          */
         size_t getTotalEventCount() const {
-            std::lock_guard<std::mutex> lock(mMutex);
-
             size_t total = 0;
-            for (const auto& pair : mEvents) {
-                total += pair.second.size();
-            }
+            forEachQueue([&total](IEventQueue& queue) { total += queue.size(); });
             return total;
         }
     };
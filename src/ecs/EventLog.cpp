@@ -0,0 +1,237 @@
+#include "EventLog.h"
+#include <cstddef>
+
+namespace ecs {
+
+    namespace {
+        constexpr std::array<char, 4> EVENT_LOG_MAGIC = { 'E', 'C', 'S', 'E' };
+        constexpr std::uint32_t EVENT_LOG_BYTE_ORDER = 0x01020304;
+
+        void appendVarint(std::vector<std::byte>& bytes, std::uint64_t value) {
+            while (value >= 0x80) {
+                bytes.push_back(static_cast<std::byte>((value & 0x7f) | 0x80));
+                value >>= 7;
+            }
+            bytes.push_back(static_cast<std::byte>(value));
+        }
+
+        /// Reads a varint that must end before end; false if it does not
+        bool readVarintChecked(const std::byte*& cursor, const std::byte* end, std::uint64_t& value) {
+            value = 0;
+            for (unsigned shift = 0; shift < 64 && cursor < end; shift += 7) {
+                const auto byte = static_cast<std::uint8_t>(*cursor++);
+                value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+                if ((byte & 0x80) == 0) {
+                    return true;
+                }
+            }
+            return false;
+        }
+    }
+
+    EventRecorder::EventRecorder(EventBus& bus, const std::string& path, float timestep)
+        : mBus(bus), mPath(path), mFile(path, std::ios::binary | std::ios::trunc), mTimestep(timestep) {
+        if (!mFile) {
+            throw std::runtime_error("Cannot create event log " + path);
+        }
+    }
+
+    EventRecorder::~EventRecorder() {
+        try {
+            stop();
+        } catch (const std::exception&) {
+            // Destructors must not throw; stop() reports the failure to callers that ask
+        }
+    }
+
+    void EventRecorder::start() {
+        assert(!mRecording && "Event recording already started.");
+
+        EventLogHeader header{};
+        header.magic = EVENT_LOG_MAGIC;
+        header.version = EVENT_LOG_VERSION;
+        header.byteOrder = EVENT_LOG_BYTE_ORDER;
+        header.typeCount = static_cast<std::uint32_t>(mTypes.size());
+        header.timestep = mTimestep;
+        header.frameCount = 0;
+        mFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        for (const TypeEntry& type : mTypes) {
+            EventLogType record{};
+            type.name.copy(record.name.data(), EVENT_LOG_NAME_SIZE - 1);
+            record.size = type.size;
+            mFile.write(reinterpret_cast<const char*>(&record), sizeof(record));
+        }
+
+        mStartFrame = mBus.getFrame();
+        mEndFrame = mStartFrame;
+        mLastBlockFrame = 0;
+        mBlockOpen = false;
+        mStopping = false;
+        mWriter = std::thread([this] { writerLoop(); });
+        mBus.setLoggingHook([this](EventType type, const void* event, size_t size) { record(type, event, size); });
+        mRecording = true;
+    }
+
+    void EventRecorder::stop() {
+        if (!mRecording) {
+            return;
+        }
+        mBus.setLoggingHook(nullptr);
+        mRecording = false;
+        mEndFrame = mBus.getFrame();
+
+        if (mBlockOpen) {
+            closeBlock();
+            submit();
+        }
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mStopping = true;
+        }
+        mWake.notify_one();
+        mWriter.join();
+
+        const std::uint64_t frameCount = mEndFrame - mStartFrame;
+        mFile.seekp(static_cast<std::streamoff>(offsetof(EventLogHeader, frameCount)));
+        mFile.write(reinterpret_cast<const char*>(&frameCount), sizeof(frameCount));
+        mFile.flush();
+        if (!mFile) {
+            throw std::runtime_error("Cannot write event log " + mPath);
+        }
+    }
+
+    void EventRecorder::record(EventType type, const void* event, size_t size) {
+        const std::uint32_t index = type < mTypeIndices.size() ? mTypeIndices[type] : 0;
+        if (index == 0) {
+            return;
+        }
+
+        // The bus only moves to the next frame after a whole update(), so a new frame number closes the block
+        const std::uint64_t frame = mBus.getFrame() - mStartFrame;
+        if (mBlockOpen && frame != mStagedFrame) {
+            closeBlock();
+            submit();
+        }
+        if (!mBlockOpen) {
+            appendVarint(mStaging, frame - mLastBlockFrame);
+            mLastBlockFrame = frame;
+            mStagedFrame = frame;
+            mBlockOpen = true;
+        }
+
+        appendVarint(mStaging, index);
+        const auto* bytes = static_cast<const std::byte*>(event);
+        mStaging.insert(mStaging.end(), bytes, bytes + size);
+    }
+
+    void EventRecorder::closeBlock() {
+        appendVarint(mStaging, 0);
+        mBlockOpen = false;
+    }
+
+    void EventRecorder::submit() {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mQueued.insert(mQueued.end(), mStaging.begin(), mStaging.end());
+        }
+        mWake.notify_one();
+        mStaging.clear();
+    }
+
+    void EventRecorder::writerLoop() {
+        std::unique_lock<std::mutex> lock(mMutex);
+        while (true) {
+            mWake.wait(lock, [this] { return !mQueued.empty() || mStopping; });
+            if (mQueued.empty()) {
+                return;
+            }
+            mQueued.swap(mWriting);
+
+            lock.unlock();
+            mFile.write(reinterpret_cast<const char*>(mWriting.data()), static_cast<std::streamsize>(mWriting.size()));
+            mWriting.clear();
+            lock.lock();
+        }
+    }
+
+    EventReplay::EventReplay(const std::string& path) : mFile(std::make_unique<MappedFile>(path)) {
+        const std::byte* const data = mFile->data();
+        const size_t fileSize = mFile->size();
+
+        auto fail = [&path](const std::string& reason) {
+            throw std::runtime_error("Event log " + path + ": " + reason);
+        };
+
+        EventLogHeader header;
+        if (fileSize < sizeof(header)) {
+            fail("too small");
+        }
+        std::memcpy(&header, data, sizeof(header));
+        if (header.magic != EVENT_LOG_MAGIC) {
+            fail("not an event log");
+        }
+        if (header.byteOrder != EVENT_LOG_BYTE_ORDER) {
+            fail("written with another byte order");
+        }
+        if (header.version != EVENT_LOG_VERSION) {
+            fail("format version " + std::to_string(header.version) + ", expected " + std::to_string(EVENT_LOG_VERSION));
+        }
+        if (header.typeCount > (fileSize - sizeof(header)) / sizeof(EventLogType)) {
+            fail("type table out of bounds");
+        }
+        mTimestep = header.timestep;
+        mFrameCount = header.frameCount;
+
+        mTypes.reserve(header.typeCount);
+        for (size_t index = 0; index < header.typeCount; ++index) {
+            EventLogType record;
+            std::memcpy(&record, data + sizeof(header) + index * sizeof(EventLogType), sizeof(record));
+            record.name.back() = '\0';
+            mTypes.push_back({ record.name.data(), record.size });
+        }
+
+        // Check every block once, so forEach() can decode without bounds checks
+        const std::byte* cursor = data + sizeof(header) + header.typeCount * sizeof(EventLogType);
+        const std::byte* const end = data + fileSize;
+        while (cursor < end) {
+            std::uint64_t delta = 0;
+            if (!readVarintChecked(cursor, end, delta)) {
+                fail("truncated frame block");
+            }
+            if (!mBlocks.empty() && delta == 0) {
+                fail("frame blocks out of order");
+            }
+            const std::uint64_t frame = mBlocks.empty() ? delta : mBlocks.back().frame + delta;
+            if (frame >= mFrameCount || frame < delta) {
+                fail("frame " + std::to_string(frame) + " beyond the recorded " + std::to_string(mFrameCount));
+            }
+            mBlocks.push_back({ frame, static_cast<size_t>(cursor - data) });
+
+            std::uint64_t index = 0;
+            do {
+                if (!readVarintChecked(cursor, end, index) || index > mTypes.size()) {
+                    fail("bad event in frame " + std::to_string(frame));
+                }
+                if (index != 0) {
+                    const std::uint32_t size = mTypes[index - 1].size;
+                    if (size > static_cast<size_t>(end - cursor)) {
+                        fail("truncated event in frame " + std::to_string(frame));
+                    }
+                    cursor += size;
+                }
+            } while (index != 0);
+        }
+    }
+
+    std::uint64_t EventReplay::readVarint(const std::byte*& cursor) {
+        std::uint64_t value = 0;
+        for (unsigned shift = 0;; shift += 7) {
+            const auto byte = static_cast<std::uint8_t>(*cursor++);
+            value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+            if ((byte & 0x80) == 0) {
+                return value;
+            }
+        }
+    }
+
+} // namespace ecs
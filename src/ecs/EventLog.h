@@ -0,0 +1,316 @@
+#pragma once
+
+#include "EventBus.h"
+#include "WorldFile.h"
+#include <array>
+#include <cassert>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace ecs {
+
+    /*
+     * Event log layout (integers in the writer's byte order, checked with
+     * EventLogHeader::byteOrder):
+     *
+     *   EventLogHeader
+     *   EventLogType[typeCount]
+     *   one block per recorded frame that has events, in frame order:
+     *     varint frames since the previous block (since frame 0 for the first)
+     *     per event: varint type index + 1, then the event's raw bytes
+     *     0
+     *
+     * Varints are LEB128. Frames count from the start of the recording.
+     * Type indices refer to the type table, which names every type, so
+     * runtime event type IDs may differ between recording and replay.
+     */
+
+    /// Format version, raised on every incompatible layout change
+    static constexpr std::uint32_t EVENT_LOG_VERSION = 1;
+
+    /// Longest event type name an event log can store, including the terminator
+    static constexpr size_t EVENT_LOG_NAME_SIZE = 48;
+
+    /**
+     * @brief Fixed-size header at the start of an event log
+     */
+    struct EventLogHeader {
+        std::array<char, 4> magic;
+        std::uint32_t version;
+        std::uint32_t byteOrder;
+        std::uint32_t typeCount;
+        float timestep;
+        std::uint32_t reserved;
+        std::uint64_t frameCount;
+    };
+
+    /**
+     * @brief Description of one recorded event type
+     */
+    struct EventLogType {
+        std::array<char, EVENT_LOG_NAME_SIZE> name;
+        std::uint32_t size;
+        std::uint32_t reserved;
+    };
+
+    static_assert(std::is_trivially_copyable_v<EventLogHeader> && std::is_trivially_copyable_v<EventLogType>,
+        "Event log records are written as raw bytes.");
+
+    /**
+     * @brief Streams the events of an EventBus into an event log file
+     *
+     * Installs itself as the bus's logging hook, so it sees every event
+     * once, in the bus's deterministic merge order, during EventBus::update().
+     * The hook only appends the event's bytes to a staging buffer; each
+     * finished frame is handed to a background thread that writes it, so
+     * recording costs the frame a copy, not a file write. All buffers keep
+     * their capacity, so steady-state recording does not allocate.
+     *
+     * Only the types added with addType() are recorded. They must be
+     * trivially copyable, and are stored as raw bytes: pointers inside an
+     * event are recorded as they are and mean nothing on replay.
+     */
+    class EventRecorder {
+    private:
+        struct TypeEntry {
+            std::string name;
+            std::uint32_t size;
+        };
+
+        EventBus& mBus;
+        std::string mPath;
+        std::ofstream mFile;
+        float mTimestep;
+
+        std::vector<TypeEntry> mTypes;
+        // Type table index + 1, indexed by event type ID; 0 for types not recorded
+        std::vector<std::uint32_t> mTypeIndices;
+
+        bool mRecording = false;
+        std::uint64_t mStartFrame = 0;
+        std::uint64_t mEndFrame = 0;
+        std::uint64_t mStagedFrame = 0;
+        std::uint64_t mLastBlockFrame = 0;
+        bool mBlockOpen = false;
+
+        // Frames being built by the hook, then queued for the writer, then written
+        std::vector<std::byte> mStaging;
+        std::vector<std::byte> mQueued;
+        std::vector<std::byte> mWriting;
+
+        std::mutex mMutex;
+        std::condition_variable mWake;
+        bool mStopping = false;
+        std::thread mWriter;
+
+        void record(EventType type, const void* event, size_t size);
+        void closeBlock();
+        void submit();
+        void writerLoop();
+
+    public:
+        /**
+         * @brief Creates the log file; recording begins with start()
+         * @param bus Bus whose events are recorded
+         * @param path File to create or replace
+         * @param timestep Fixed frame time a replay should run at, in seconds
+         * @throws std::runtime_error if the file cannot be created
+         */
+        EventRecorder(EventBus& bus, const std::string& path, float timestep);
+
+        /**
+         * @brief Stops recording; write errors are dropped, call stop() to see them
+         */
+        ~EventRecorder();
+
+        EventRecorder(const EventRecorder&) = delete;
+        EventRecorder& operator=(const EventRecorder&) = delete;
+
+        /**
+         * @brief Records events of type T under a stable name
+         *
+         * Must be called before start().
+         *
+         * @tparam T Trivially copyable event type
+         * @param name Name the replay looks the type up by
+         */
+        template<typename T>
+        void addType(const std::string& name) {
+            static_assert(std::is_trivially_copyable_v<T>, "Recorded events are copied as raw bytes.");
+            assert(!mRecording && "Event types must be added before recording starts.");
+            assert(name.size() < EVENT_LOG_NAME_SIZE && "Event type name too long.");
+
+            const EventType type = eventTypeId<T>();
+            if (type >= mTypeIndices.size()) {
+                mTypeIndices.resize(type + 1, 0);
+            }
+            if (mTypeIndices[type] == 0) {
+                mTypes.push_back({ name, static_cast<std::uint32_t>(sizeof(T)) });
+                mTypeIndices[type] = static_cast<std::uint32_t>(mTypes.size());
+            }
+        }
+
+        /**
+         * @brief Writes the type table and starts recording from the current frame
+         *
+         * Replaces the bus's logging hook until stop().
+         */
+        void start();
+
+        /**
+         * @brief Stops recording and finishes the file
+         *
+         * Every frame ended since start() is in the log; events of the frame
+         * in progress are not.
+         *
+         * @throws std::runtime_error if writing the file failed
+         */
+        void stop();
+
+        bool isRecording() const { return mRecording; }
+
+        /**
+         * @brief Gets the number of frames ended between start() and stop() (or now, while recording)
+         */
+        std::uint64_t getRecordedFrameCount() const { return (mRecording ? mBus.getFrame() : mEndFrame) - mStartFrame; }
+    };
+
+    /**
+     * @brief Plays an event log back, one frame at a time
+     *
+     * The log is memory-mapped and checked once when opened; events are
+     * then decoded straight from the mapping. A replay driver calls
+     * forEach() for the event types it feeds back, then nextFrame(), once
+     * per frame at getTimestep(), for getFrameCount() frames.
+     */
+    class EventReplay {
+    private:
+        struct RecordedType {
+            std::string name;
+            std::uint32_t size;
+        };
+
+        /// A frame with events: where its first event starts
+        struct Block {
+            std::uint64_t frame;
+            size_t begin;
+        };
+
+        std::unique_ptr<MappedFile> mFile;
+        float mTimestep = 0.0f;
+        std::uint64_t mFrameCount = 0;
+        std::vector<RecordedType> mTypes;
+        std::vector<Block> mBlocks;
+
+        // Type table index + 1, indexed by event type ID; 0 for types not replayed
+        std::vector<std::uint32_t> mTypeIndices;
+
+        std::uint64_t mFrame = 0;
+        size_t mNextBlock = 0;
+
+        static std::uint64_t readVarint(const std::byte*& cursor);
+
+    public:
+        /**
+         * @brief Maps and checks an event log
+         * @param path File written by EventRecorder
+         * @throws std::runtime_error if the file cannot be read or is not a valid event log
+         */
+        explicit EventReplay(const std::string& path);
+
+        EventReplay(const EventReplay&) = delete;
+        EventReplay& operator=(const EventReplay&) = delete;
+
+        /**
+         * @brief Replays the recorded events named name as events of type T
+         *
+         * Types the log does not contain simply have no events.
+         *
+         * @tparam T Trivially copyable event type
+         * @param name Name the type was recorded under
+         * @throws std::runtime_error if the recorded type has another size than T
+         */
+        template<typename T>
+        void addType(const std::string& name) {
+            static_assert(std::is_trivially_copyable_v<T>, "Recorded events are copied as raw bytes.");
+            for (size_t index = 0; index < mTypes.size(); ++index) {
+                if (mTypes[index].name != name) {
+                    continue;
+                }
+                if (mTypes[index].size != sizeof(T)) {
+                    throw std::runtime_error("Event type " + name + " was recorded with " + std::to_string(mTypes[index].size)
+                        + " bytes, not " + std::to_string(sizeof(T)));
+                }
+                const EventType type = eventTypeId<T>();
+                if (type >= mTypeIndices.size()) {
+                    mTypeIndices.resize(type + 1, 0);
+                }
+                mTypeIndices[type] = static_cast<std::uint32_t>(index + 1);
+                return;
+            }
+        }
+
+        /**
+         * @brief Calls function with every event of type T of the current frame, in recorded order
+         * @tparam T Event type added with addType()
+         * @param function Callable taking const T&
+         */
+        template<typename T, typename Function>
+        void forEach(Function&& function) const {
+            const EventType type = eventTypeId<T>();
+            const std::uint32_t wanted = type < mTypeIndices.size() ? mTypeIndices[type] : 0;
+            if (wanted == 0 || mNextBlock >= mBlocks.size() || mBlocks[mNextBlock].frame != mFrame) {
+                return;
+            }
+
+            const std::byte* cursor = mFile->data() + mBlocks[mNextBlock].begin;
+            for (std::uint64_t index = readVarint(cursor); index != 0; index = readVarint(cursor)) {
+                const std::uint32_t size = mTypes[index - 1].size;
+                if (index == wanted) {
+                    alignas(T) std::byte storage[sizeof(T)];
+                    std::memcpy(storage, cursor, sizeof(T));
+                    function(*std::launder(reinterpret_cast<const T*>(storage)));
+                }
+                cursor += size;
+            }
+        }
+
+        /**
+         * @brief Moves on to the next recorded frame
+         */
+        void nextFrame() {
+            if (mNextBlock < mBlocks.size() && mBlocks[mNextBlock].frame == mFrame) {
+                ++mNextBlock;
+            }
+            ++mFrame;
+        }
+
+        /**
+         * @brief Goes back to the first recorded frame, to replay the session again
+         */
+        void rewind() {
+            mFrame = 0;
+            mNextBlock = 0;
+        }
+
+        /// Frame the next forEach() reads, counted from the start of the recording
+        std::uint64_t getFrame() const { return mFrame; }
+        std::uint64_t getFrameCount() const { return mFrameCount; }
+        bool isFinished() const { return mFrame >= mFrameCount; }
+
+        /// Fixed frame time the session was recorded for, in seconds
+        float getTimestep() const { return mTimestep; }
+    };
+
+} // namespace ecs
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <compare>
+#include <cstdint>
+
+namespace ecs {
+
+    /**
+     * @brief Position of the running code in a frame's schedule
+     *
+     * Work that threads record side by side, such as events and entity
+     * commands, is ordered by this key, so the result does not depend on
+     * which thread ran what. Keys compare member by member:
+     * - source: 0 outside systems, system index + 1 inside a system
+     * - batch: advances around every JobSystem::parallelFor() the source
+     *   runs, so work before, inside and after a loop keeps that order
+     * - grain: 0 on the thread running the source, job index + 1 inside a
+     *   parallelFor() job
+     *
+     * A parallelFor() nested inside a job numbers its jobs like a loop of
+     * the source itself, so the jobs of sibling nested loops tie.
+     */
+    struct ExecutionOrder {
+        std::uint32_t source = 0;
+        std::uint32_t batch = 0;
+        std::uint32_t grain = 0;
+
+        friend bool operator==(const ExecutionOrder&, const ExecutionOrder&) = default;
+        friend auto operator<=>(const ExecutionOrder&, const ExecutionOrder&) = default;
+    };
+
+    namespace detail {
+        /// Execution order of the calling thread
+        inline thread_local ExecutionOrder currentExecutionOrder;
+    }
+
+    /**
+     * @brief Runs the calling thread at a given execution order while it lives
+     *
+     * JobSystem opens one around every job, with the order captured when
+     * the job was submitted.
+     */
+    class ExecutionOrderScope {
+        ExecutionOrder mPrevious;
+    public:
+        explicit ExecutionOrderScope(const ExecutionOrder& order) : mPrevious(detail::currentExecutionOrder) {
+            detail::currentExecutionOrder = order;
+        }
+        ~ExecutionOrderScope() { detail::currentExecutionOrder = mPrevious; }
+
+        ExecutionOrderScope(const ExecutionOrderScope&) = delete;
+        ExecutionOrderScope& operator=(const ExecutionOrderScope&) = delete;
+    };
+
+    /**
+     * @brief Marks the work the calling thread does while it lives as coming from one system
+     *
+     * SystemManager opens one around every system update, so events and
+     * commands of systems that ran on different threads are ordered by
+     * system, and jobs the system spawns inherit its source.
+     */
+    class EventSourceScope : public ExecutionOrderScope {
+    public:
+        explicit EventSourceScope(std::uint32_t source) : ExecutionOrderScope(ExecutionOrder{ source, 0, 0 }) {}
+    };
+
+} // namespace ecs
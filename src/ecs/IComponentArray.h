@@ -1,14 +1,20 @@
 #pragma once
 
 #include "ECSTypes.h"
+#include <cstddef>
+#include <span>
 
 namespace ecs {
 
+    class WorldSnapshot;
+    class SnapshotReader;
+
     /**
      * @brief Abstract interface for component arrays
      *
      * This interface allows the ComponentManager to notify all component arrays
-     * when an entity is destroyed, so they can clean up their data accordingly.
+     * when an entity is destroyed, so they can clean up their data accordingly,
+     * and to save, restore and load them without knowing their component type.
      */
     class IComponentArray {
     public:
@@ -19,6 +25,54 @@ namespace ecs {
          * @param entity The entity that was destroyed
          */
         virtual void entityDestroyed(Entity entity) = 0;
+
+        /**
+         * @brief Removes every component
+         */
+        virtual void clear() = 0;
+
+        /**
+         * @brief Checks whether the array's contents can be copied into a snapshot
+         * @return true if the component type is trivially copyable or the array is empty
+         */
+        virtual bool canSnapshot() const = 0;
+
+        /**
+         * @brief Writes the owning entities and components to a snapshot
+         */
+        virtual void saveSnapshot(WorldSnapshot& snapshot) const = 0;
+
+        /**
+         * @brief Replaces the contents with those saved by saveSnapshot()
+         * @param reader Reader positioned at this array's data
+         * @param tick Change stamp given to every restored component
+         */
+        virtual void restoreSnapshot(SnapshotReader& reader, ChangeTick tick) = 0;
+
+        /**
+         * @brief Gets the entities owning a component, in storage order
+         */
+        virtual std::span<const Entity> getEntities() const = 0;
+
+        /**
+         * @brief Gets the components of one storage chunk
+         * @param chunkIndex Chunk to access (see ChunkedArray::CHUNK_SIZE)
+         * @return Contiguous components, parallel to getEntities()
+         */
+        virtual const void* getChunkData(size_t chunkIndex) const = 0;
+
+        /**
+         * @brief Replaces the contents with components laid out in external chunks
+         *
+         * Used to load world files: the chunks are used in place, not copied,
+         * and must outlive the array. Only valid for trivially copyable types.
+         *
+         * @param entities Owner of each component
+         * @param firstChunk First chunk of components, in ChunkedArray layout
+         * @param chunkStride Bytes from one chunk to the next
+         * @param tick Change stamp given to every component
+         */
+        virtual void adoptChunks(std::span<const Entity> entities, std::byte* firstChunk, size_t chunkStride, ChangeTick tick) = 0;
     };
 
 } // namespace ecs
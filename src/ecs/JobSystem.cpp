@@ -0,0 +1,130 @@
+#include "JobSystem.h"
+
+namespace ecs {
+
+    namespace {
+        /// Pool the current thread works for, and the index of its queue there
+        thread_local const JobSystem* tOwner = nullptr;
+        thread_local size_t tQueueIndex = 0;
+    }
+
+    JobSystem::JobSystem(size_t workerCount) {
+        mQueues.reserve(workerCount + 1);
+        for (size_t i = 0; i < workerCount + 1; ++i) {
+            mQueues.push_back(std::make_unique<WorkQueue>());
+        }
+
+        mWorkers.reserve(workerCount);
+        for (size_t i = 0; i < workerCount; ++i) {
+            mWorkers.emplace_back([this, i] { workerLoop(i + 1); });
+        }
+    }
+
+    JobSystem::~JobSystem() {
+        {
+            std::lock_guard<std::mutex> lock(mSleepMutex);
+            mStopping.store(true);
+        }
+        mWakeCondition.notify_all();
+
+        for (auto& worker : mWorkers) {
+            worker.join();
+        }
+    }
+
+    size_t JobSystem::getDefaultWorkerCount() {
+        const unsigned hardwareThreads = std::thread::hardware_concurrency();
+        return hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+    }
+
+    size_t JobSystem::currentQueueIndex() const {
+        return tOwner == this ? tQueueIndex : 0;
+    }
+
+    void JobSystem::submit(WaitGroup& group, Job job, const ExecutionOrder& order) {
+        group.mPending.fetch_add(1, std::memory_order_relaxed);
+
+        WorkQueue& queue = *mQueues[currentQueueIndex()];
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.tasks.push_back({ std::move(job), &group, order });
+        }
+        mQueuedCount.fetch_add(1, std::memory_order_release);
+
+        // Taking the sleep mutex orders this push before a sleeping worker's predicate check
+        {
+            std::lock_guard<std::mutex> lock(mSleepMutex);
+        }
+        mWakeCondition.notify_one();
+    }
+
+    bool JobSystem::popTask(size_t queueIndex, Task& task) {
+        WorkQueue& queue = *mQueues[queueIndex];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) {
+            return false;
+        }
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+        return true;
+    }
+
+    bool JobSystem::stealTask(size_t thiefIndex, Task& task) {
+        const size_t queueCount = mQueues.size();
+        for (size_t offset = 1; offset < queueCount; ++offset) {
+            WorkQueue& queue = *mQueues[(thiefIndex + offset) % queueCount];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (!queue.tasks.empty()) {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool JobSystem::runOneTask(size_t queueIndex) {
+        Task task;
+        if (!popTask(queueIndex, task) && !stealTask(queueIndex, task)) {
+            return false;
+        }
+        mQueuedCount.fetch_sub(1, std::memory_order_relaxed);
+
+        {
+            ExecutionOrderScope scope(task.order);
+            task.job();
+        }
+        task.group->mPending.fetch_sub(1, std::memory_order_acq_rel);
+        return true;
+    }
+
+    void JobSystem::wait(WaitGroup& group) {
+        const size_t queueIndex = currentQueueIndex();
+        while (!group.isDone()) {
+            if (!runOneTask(queueIndex)) {
+                // Remaining jobs are running on other threads
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void JobSystem::workerLoop(size_t queueIndex) {
+        tOwner = this;
+        tQueueIndex = queueIndex;
+
+        while (true) {
+            if (runOneTask(queueIndex)) {
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(mSleepMutex);
+            mWakeCondition.wait(lock, [this] {
+                return mStopping.load() || mQueuedCount.load(std::memory_order_acquire) > 0;
+            });
+            if (mStopping.load()) {
+                return;
+            }
+        }
+    }
+
+} // namespace ecs
@@ -0,0 +1,171 @@
+#pragma once
+
+#include "ExecutionOrder.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace ecs {
+
+    /**
+     * @brief Work-stealing thread pool shared by the ECS schedulers
+     *
+     * Every worker owns a queue. Workers push and pop their own jobs at the
+     * back (most recently spawned first, which keeps data hot) and steal
+     * from the front of other queues when theirs runs dry. Threads that are
+     * not workers submit to a shared injection queue.
+     *
+     * Threads that wait on a WaitGroup run queued jobs while they wait, so a
+     * pool with zero workers still works: everything runs on the waiting
+     * thread.
+     *
+     * Jobs run at the ExecutionOrder of the thread that submitted them, so
+     * events and commands they record are ordered as if their system had
+     * recorded them itself; parallelFor() jobs are also told apart by index.
+     *
+     * Jobs must not throw.
+     */
+    class JobSystem {
+    public:
+        using Job = std::function<void()>;
+
+        /**
+         * @brief Tracks completion of a set of submitted jobs
+         */
+        class WaitGroup {
+        private:
+            friend class JobSystem;
+            std::atomic<size_t> mPending{ 0 };
+
+        public:
+            /**
+             * @brief Checks whether every job of the group has finished
+             */
+            bool isDone() const {
+                return mPending.load(std::memory_order_acquire) == 0;
+            }
+        };
+
+    private:
+        struct Task {
+            Job job;
+            WaitGroup* group;
+            ExecutionOrder order;
+        };
+
+        struct WorkQueue {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        /// Queue 0 receives jobs from non-worker threads; queue i + 1 belongs to worker i
+        std::vector<std::unique_ptr<WorkQueue>> mQueues;
+
+        std::vector<std::thread> mWorkers;
+
+        /// Jobs pushed but not yet taken, used to put idle workers to sleep
+        std::atomic<size_t> mQueuedCount{ 0 };
+
+        std::atomic<bool> mStopping{ false };
+        std::mutex mSleepMutex;
+        std::condition_variable mWakeCondition;
+
+        size_t currentQueueIndex() const;
+        bool popTask(size_t queueIndex, Task& task);
+        bool stealTask(size_t thiefIndex, Task& task);
+        bool runOneTask(size_t queueIndex);
+        void workerLoop(size_t queueIndex);
+        void submit(WaitGroup& group, Job job, const ExecutionOrder& order);
+
+    public:
+        /**
+         * @brief Starts the worker threads
+         * @param workerCount Number of background threads (the waiting thread also runs jobs)
+         */
+        explicit JobSystem(size_t workerCount = getDefaultWorkerCount());
+
+        /**
+         * @brief Stops and joins the workers (queued jobs are discarded)
+         */
+        ~JobSystem();
+
+        JobSystem(const JobSystem&) = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+
+        /**
+         * @brief Queues a job, to run at the calling thread's execution order
+         * @param group Group that is waited on for completion
+         * @param job Work to run on any thread of the pool
+         */
+        void submit(WaitGroup& group, Job job) {
+            submit(group, std::move(job), detail::currentExecutionOrder);
+        }
+
+        /**
+         * @brief Runs queued jobs until every job of a group has finished
+         * @param group Group to wait for
+         */
+        void wait(WaitGroup& group);
+
+        /**
+         * @brief Splits an index range into jobs and waits for all of them
+         *
+         * The calling thread takes part in the work. Ranges never exceed the
+         * grain size, and a range that fits in one grain runs inline. Range
+         * i runs at grain i + 1 of a new batch of the caller's execution
+         * order, and the caller continues in the batch after it.
+         *
+         * @param count Number of indices, processed as [0, count)
+         * @param grainSize Maximum indices per job (at least 1)
+         * @param body Callable taking (size_t begin, size_t end)
+         */
+        template<typename Body>
+        void parallelFor(size_t count, size_t grainSize, const Body& body) {
+            grainSize = grainSize > 0 ? grainSize : 1;
+            ExecutionOrder& callerOrder = detail::currentExecutionOrder;
+            ExecutionOrder order{ callerOrder.source, callerOrder.batch + 1, 1 };
+            callerOrder.batch += 2;
+            if (count <= grainSize) {
+                if (count > 0) {
+                    ExecutionOrderScope scope(order);
+                    body(size_t{ 0 }, count);
+                }
+                return;
+            }
+
+            WaitGroup group;
+            for (size_t begin = 0; begin < count; begin += grainSize, ++order.grain) {
+                const size_t end = begin + grainSize < count ? begin + grainSize : count;
+                submit(group, [&body, begin, end] { body(begin, end); }, order);
+            }
+            wait(group);
+        }
+
+        /**
+         * @brief Gets the number of background worker threads
+         */
+        size_t getWorkerCount() const {
+            return mWorkers.size();
+        }
+
+        /**
+         * @brief Gets the number of threads that execute jobs while a caller waits
+         */
+        size_t getConcurrency() const {
+            return mWorkers.size() + 1;
+        }
+
+        /**
+         * @brief One worker per hardware thread, minus the thread that waits
+         */
+        static size_t getDefaultWorkerCount();
+    };
+
+} // namespace ecs
@@ -0,0 +1,261 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define ECS_SIGNATURE_AVX2 1
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ECS_SIGNATURE_SSE2 1
+#endif
+
+namespace ecs {
+
+    /**
+     * @brief Fixed-size set of component type bits
+     *
+     * Replaces std::bitset for entity, system and archetype signatures. The
+     * bits are kept in 64-bit words aligned to the whole signature (up to 32
+     * bytes), so a 128-bit signature fills one SSE register and a 256-bit one
+     * an AVX register. containsAll(), the test that runs whenever an entity's
+     * components change, is then a single AND/compare instead of a loop over
+     * words; a scalar path is used where no SIMD instructions are available.
+     *
+     * The interface follows the parts of std::bitset the ECS uses.
+     *
+     * @tparam Bits Number of bits (64, 128 or 256)
+     */
+    template<size_t Bits>
+    class alignas(Bits / 8 < 32 ? Bits / 8 : 32) BasicSignature {
+        static_assert(Bits == 64 || Bits == 128 || Bits == 256, "Signatures hold 64, 128 or 256 bits.");
+
+    public:
+        static constexpr size_t WORD_BITS = 64;
+        static constexpr size_t WORD_COUNT = Bits / WORD_BITS;
+
+    private:
+        std::array<std::uint64_t, WORD_COUNT> mWords{};
+
+        static constexpr std::uint64_t maskOf(size_t pos) {
+            return std::uint64_t{ 1 } << (pos % WORD_BITS);
+        }
+
+    public:
+        constexpr BasicSignature() = default;
+
+        /**
+         * @brief Gets the number of bits
+         */
+        static constexpr size_t size() {
+            return Bits;
+        }
+
+        /**
+         * @brief Sets or clears one bit
+         * @param pos Bit index
+         * @param value New value of the bit
+         */
+        constexpr BasicSignature& set(size_t pos, bool value = true) {
+            assert(pos < Bits && "Signature bit out of range.");
+            if (value) {
+                mWords[pos / WORD_BITS] |= maskOf(pos);
+            } else {
+                mWords[pos / WORD_BITS] &= ~maskOf(pos);
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Clears one bit
+         * @param pos Bit index
+         */
+        constexpr BasicSignature& reset(size_t pos) {
+            return set(pos, false);
+        }
+
+        /**
+         * @brief Clears every bit
+         */
+        constexpr BasicSignature& reset() {
+            mWords.fill(0);
+            return *this;
+        }
+
+        /**
+         * @brief Tests one bit
+         * @param pos Bit index
+         */
+        constexpr bool test(size_t pos) const {
+            assert(pos < Bits && "Signature bit out of range.");
+            return (mWords[pos / WORD_BITS] & maskOf(pos)) != 0;
+        }
+
+        constexpr bool operator[](size_t pos) const {
+            return test(pos);
+        }
+
+        /**
+         * @brief Checks whether any bit is set
+         */
+        constexpr bool any() const {
+            std::uint64_t bits = 0;
+            for (std::uint64_t word : mWords) {
+                bits |= word;
+            }
+            return bits != 0;
+        }
+
+        /**
+         * @brief Checks whether no bit is set
+         */
+        constexpr bool none() const {
+            return !any();
+        }
+
+        /**
+         * @brief Counts the set bits
+         */
+        constexpr size_t count() const {
+            size_t total = 0;
+            for (std::uint64_t word : mWords) {
+                total += static_cast<size_t>(std::popcount(word));
+            }
+            return total;
+        }
+
+        /**
+         * @brief Checks whether every bit set in another signature is set here
+         *
+         * Same result as (*this & required) == required, without building
+         * the intermediate signature.
+         *
+         * @param required Bits that must all be present
+         */
+        bool containsAll(const BasicSignature& required) const {
+#if defined(ECS_SIGNATURE_AVX2)
+            if constexpr (Bits == 256) {
+                const __m256i have = _mm256_load_si256(reinterpret_cast<const __m256i*>(mWords.data()));
+                const __m256i need = _mm256_load_si256(reinterpret_cast<const __m256i*>(required.mWords.data()));
+                // Carry flag: (~have & need) == 0
+                return _mm256_testc_si256(have, need) != 0;
+            } else
+#endif
+#if defined(ECS_SIGNATURE_SSE2)
+            if constexpr (Bits >= 128) {
+                __m128i missing = _mm_setzero_si128();
+                for (size_t i = 0; i < WORD_COUNT; i += 2) {
+                    const __m128i have = _mm_load_si128(reinterpret_cast<const __m128i*>(mWords.data() + i));
+                    const __m128i need = _mm_load_si128(reinterpret_cast<const __m128i*>(required.mWords.data() + i));
+                    missing = _mm_or_si128(missing, _mm_andnot_si128(have, need));
+                }
+                return _mm_movemask_epi8(_mm_cmpeq_epi8(missing, _mm_setzero_si128())) == 0xFFFF;
+            } else
+#endif
+            {
+                std::uint64_t missing = 0;
+                for (size_t i = 0; i < WORD_COUNT; ++i) {
+                    missing |= required.mWords[i] & ~mWords[i];
+                }
+                return missing == 0;
+            }
+        }
+
+        /**
+         * @brief Checks whether the two signatures share at least one bit
+         */
+        constexpr bool intersects(const BasicSignature& other) const {
+            std::uint64_t shared = 0;
+            for (size_t i = 0; i < WORD_COUNT; ++i) {
+                shared |= mWords[i] & other.mWords[i];
+            }
+            return shared != 0;
+        }
+
+        /**
+         * @brief Calls a function with the index of every set bit, in ascending order
+         * @param func Callable taking a size_t
+         */
+        template<typename Func>
+        constexpr void forEachSet(Func&& func) const {
+            for (size_t i = 0; i < WORD_COUNT; ++i) {
+                for (std::uint64_t word = mWords[i]; word != 0; word &= word - 1) {
+                    func(i * WORD_BITS + static_cast<size_t>(std::countr_zero(word)));
+                }
+            }
+        }
+
+        /**
+         * @brief Gets one 64-bit word of the signature
+         * @param index Word index, bit 0 of word 0 is bit 0 of the signature
+         */
+        constexpr std::uint64_t getWord(size_t index) const {
+            return mWords[index];
+        }
+
+        constexpr BasicSignature& operator&=(const BasicSignature& other) {
+            for (size_t i = 0; i < WORD_COUNT; ++i) {
+                mWords[i] &= other.mWords[i];
+            }
+            return *this;
+        }
+
+        constexpr BasicSignature& operator|=(const BasicSignature& other) {
+            for (size_t i = 0; i < WORD_COUNT; ++i) {
+                mWords[i] |= other.mWords[i];
+            }
+            return *this;
+        }
+
+        constexpr BasicSignature& operator^=(const BasicSignature& other) {
+            for (size_t i = 0; i < WORD_COUNT; ++i) {
+                mWords[i] ^= other.mWords[i];
+            }
+            return *this;
+        }
+
+        constexpr BasicSignature operator~() const {
+            BasicSignature result;
+            for (size_t i = 0; i < WORD_COUNT; ++i) {
+                result.mWords[i] = ~mWords[i];
+            }
+            return result;
+        }
+
+        friend constexpr BasicSignature operator&(const BasicSignature& lhs, const BasicSignature& rhs) {
+            BasicSignature result = lhs;
+            return result &= rhs;
+        }
+
+        friend constexpr BasicSignature operator|(const BasicSignature& lhs, const BasicSignature& rhs) {
+            BasicSignature result = lhs;
+            return result |= rhs;
+        }
+
+        friend constexpr BasicSignature operator^(const BasicSignature& lhs, const BasicSignature& rhs) {
+            BasicSignature result = lhs;
+            return result ^= rhs;
+        }
+
+        friend constexpr bool operator==(const BasicSignature& lhs, const BasicSignature& rhs) = default;
+    };
+
+} // namespace ecs
+
+template<size_t Bits>
+struct std::hash<ecs::BasicSignature<Bits>> {
+    size_t operator()(const ecs::BasicSignature<Bits>& signature) const noexcept {
+        size_t hash = 0;
+        for (size_t i = 0; i < ecs::BasicSignature<Bits>::WORD_COUNT; ++i) {
+            hash ^= std::hash<std::uint64_t>{}(signature.getWord(i)) + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+        }
+        return hash;
+    }
+};
@@ -0,0 +1,221 @@
+#pragma once
+
+#include "ECSTypes.h"
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace ecs {
+
+    /**
+     * @brief Sparse set of entities with a paged sparse index
+     *
+     * Keeps a dense, packed list of entities plus a sparse lookup table that maps
+     * an entity's slot index to its position in the dense list. The sparse table
+     * is split into fixed-size pages that are only allocated when an entity in
+     * their range is inserted, so large but sparsely used ID ranges stay cheap.
+     *
+     * Insert, erase and lookup are O(1) and require no hashing: a lookup is one
+     * page-table read, one page read, and a dense read that compares the full
+     * handle so stale generations are rejected.
+     */
+    class SparseSet {
+    public:
+        /// Number of sparse entries per page (must be a power of two)
+        static constexpr size_t PAGE_SIZE = 4096;
+
+        /// Marker for sparse entries that do not point into the dense list
+        static constexpr std::uint32_t NULL_INDEX = std::numeric_limits<std::uint32_t>::max();
+
+    private:
+        using Page = std::array<std::uint32_t, PAGE_SIZE>;
+
+        /// Page table, grown on demand
+        std::vector<std::unique_ptr<Page>> mSparsePages;
+
+        /// Packed list of contained entities
+        std::vector<Entity> mDense;
+
+        static constexpr size_t pageOf(Entity entity) {
+            return static_cast<size_t>(entityIndex(entity)) / PAGE_SIZE;
+        }
+
+        static constexpr size_t offsetOf(Entity entity) {
+            return static_cast<size_t>(entityIndex(entity)) & (PAGE_SIZE - 1);
+        }
+
+        /**
+         * @brief Gets the sparse entry for an entity, allocating its page if needed
+         */
+        std::uint32_t& assureSparse(Entity entity) {
+            const size_t page = pageOf(entity);
+            if (page >= mSparsePages.size()) {
+                mSparsePages.resize(page + 1);
+            }
+            if (!mSparsePages[page]) {
+                mSparsePages[page] = std::make_unique<Page>();
+                mSparsePages[page]->fill(NULL_INDEX);
+            }
+            return (*mSparsePages[page])[offsetOf(entity)];
+        }
+
+        /**
+         * @brief Gets the sparse entry for an entity, or NULL_INDEX if its page does not exist
+         */
+        std::uint32_t sparseAt(Entity entity) const {
+            const size_t page = pageOf(entity);
+            if (page < mSparsePages.size() && mSparsePages[page]) {
+                return (*mSparsePages[page])[offsetOf(entity)];
+            }
+            return NULL_INDEX;
+        }
+
+    public:
+        using const_iterator = std::vector<Entity>::const_iterator;
+
+        /**
+         * @brief Checks if the set contains an entity
+         * @param entity Entity to look up
+         * @return true if the entity is in the set
+         */
+        bool contains(Entity entity) const {
+            const std::uint32_t denseIndex = sparseAt(entity);
+            return denseIndex != NULL_INDEX && mDense[denseIndex] == entity;
+        }
+
+        /**
+         * @brief Gets the dense position of an entity
+         * @param entity Entity to look up (must be contained)
+         * @return Index of the entity in the dense list
+         */
+        size_t index(Entity entity) const {
+            assert(contains(entity) && "Entity not in sparse set.");
+            return sparseAt(entity);
+        }
+
+        /**
+         * @brief Appends an entity to the set
+         * @param entity Entity to insert (must not be contained)
+         * @return Dense index assigned to the entity
+         */
+        size_t insert(Entity entity) {
+            std::uint32_t& slot = assureSparse(entity);
+            assert(slot == NULL_INDEX && "Entity slot inserted into sparse set more than once.");
+
+            slot = static_cast<std::uint32_t>(mDense.size());
+            mDense.push_back(entity);
+            return slot;
+        }
+
+        /**
+         * @brief Removes an entity using swap-and-pop
+         *
+         * The last entity in the dense list is moved into the erased slot. Owners of
+         * parallel dense arrays must mirror the same move.
+         *
+         * @param entity Entity to remove (must be contained)
+         * @return Dense index that was vacated and now holds the former last entity
+         */
+        size_t erase(Entity entity) {
+            assert(contains(entity) && "Removing entity not in sparse set.");
+
+            std::uint32_t& slot = (*mSparsePages[pageOf(entity)])[offsetOf(entity)];
+            const size_t removedIndex = slot;
+            const Entity lastEntity = mDense.back();
+
+            mDense[removedIndex] = lastEntity;
+            (*mSparsePages[pageOf(lastEntity)])[offsetOf(lastEntity)] = static_cast<std::uint32_t>(removedIndex);
+
+            slot = NULL_INDEX;
+            mDense.pop_back();
+            return removedIndex;
+        }
+
+        /**
+         * @brief Removes all entities (allocated pages are kept)
+         */
+        void clear() {
+            for (Entity entity : mDense) {
+                (*mSparsePages[pageOf(entity)])[offsetOf(entity)] = NULL_INDEX;
+            }
+            mDense.clear();
+        }
+
+        /**
+         * @brief Replaces the contents with a dense list written in one go
+         *
+         * Used when restoring a WorldSnapshot: the packed list is filled by
+         * the callback and the sparse entries are rebuilt from it.
+         *
+         * @param count Number of entities
+         * @param fill Callable that writes count entities to the Entity* it receives
+         */
+        template<typename Fill>
+        void assign(size_t count, Fill&& fill) {
+            clear();
+            mDense.resize(count);
+            fill(mDense.data());
+            for (size_t i = 0; i < count; ++i) {
+                std::uint32_t& slot = assureSparse(mDense[i]);
+                assert(slot == NULL_INDEX && "Entity slot inserted into sparse set more than once.");
+                slot = static_cast<std::uint32_t>(i);
+            }
+        }
+
+        /**
+         * @brief Reserves dense capacity
+         * @param capacity Number of entities to reserve room for
+         */
+        void reserve(size_t capacity) {
+            mDense.reserve(capacity);
+        }
+
+        /**
+         * @brief Gets the number of entities in the set
+         */
+        size_t size() const {
+            return mDense.size();
+        }
+
+        /**
+         * @brief Checks if the set is empty
+         */
+        bool empty() const {
+            return mDense.empty();
+        }
+
+        /**
+         * @brief Gets the entity at a dense position
+         */
+        Entity operator[](size_t denseIndex) const {
+            return mDense[denseIndex];
+        }
+
+        /**
+         * @brief Gets the packed entity list
+         */
+        const std::vector<Entity>& entities() const {
+            return mDense;
+        }
+
+        /**
+         * @brief Gets the number of allocated sparse pages
+         */
+        size_t getPageCount() const {
+            size_t count = 0;
+            for (const auto& page : mSparsePages) {
+                if (page) {
+                    ++count;
+                }
+            }
+            return count;
+        }
+
+        const_iterator begin() const { return mDense.begin(); }
+        const_iterator end() const { return mDense.end(); }
+    };
+
+} // namespace ecs
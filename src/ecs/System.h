@@ -1,8 +1,9 @@
 #pragma once
 
 #include "ECSTypes.h"
+#include "ComponentManager.h"
+#include "SparseSet.h"
 #include <vector>
-#include <algorithm>
 
 namespace ecs {
 
@@ -11,11 +12,56 @@ namespace ecs {
      *
      * Systems contain the logic that operates on entities with specific components.
      * Each system maintains a list of entities that match its required signature.
+     * The list is a sparse set, so membership changes and checks are O(1);
+     * removal swaps the last entity into the freed slot, so the iteration
+     * order is not the insertion order.
+     *
+     * Systems can declare which component types they read and write. The
+     * SystemManager uses these declarations to run systems that do not
+     * conflict in parallel. A system that declares nothing is treated as
+     * exclusive: it runs alone, on the thread that updates the systems.
      */
     class System {
     protected:
-        /// List of entities currently assigned to this system
-        std::vector<Entity> mEntities;
+        /// Entities currently assigned to this system
+        SparseSet mEntities;
+
+        /**
+         * @brief Declares component types this system only reads
+         * @tparam Ts Component types
+         */
+        template<typename... Ts>
+        void declareReads() {
+            (mReads.set(ComponentManager::typeId<Ts>()), ...);
+            mAccessDeclared = true;
+        }
+
+        /**
+         * @brief Declares component types this system writes
+         * @tparam Ts Component types
+         */
+        template<typename... Ts>
+        void declareWrites() {
+            (mWrites.set(ComponentManager::typeId<Ts>()), ...);
+            mAccessDeclared = true;
+        }
+
+        /**
+         * @brief Declares that this system must run alone on the updating thread
+         *
+         * Required for systems that create or destroy entities, add or remove
+         * components, or touch state outside the ECS such as the renderer.
+         */
+        void declareExclusive() {
+            mExclusive = true;
+        }
+
+    private:
+        Signature mReads;
+        Signature mWrites;
+        bool mAccessDeclared = false;
+        bool mExclusive = false;
+        uint64_t mMembershipVersion = 0;
 
     public:
         /**
@@ -28,7 +74,7 @@ namespace ecs {
          * @return Const reference to entity list
          */
         const std::vector<Entity>& getEntities() const {
-            return mEntities;
+            return mEntities.entities();
         }
 
         /**
@@ -44,32 +90,90 @@ namespace ecs {
          * @param entity Entity to add
          */
         void addEntity(Entity entity) {
-            // Check if entity is already in the list
-            auto it = std::find(mEntities.begin(), mEntities.end(), entity);
-            if (it == mEntities.end()) {
-                mEntities.push_back(entity);
+            if (!mEntities.contains(entity)) {
+                mEntities.insert(entity);
+                ++mMembershipVersion;
             }
         }
 
+        /**
+         * @brief Removes every entity from this system
+         */
+        void clearEntities() {
+            mEntities.clear();
+            ++mMembershipVersion;
+        }
+
+        /**
+         * @brief Reserves room for a number of entities
+         * @param capacity Number of entities to make room for
+         */
+        void reserveEntities(size_t capacity) {
+            mEntities.reserve(capacity);
+        }
+
         /**
          * @brief Removes an entity from this system
          * @param entity Entity to remove
          */
         void removeEntity(Entity entity) {
-            auto it = std::find(mEntities.begin(), mEntities.end(), entity);
-            if (it != mEntities.end()) {
-                mEntities.erase(it);
+            if (mEntities.contains(entity)) {
+                mEntities.erase(entity);
+                ++mMembershipVersion;
             }
         }
 
+        /**
+         * @brief Gets a counter raised whenever an entity joins or leaves this system
+         *
+         * Systems that cache data derived from their entity list compare it
+         * with the value seen at the last rebuild.
+         */
+        uint64_t getMembershipVersion() const {
+            return mMembershipVersion;
+        }
+
         /**
          * @brief Checks if an entity is managed by this system
          * @param entity Entity to check
          * @return true if entity is in system, false otherwise
          */
         bool hasEntity(Entity entity) const {
-            auto it = std::find(mEntities.begin(), mEntities.end(), entity);
-            return it != mEntities.end();
+            return mEntities.contains(entity);
+        }
+
+        /**
+         * @brief Checks whether this system must run alone on the updating thread
+         */
+        bool isExclusive() const {
+            return mExclusive || !mAccessDeclared;
+        }
+
+        /**
+         * @brief Gets the component types this system reads
+         */
+        const Signature& getReadSet() const {
+            return mReads;
+        }
+
+        /**
+         * @brief Gets the component types this system writes
+         */
+        const Signature& getWriteSet() const {
+            return mWrites;
+        }
+
+        /**
+         * @brief Checks whether two systems may not run at the same time
+         * @param other System to compare with
+         * @return true if either is exclusive or one writes what the other accesses
+         */
+        bool conflictsWith(const System& other) const {
+            if (isExclusive() || other.isExclusive()) {
+                return true;
+            }
+            return mWrites.intersects(other.mReads | other.mWrites) ||
+                other.mWrites.intersects(mReads | mWrites);
         }
 
         /**
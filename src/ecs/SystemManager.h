@@ -1,11 +1,18 @@
 #pragma once
 
 #include "System.h"
+#include "EntityManager.h"
+#include "JobSystem.h"
+#include "SystemProfiler.h"
+#include "ExecutionOrder.h"
 #include "ECSTypes.h"
+#include <atomic>
 #include <memory>
 #include <unordered_map>
 #include <typeindex>
 #include <cassert>
+#include <span>
+#include <vector>
 
 namespace ecs {
 
@@ -17,6 +24,16 @@ namespace ecs {
      * - Maintain entity lists for each system based on their signatures
      * - Update system entity lists when entity signatures change
      * - Handle entity destruction cleanup across all systems
+     * - Schedule system updates, in parallel where their declared accesses allow
+     *
+     * Systems always update in registration order when run sequentially. The
+     * parallel update builds a dependency graph in which a system depends on
+     * every earlier-registered system it conflicts with (see
+     * System::conflictsWith), so conflicting systems keep that order and only
+     * independent systems overlap.
+     *
+     * Every update is timed by a SystemProfiler unless profiling is
+     * compiled out (see SYSTEM_PROFILING_ENABLED).
      */
     class SystemManager {
     private:
@@ -26,6 +43,99 @@ namespace ecs {
         /// Map from system type to system instance
         std::unordered_map<std::type_index, std::shared_ptr<System>> mSystems;
 
+        /// Systems in registration order, with their signatures' keys
+        std::vector<std::pair<std::type_index, System*>> mSystemOrder;
+
+        /// Dependency graph over mSystemOrder, rebuilt after registration
+        struct ScheduleNode {
+            std::vector<size_t> dependents;
+            size_t dependencyCount = 0;
+        };
+        std::vector<ScheduleNode> mSchedule;
+        bool mScheduleDirty = true;
+
+        /// Per-system timings, indexed like mSystemOrder
+        SystemProfiler mProfiler;
+
+        /**
+         * @brief Updates one system, timing it when profiling is compiled in
+         *
+         * Events and commands the system records are tagged with its
+         * position, so they are merged and played back in schedule order
+         * whichever thread ran it.
+         *
+         * @param index Position of the system in mSystemOrder
+         * @param deltaTime Time elapsed since last update
+         */
+        void updateSystem(size_t index, float deltaTime) {
+            System& system = *mSystemOrder[index].second;
+            EventSourceScope eventSource(static_cast<uint32_t>(index) + 1);
+            if constexpr (SYSTEM_PROFILING_ENABLED) {
+                const size_t entityCount = system.getEntityCount();
+                const SystemProfiler::Timer timer = mProfiler.begin();
+                system.update(deltaTime);
+                mProfiler.end(index, timer, entityCount);
+            } else {
+                system.update(deltaTime);
+            }
+        }
+
+        /**
+         * @brief Links each system to the earlier systems it conflicts with
+         *
+         * Exclusive systems act as barriers (everything before them finishes
+         * first and everything after starts later), so edges are only needed
+         * between non-exclusive systems between two barriers.
+         */
+        void buildSchedule() {
+            mSchedule.assign(mSystemOrder.size(), ScheduleNode{});
+            for (size_t later = 0; later < mSystemOrder.size(); ++later) {
+                const System& laterSystem = *mSystemOrder[later].second;
+                if (laterSystem.isExclusive()) {
+                    continue;
+                }
+                for (size_t earlier = later; earlier-- > 0;) {
+                    const System& earlierSystem = *mSystemOrder[earlier].second;
+                    if (earlierSystem.isExclusive()) {
+                        break;
+                    }
+                    if (laterSystem.conflictsWith(earlierSystem)) {
+                        mSchedule[earlier].dependents.push_back(later);
+                        ++mSchedule[later].dependencyCount;
+                    }
+                }
+            }
+            mScheduleDirty = false;
+        }
+
+        /**
+         * @brief Runs the non-exclusive systems between two barriers on the job pool
+         */
+        void runParallelSegment(size_t begin, size_t end, float deltaTime, JobSystem& jobs) {
+            std::vector<std::atomic<size_t>> remaining(end - begin);
+            for (size_t i = begin; i < end; ++i) {
+                remaining[i - begin].store(mSchedule[i].dependencyCount, std::memory_order_relaxed);
+            }
+
+            JobSystem::WaitGroup group;
+            auto runSystem = [&](auto& self, size_t index) -> void {
+                updateSystem(index, deltaTime);
+                for (size_t dependent : mSchedule[index].dependents) {
+                    if (remaining[dependent - begin].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                        jobs.submit(group, [&self, dependent] { self(self, dependent); });
+                    }
+                }
+            };
+
+            // Roots are taken from the static schedule: remaining[] already changes once the first job runs
+            for (size_t i = begin; i < end; ++i) {
+                if (mSchedule[i].dependencyCount == 0) {
+                    jobs.submit(group, [&runSystem, i] { runSystem(runSystem, i); });
+                }
+            }
+            jobs.wait(group);
+        }
+
     public:
         /**
          * @brief Registers a new system
@@ -43,6 +153,9 @@ namespace ecs {
             // Create a pointer to the system and return it so it can be used externally
             auto system = std::make_shared<T>(std::forward<Args>(args)...);
             mSystems[typeIndex] = system;
+            mSystemOrder.emplace_back(typeIndex, system.get());
+            mProfiler.addSystem(SystemProfiler::readableTypeName(typeid(T).name()));
+            mScheduleDirty = true;
             return system;
         }
 
@@ -52,7 +165,7 @@ namespace ecs {
          * @param signature Required component signature
          */
         template<typename T>
-        void setSignature(Signature signature) {
+        void setSignature(const Signature& signature) {
             std::type_index typeIndex = std::type_index(typeid(T));
 
             assert(mSystems.find(typeIndex) != mSystems.end() && "System used before registered.");
@@ -81,8 +194,7 @@ namespace ecs {
          */
         void entityDestroyed(Entity entity) {
             // Erase a destroyed entity from all system lists
-            for (auto const& pair : mSystems) {
-                auto const& system = pair.second;
+            for (auto const& [type, system] : mSystemOrder) {
                 system->removeEntity(entity);
             }
         }
@@ -92,15 +204,13 @@ namespace ecs {
          * @param entity The entity whose signature changed
          * @param entitySignature The entity's current signature
          */
-        void entitySignatureChanged(Entity entity, Signature entitySignature) {
+        void entitySignatureChanged(Entity entity, const Signature& entitySignature) {
             // Notify each system that an entity's signature changed
-            for (auto const& pair : mSystems) {
-                auto const& type = pair.first;
-                auto const& system = pair.second;
+            for (auto const& [type, system] : mSystemOrder) {
                 auto const& systemSignature = mSignatures[type];
 
                 // Entity signature matches system signature - insert into set
-                if ((entitySignature & systemSignature) == systemSignature) {
+                if (entitySignature.containsAll(systemSignature)) {
                     system->addEntity(entity);
                 }
                 // Entity signature does not match system signature - erase from set
@@ -110,6 +220,74 @@ namespace ecs {
             }
         }
 
+        /**
+         * @brief Notifies systems that many entities now share one signature
+         *
+         * Each system tests the signature once and then takes or drops the
+         * whole batch, instead of one pass over every system per entity.
+         *
+         * @param entities Entities whose signature changed
+         * @param entitySignature New signature of every entity in the batch
+         */
+        void entitiesSignatureChanged(std::span<const Entity> entities, const Signature& entitySignature) {
+            for (auto const& [type, system] : mSystemOrder) {
+                auto const& systemSignature = mSignatures[type];
+
+                if (entitySignature.containsAll(systemSignature)) {
+                    system->reserveEntities(batchCapacity(system->getEntityCount(), entities.size()));
+                    for (Entity entity : entities) {
+                        system->addEntity(entity);
+                    }
+                } else {
+                    for (Entity entity : entities) {
+                        system->removeEntity(entity);
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief Notifies systems that many entities changed signature
+         *
+         * Walks the batch once per system, so each system's signature is
+         * looked up once rather than once per entity.
+         *
+         * @param entities Entities whose signature changed
+         * @param entitySignatures New signature of each entity, parallel to entities
+         */
+        void entitiesSignatureChanged(std::span<const Entity> entities, std::span<const Signature> entitySignatures) {
+            assert(entities.size() == entitySignatures.size() && "One signature per entity expected.");
+
+            for (auto const& [type, system] : mSystemOrder) {
+                auto const& systemSignature = mSignatures[type];
+
+                for (size_t i = 0; i < entities.size(); ++i) {
+                    if (entitySignatures[i].containsAll(systemSignature)) {
+                        system->addEntity(entities[i]);
+                    } else {
+                        system->removeEntity(entities[i]);
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief Rebuilds every system's entity list from the entity signatures
+         *
+         * Used after the entities were replaced wholesale, e.g. by restoring
+         * a snapshot.
+         *
+         * @param entityManager Entities to match against the system signatures
+         */
+        void rebuildEntityLists(const EntityManager& entityManager) {
+            for (auto const& [type, system] : mSystemOrder) {
+                system->clearEntities();
+                entityManager.forEachMatching(mSignatures[type], [system](Entity entity) {
+                    system->addEntity(entity);
+                });
+            }
+        }
+
         /**
          * @brief Gets the number of registered systems
          * @return System count
@@ -119,15 +297,73 @@ namespace ecs {
         }
 
         /**
-         * @brief Updates all systems
+         * @brief Updates all systems in registration order
          * @param deltaTime Time elapsed since last update
          */
         void updateAllSystems(float deltaTime) {
-            for (auto const& pair : mSystems) {
-                pair.second->update(deltaTime);
+            for (size_t i = 0; i < mSystemOrder.size(); ++i) {
+                updateSystem(i, deltaTime);
             }
         }
 
+        /**
+         * @brief Updates all systems, running non-conflicting ones in parallel
+         *
+         * Exclusive systems run on the calling thread once every earlier
+         * system has finished. The result equals updateAllSystems() as long
+         * as the systems' access declarations are accurate.
+         *
+         * @param deltaTime Time elapsed since last update
+         * @param jobs Pool that runs the non-exclusive systems
+         */
+        void updateAllSystems(float deltaTime, JobSystem& jobs) {
+            if (mScheduleDirty) {
+                buildSchedule();
+            }
+
+            size_t segmentBegin = 0;
+            for (size_t i = 0; i <= mSystemOrder.size(); ++i) {
+                const bool atBarrier = i == mSystemOrder.size() || mSystemOrder[i].second->isExclusive();
+                if (!atBarrier) {
+                    continue;
+                }
+                if (segmentBegin < i) {
+                    runParallelSegment(segmentBegin, i, deltaTime, jobs);
+                }
+                if (i < mSystemOrder.size()) {
+                    updateSystem(i, deltaTime);
+                }
+                segmentBegin = i + 1;
+            }
+        }
+
+        /**
+         * @brief Gets the number of systems each system waits for in the parallel schedule
+         * @return Dependency counts in registration order
+         */
+        std::vector<size_t> getScheduleDependencyCounts() {
+            if (mScheduleDirty) {
+                buildSchedule();
+            }
+            std::vector<size_t> counts;
+            counts.reserve(mSchedule.size());
+            for (const auto& node : mSchedule) {
+                counts.push_back(node.dependencyCount);
+            }
+            return counts;
+        }
+
+        /**
+         * @brief Gets the timings of the system updates
+         */
+        SystemProfiler& getProfiler() {
+            return mProfiler;
+        }
+
+        const SystemProfiler& getProfiler() const {
+            return mProfiler;
+        }
+
         /**
          * @brief Gets all registered systems
          * @return Map of system type indices to system instances
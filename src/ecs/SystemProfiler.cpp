@@ -0,0 +1,232 @@
+#include "SystemProfiler.h"
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+#include <set>
+
+#if defined(__GNUG__)
+#include <cxxabi.h>
+#endif
+#if defined(_MSC_VER)
+#include <malloc.h>
+#endif
+
+namespace ecs {
+
+    namespace {
+        thread_local uint64_t tAllocationCount = 0;
+
+        double toMilliseconds(int64_t nanoseconds) {
+            return static_cast<double>(nanoseconds) / 1.0e6;
+        }
+    }
+
+    uint64_t SystemProfiler::threadAllocationCount() {
+        return tAllocationCount;
+    }
+
+    std::string SystemProfiler::readableTypeName(const char* name) {
+        std::string result = name;
+#if defined(__GNUG__)
+        int status = 0;
+        char* demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+        if (status == 0 && demangled) {
+            result = demangled;
+        }
+        std::free(demangled);
+#else
+        // MSVC names are already readable, apart from the class-key prefix
+        for (const char* prefix : { "class ", "struct " }) {
+            const std::string key = prefix;
+            if (result.compare(0, key.size(), key) == 0) {
+                result.erase(0, key.size());
+            }
+        }
+#endif
+        return result;
+    }
+
+    void SystemProfiler::reset() {
+        for (SystemRecord& record : mSystems) {
+            record.nextSample = 0;
+            record.sampleCount = 0;
+            record.totalAllocations = 0;
+        }
+    }
+
+    std::vector<SystemTimingStats> SystemProfiler::getStats() const {
+        std::vector<SystemTimingStats> result;
+        result.reserve(mSystems.size());
+
+        std::vector<int64_t> durations;
+        for (const SystemRecord& record : mSystems) {
+            SystemTimingStats stats;
+            stats.name = record.name;
+            stats.sampleCount = record.sampleCount;
+            stats.totalAllocations = record.totalAllocations;
+
+            if (record.sampleCount > 0) {
+                durations.clear();
+                int64_t total = 0;
+                for (size_t i = 0; i < record.sampleCount; ++i) {
+                    durations.push_back(record.samples[i].durationNs);
+                    total += record.samples[i].durationNs;
+                }
+
+                // Nearest-rank percentile: the smallest duration at or above 99% of the samples
+                const size_t rank = (durations.size() * 99 + 99) / 100 - 1;
+                std::nth_element(durations.begin(), durations.begin() + rank, durations.end());
+                stats.p99Ms = toMilliseconds(durations[rank]);
+                stats.minMs = toMilliseconds(*std::min_element(durations.begin(), durations.end()));
+                stats.avgMs = toMilliseconds(total) / static_cast<double>(record.sampleCount);
+
+                const Sample& last = record.samples[(record.nextSample + HISTORY_SIZE - 1) % HISTORY_SIZE];
+                stats.lastMs = toMilliseconds(last.durationNs);
+                stats.entityCount = last.entityCount;
+                stats.lastAllocations = last.allocations;
+            }
+            result.push_back(std::move(stats));
+        }
+        return result;
+    }
+
+    void SystemProfiler::writeTraceEvents(core::chrome::TraceEventWriter& writer) const {
+        for (const SystemRecord& record : mSystems) {
+            // Oldest first, so every thread's events come out in time order
+            const size_t oldest = record.sampleCount < HISTORY_SIZE ? 0 : record.nextSample;
+            for (size_t i = 0; i < record.sampleCount; ++i) {
+                const Sample& sample = record.samples[(oldest + i) % HISTORY_SIZE];
+                std::ostream& out = writer.beginComplete(record.name, "system", sample.thread, sample.startNs, sample.durationNs);
+                out << ",\"args\":{\"entities\":" << sample.entityCount;
+                if constexpr (ALLOCATION_COUNTING_ENABLED) {
+                    out << ",\"allocations\":" << sample.allocations;
+                }
+                out << "}}";
+            }
+        }
+    }
+
+    void SystemProfiler::writeChromeTrace(std::ostream& out) const {
+        core::chrome::TraceEventWriter writer(out);
+        writeTraceEvents(writer);
+
+        std::set<uint32_t> threads;
+        for (const SystemRecord& record : mSystems) {
+            for (size_t i = 0; i < record.sampleCount; ++i) {
+                threads.insert(record.samples[i].thread);
+            }
+        }
+        for (uint32_t thread : threads) {
+            writer.threadName(thread, "Thread " + std::to_string(thread));
+        }
+        writer.finish();
+    }
+
+} // namespace ecs
+
+#if ECS_COUNT_ALLOCATIONS
+
+/*
+ * Global allocation hooks behind SystemProfiler::threadAllocationCount().
+ * They only count and forward to the C allocator; the array forms are
+ * left to their defaults, which call these.
+ */
+
+namespace {
+    void* countedAllocate(std::size_t size) {
+        ++ecs::tAllocationCount;
+        if (size == 0) {
+            size = 1;
+        }
+        while (true) {
+            if (void* memory = std::malloc(size)) {
+                return memory;
+            }
+            std::new_handler handler = std::get_new_handler();
+            if (!handler) {
+                throw std::bad_alloc();
+            }
+            handler();
+        }
+    }
+
+    void* countedAllocateAligned(std::size_t size, std::align_val_t alignment) {
+        ++ecs::tAllocationCount;
+        const std::size_t align = static_cast<std::size_t>(alignment);
+        // aligned_alloc requires a size that is a multiple of the alignment
+        size = size == 0 ? align : (size + align - 1) / align * align;
+        while (true) {
+#if defined(_MSC_VER)
+            void* memory = _aligned_malloc(size, align);
+#else
+            void* memory = std::aligned_alloc(align, size);
+#endif
+            if (memory) {
+                return memory;
+            }
+            std::new_handler handler = std::get_new_handler();
+            if (!handler) {
+                throw std::bad_alloc();
+            }
+            handler();
+        }
+    }
+
+    void releaseAligned(void* memory) noexcept {
+#if defined(_MSC_VER)
+        _aligned_free(memory);
+#else
+        std::free(memory);
+#endif
+    }
+}
+
+void* operator new(std::size_t size) {
+    return countedAllocate(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return countedAllocate(size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    return countedAllocateAligned(size, alignment);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    try {
+        return countedAllocateAligned(size, alignment);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, const std::nothrow_t&) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::align_val_t) noexcept {
+    releaseAligned(memory);
+}
+
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept {
+    releaseAligned(memory);
+}
+
+void operator delete(void* memory, std::align_val_t, const std::nothrow_t&) noexcept {
+    releaseAligned(memory);
+}
+
+#endif
@@ -0,0 +1,211 @@
+#pragma once
+
+#include "../core/ChromeTrace.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#ifndef ECS_PROFILE_SYSTEMS
+#define ECS_PROFILE_SYSTEMS 1
+#endif
+
+#ifndef ECS_COUNT_ALLOCATIONS
+#define ECS_COUNT_ALLOCATIONS 0
+#endif
+
+namespace ecs {
+
+    /**
+     * @brief Whether SystemManager times system updates
+     *
+     * Set with the ECS_PROFILE_SYSTEMS compile definition (0 or 1). When
+     * off, system updates run without any clock reads or bookkeeping.
+     */
+    static constexpr bool SYSTEM_PROFILING_ENABLED = ECS_PROFILE_SYSTEMS != 0;
+
+    /**
+     * @brief Whether the global allocation hooks behind SystemProfiler::threadAllocationCount() are installed
+     *
+     * Set with the ECS_COUNT_ALLOCATIONS compile definition (0 or 1), off
+     * by default: the hooks replace the global operator new and delete for
+     * the whole program. When off, allocation counts read 0.
+     */
+    static constexpr bool ALLOCATION_COUNTING_ENABLED = ECS_COUNT_ALLOCATIONS != 0;
+
+    /**
+     * @brief Timing summary of one system over the profiler's history window
+     */
+    struct SystemTimingStats {
+        std::string name;
+        /// Updates in the history window
+        size_t sampleCount = 0;
+        double minMs = 0.0;
+        double avgMs = 0.0;
+        double p99Ms = 0.0;
+        double lastMs = 0.0;
+        /// Entities the system held when it last updated
+        size_t entityCount = 0;
+        /// Heap allocations made during the last update (0 without ALLOCATION_COUNTING_ENABLED)
+        uint64_t lastAllocations = 0;
+        /// Heap allocations made during every recorded update (0 without ALLOCATION_COUNTING_ENABLED)
+        uint64_t totalAllocations = 0;
+    };
+
+    /**
+     * @brief Records how long each system's update takes
+     *
+     * SystemManager owns one profiler and wraps every system update in
+     * begin()/end(). Each system keeps its last HISTORY_SIZE updates in a
+     * ring, from which getStats() derives min, average and 99th percentile
+     * and writeChromeTrace() emits one trace event per update. Updates are
+     * stamped with the clock and thread tracks of core::chrome, the same as
+     * core::Trace zones, so writeTraceEvents() can add them to a trace
+     * holding those zones and each update nests under the zone it ran in.
+     *
+     * With ALLOCATION_COUNTING_ENABLED, allocations are counted by
+     * replacing the global operator new, so the count covers everything
+     * the updating thread allocates, including allocations made by code
+     * the system calls.
+     *
+     * A system's record is only written by the thread updating it, so
+     * systems may be timed from several threads at once. Registering
+     * systems or reading the results while systems update is not safe.
+     */
+    class SystemProfiler {
+    public:
+        /// Updates kept per system
+        static constexpr size_t HISTORY_SIZE = 128;
+
+        /**
+         * @brief One timed update
+         */
+        struct Sample {
+            /// Start, in nanoseconds since the trace epoch (core::chrome::now())
+            int64_t startNs = 0;
+            int64_t durationNs = 0;
+            uint32_t entityCount = 0;
+            uint32_t allocations = 0;
+            /// Trace track of the updating thread, see threadLane()
+            uint32_t thread = 0;
+        };
+
+        /**
+         * @brief State captured by begin() and consumed by end()
+         */
+        struct Timer {
+            int64_t startNs;
+            uint64_t allocations;
+        };
+
+    private:
+        struct SystemRecord {
+            std::string name;
+            std::array<Sample, HISTORY_SIZE> samples{};
+            size_t nextSample = 0;
+            size_t sampleCount = 0;
+            uint64_t totalAllocations = 0;
+        };
+
+        std::vector<SystemRecord> mSystems;
+
+    public:
+        /**
+         * @brief Gets the number of heap allocations made by the calling thread so far
+         *
+         * Always 0 when allocation counting is compiled out.
+         */
+        static uint64_t threadAllocationCount();
+
+        /**
+         * @brief Gets a small number identifying the calling thread
+         *
+         * The thread's core::chrome::threadId(), so core::Trace zones of the
+         * same thread land on the same track.
+         */
+        static uint32_t threadLane() {
+            return core::chrome::threadId();
+        }
+
+        /**
+         * @brief Turns a std::type_info name into a readable type name
+         */
+        static std::string readableTypeName(const char* name);
+
+        /**
+         * @brief Adds a system, in registration order
+         * @param name Name shown in statistics and traces
+         * @return Index to pass to end()
+         */
+        size_t addSystem(std::string name) {
+            mSystems.push_back(SystemRecord{ std::move(name) });
+            return mSystems.size() - 1;
+        }
+
+        /**
+         * @brief Starts timing an update on the calling thread
+         */
+        Timer begin() const {
+            return { core::chrome::now(), threadAllocationCount() };
+        }
+
+        /**
+         * @brief Finishes timing an update started by begin() on the same thread
+         * @param system Index returned by addSystem()
+         * @param timer Value returned by begin()
+         * @param entityCount Entities the system processed
+         */
+        void end(size_t system, const Timer& timer, size_t entityCount) {
+            const int64_t nowNs = core::chrome::now();
+            const uint64_t allocations = threadAllocationCount() - timer.allocations;
+
+            SystemRecord& record = mSystems[system];
+            Sample& sample = record.samples[record.nextSample];
+            sample.startNs = timer.startNs;
+            sample.durationNs = nowNs - timer.startNs;
+            sample.entityCount = static_cast<uint32_t>(entityCount);
+            sample.allocations = static_cast<uint32_t>(allocations);
+            sample.thread = threadLane();
+
+            record.nextSample = (record.nextSample + 1) % HISTORY_SIZE;
+            if (record.sampleCount < HISTORY_SIZE) {
+                ++record.sampleCount;
+            }
+            record.totalAllocations += allocations;
+        }
+
+        /**
+         * @brief Forgets every recorded update, keeping the systems
+         */
+        void reset();
+
+        /**
+         * @brief Summarizes every system's recorded updates
+         * @return One entry per system, in registration order
+         */
+        std::vector<SystemTimingStats> getStats() const;
+
+        /**
+         * @brief Adds the recorded updates to a trace document, without thread names
+         *
+         * Every update is a complete ("X") event on the thread that ran it,
+         * with the entity and allocation counts as arguments.
+         *
+         * @param writer Document being written, e.g. one core::Trace::writeEvents() also wrote to
+         */
+        void writeTraceEvents(core::chrome::TraceEventWriter& writer) const;
+
+        /**
+         * @brief Writes the recorded updates as Chrome trace-event JSON
+         *
+         * The output loads in chrome://tracing and Perfetto: the events of
+         * writeTraceEvents(), and a name for every thread that ran one.
+         *
+         * @param out Stream to write to
+         */
+        void writeChromeTrace(std::ostream& out) const;
+    };
+
+} // namespace ecs
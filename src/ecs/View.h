@@ -0,0 +1,446 @@
+#pragma once
+
+#include "Archetype.h"
+#include "ArchetypeStorage.h"
+#include "ComponentArray.h"
+#include "ECSTypes.h"
+#include "JobSystem.h"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ecs {
+
+    /**
+     * @brief Iterable set of entities that have all of the given components
+     *
+     * Created by Coordinator::view(). The component storages are resolved
+     * once when the view is built, so iterating does no type lookups: each
+     * step reads the components straight from their arrays.
+     *
+     * With sparse storage the view walks the smallest of the component arrays
+     * and skips entities missing from the others. With archetype storage it
+     * walks the rows of every matching archetype.
+     *
+     * Usage:
+     * @code
+     * for (auto [entity, transform, velocity] : coordinator.view<Transform, const Velocity>()) { ... }
+     * coordinator.view<Transform, const Velocity>().each([](Transform& t, const Velocity& v) { ... });
+     * @endcode
+     *
+     * Component types listed without const are handed out for writing and
+     * stamped as changed for every visited entity (with archetype storage,
+     * for every visited chunk). changedSince() narrows the view to entities
+     * whose component changed after a given tick.
+     *
+     * Components of the viewed types must not be added or removed, and
+     * entities must not be destroyed, while a view is being iterated.
+     *
+     * @tparam Ts Required component types, optionally const
+     */
+    template<typename... Ts>
+    class View {
+        static_assert(sizeof...(Ts) > 0, "A view needs at least one component type.");
+
+    public:
+        /// Element produced by iteration: the entity followed by its components
+        using value_type = std::tuple<Entity, Ts&...>;
+
+        /// Default number of entities per job in parallelForEach()
+        static constexpr size_t DEFAULT_GRAIN_SIZE = 1024;
+
+    private:
+        static constexpr size_t COMPONENT_COUNT = sizeof...(Ts);
+
+        /// Marker for mFilterIndex when the view is not filtered by changes
+        static constexpr size_t NO_FILTER = COMPONENT_COUNT;
+
+        template<typename T>
+        using StorageOf = ComponentArray<std::remove_const_t<T>>;
+
+        /// Component arrays (sparse storage)
+        std::tuple<StorageOf<Ts>*...> mArrays{};
+
+        /// Driver of filtered views whose component array has no changes
+        inline static const SparseSet EMPTY_SET{};
+
+        /// Entities of the smallest component array (sparse storage)
+        const SparseSet* mDriver = nullptr;
+
+        /// Cache line granularity of the smallest component array, in elements
+        size_t mDriverLineElements = 1;
+
+        /// Matching archetypes (archetype storage)
+        std::vector<const Archetype*> mArchetypes;
+
+        /// Component type IDs in the order of Ts (archetype storage)
+        std::array<ComponentType, COMPONENT_COUNT> mTypes{};
+
+        bool mArchetypeMode = false;
+
+        /// Stamp given to components handed out for writing
+        ChangeTick mTick = 0;
+
+        /// Position in Ts of the component filtered by changedSince(), or NO_FILTER
+        size_t mFilterIndex = NO_FILTER;
+
+        /// Components must have changed after this tick to pass the filter
+        ChangeTick mFilterSince = 0;
+
+        template<typename T>
+        static constexpr size_t indexOf() {
+            constexpr std::array<bool, COMPONENT_COUNT> matches{ std::is_same_v<std::remove_const_t<T>, std::remove_const_t<Ts>>... };
+            for (size_t i = 0; i < COMPONENT_COUNT; ++i) {
+                if (matches[i]) {
+                    return i;
+                }
+            }
+            return COMPONENT_COUNT;
+        }
+
+        bool containsAll(Entity entity) const {
+            // Entities come from the driving array, so only the others need a check
+            return ((&std::get<StorageOf<Ts>*>(mArrays)->getEntitySet() == mDriver ||
+                std::get<StorageOf<Ts>*>(mArrays)->hasData(entity)) && ...);
+        }
+
+        template<typename T>
+        size_t sparseIndex(Entity entity, size_t denseIndex) const {
+            const StorageOf<T>* array = std::get<StorageOf<T>*>(mArrays);
+            // The driving array is already positioned; only the others need a lookup
+            return &array->getEntitySet() == mDriver ? denseIndex : array->getEntitySet().index(entity);
+        }
+
+        template<typename T>
+        T& sparseComponent(Entity entity, size_t denseIndex) const {
+            StorageOf<T>* array = std::get<StorageOf<T>*>(mArrays);
+            const size_t index = sparseIndex<T>(entity, denseIndex);
+            if constexpr (!std::is_const_v<T>) {
+                array->markChangedAtIndex(index, mTick);
+            }
+            return array->getDataAtIndex(index);
+        }
+
+        /// Checks an entity of the driving array against the change filter
+        bool passesFilter(Entity entity, size_t denseIndex) const {
+            if (mFilterIndex == NO_FILTER) {
+                return true;
+            }
+            ChangeTick stamp = 0;
+            [&]<size_t... I>(std::index_sequence<I...>) {
+                ((I == mFilterIndex ? void(stamp = std::get<I>(mArrays)->getChangeTickAtIndex(
+                    sparseIndex<Ts>(entity, denseIndex))) : void()), ...);
+            }(std::index_sequence_for<Ts...>{});
+            return stamp > mFilterSince;
+        }
+
+        /// Checks a chunk against the change filter
+        bool passesFilter(const Archetype& archetype, size_t chunk) const {
+            return mFilterIndex == NO_FILTER || archetype.getChangeTick(mTypes[mFilterIndex], chunk) > mFilterSince;
+        }
+
+        value_type sparseAt(size_t denseIndex) const {
+            Entity entity = (*mDriver)[denseIndex];
+            return value_type(entity, sparseComponent<Ts>(entity, denseIndex)...);
+        }
+
+        value_type archetypeAt(size_t archetypeIndex, size_t row) const {
+            const Archetype* archetype = mArchetypes[archetypeIndex];
+            return [&]<size_t... I>(std::index_sequence<I...>) {
+                ((std::is_const_v<Ts> ? void() : archetype->markChanged(mTypes[I], row, mTick)), ...);
+                return value_type(archetype->getEntity(row), *static_cast<Ts*>(archetype->getComponent(mTypes[I], row))...);
+            }(std::index_sequence_for<Ts...>{});
+        }
+
+        template<typename Func>
+        void eachInRange(Func& func, size_t begin, size_t end) const {
+            const SparseSet& driver = *mDriver;
+            for (size_t i = begin; i < end; ++i) {
+                Entity entity = driver[i];
+                if (containsAll(entity) && passesFilter(entity, i)) {
+                    invoke(func, entity, sparseComponent<Ts>(entity, i)...);
+                }
+            }
+        }
+
+        template<typename Func>
+        void eachInChunk(Func& func, const Archetype& archetype, size_t chunk) const {
+            if (!passesFilter(archetype, chunk)) {
+                return;
+            }
+            const Entity* entities = archetype.getEntities(chunk);
+            const size_t count = archetype.getChunkSize(chunk);
+            [&]<size_t... I>(std::index_sequence<I...>) {
+                ((std::is_const_v<Ts> ? void() : archetype.markChunkChanged(mTypes[I], chunk, mTick)), ...);
+                std::tuple<Ts*...> columns{ static_cast<Ts*>(archetype.getColumn(mTypes[I], chunk))... };
+                for (size_t row = 0; row < count; ++row) {
+                    invoke(func, entities[row], std::get<I>(columns)[row]...);
+                }
+            }(std::index_sequence_for<Ts...>{});
+        }
+
+        /**
+         * @brief Elements of T that together start and end on a cache line
+         *
+         * Component chunks are cache-line aligned, so splitting a dense range
+         * at multiples of this count never splits a line between two jobs.
+         */
+        template<typename T>
+        static constexpr size_t lineElementsOf() {
+            return CACHE_LINE_SIZE / std::gcd(CACHE_LINE_SIZE, sizeof(T));
+        }
+
+        template<typename Func>
+        static void invoke(Func& func, Entity entity, Ts&... components) {
+            if constexpr (std::is_invocable_v<Func&, Entity, Ts&...>) {
+                func(entity, components...);
+            } else {
+                func(components...);
+            }
+        }
+
+    public:
+        /**
+         * @brief Forward iterator over matching entities
+         */
+        class Iterator {
+        private:
+            const View* mView = nullptr;
+            size_t mOuter = 0; // Archetype index (archetype storage only)
+            size_t mInner = 0; // Dense index or row
+
+            void skipToValid() {
+                if (mView->mArchetypeMode) {
+                    while (mOuter < mView->mArchetypes.size()) {
+                        const Archetype& archetype = *mView->mArchetypes[mOuter];
+                        if (mInner >= archetype.size()) {
+                            ++mOuter;
+                            mInner = 0;
+                        } else if (!mView->passesFilter(archetype, mInner / archetype.getChunkCapacity())) {
+                            // Skip the rest of the chunk
+                            mInner = (mInner / archetype.getChunkCapacity() + 1) * archetype.getChunkCapacity();
+                        } else {
+                            break;
+                        }
+                    }
+                } else {
+                    const SparseSet& driver = *mView->mDriver;
+                    while (mInner < driver.size() &&
+                        !(mView->containsAll(driver[mInner]) && mView->passesFilter(driver[mInner], mInner))) {
+                        ++mInner;
+                    }
+                }
+            }
+
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = View::value_type;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = value_type;
+
+            Iterator() = default;
+
+            Iterator(const View* view, size_t outer, size_t inner)
+                : mView(view), mOuter(outer), mInner(inner) {
+                skipToValid();
+            }
+
+            value_type operator*() const {
+                return mView->mArchetypeMode ? mView->archetypeAt(mOuter, mInner) : mView->sparseAt(mInner);
+            }
+
+            Iterator& operator++() {
+                ++mInner;
+                skipToValid();
+                return *this;
+            }
+
+            Iterator operator++(int) {
+                Iterator previous = *this;
+                ++*this;
+                return previous;
+            }
+
+            bool operator==(const Iterator& other) const {
+                return mOuter == other.mOuter && mInner == other.mInner;
+            }
+        };
+
+        /**
+         * @brief Builds a view over sparse component arrays
+         * @param tick Stamp for components handed out for writing
+         * @param arrays One component array per type in Ts
+         */
+        explicit View(ChangeTick tick, StorageOf<Ts>&... arrays)
+            : mArrays(&arrays...), mTick(tick) {
+            // Raised up front so that parallel iteration only stamps elements
+            ((std::is_const_v<Ts> ? void() : arrays.raiseVersion(tick)), ...);
+
+            const std::array<const SparseSet*, COMPONENT_COUNT> sets{ &arrays.getEntitySet()... };
+            const std::array<size_t, COMPONENT_COUNT> lineElements{ lineElementsOf<Ts>()... };
+            const size_t driver = std::min_element(sets.begin(), sets.end(), [](const SparseSet* a, const SparseSet* b) {
+                return a->size() < b->size();
+            }) - sets.begin();
+            mDriver = sets[driver];
+            mDriverLineElements = lineElements[driver];
+        }
+
+        /**
+         * @brief Builds a view over archetype storage
+         * @param storage Archetype storage to read
+         * @param types Component type IDs in the order of Ts
+         * @param tick Stamp for components handed out for writing
+         */
+        View(const ArchetypeStorage& storage, const std::array<ComponentType, COMPONENT_COUNT>& types, ChangeTick tick)
+            : mTypes(types), mArchetypeMode(true), mTick(tick) {
+            Signature required;
+            for (ComponentType type : types) {
+                required.set(type);
+            }
+            storage.forEachArchetype(required, [this](const Archetype& archetype) {
+                mArchetypes.push_back(&archetype);
+            });
+        }
+
+        Iterator begin() const {
+            return Iterator(this, 0, 0);
+        }
+
+        Iterator end() const {
+            return mArchetypeMode ? Iterator(this, mArchetypes.size(), 0) : Iterator(this, 0, mDriver->size());
+        }
+
+        /**
+         * @brief Gets a copy of this view restricted to recently changed entities
+         *
+         * Only entities whose component T was stamped after the given tick
+         * are visited. With archetype storage the test is per chunk, so
+         * unchanged entities that share a chunk with a changed one are
+         * visited too. Removing a component is not a change of it.
+         *
+         * @tparam T One of the viewed component types
+         * @param tick Tick kept from Coordinator::advanceChangeTick() on the previous run
+         * @return Filtered view
+         */
+        template<typename T>
+        View changedSince(ChangeTick tick) const {
+            static_assert(indexOf<T>() < COMPONENT_COUNT, "changedSince needs one of the viewed component types.");
+
+            View filtered = *this;
+            filtered.mFilterIndex = indexOf<T>();
+            filtered.mFilterSince = tick;
+            if (!mArchetypeMode && std::get<indexOf<T>()>(mArrays)->getVersion() <= tick) {
+                // Nothing in the array changed: iterate an empty range
+                filtered.mDriver = &EMPTY_SET;
+            }
+            return filtered;
+        }
+
+        /**
+         * @brief Calls a function for every matching entity
+         *
+         * This is the fastest way to visit a view: with archetype storage it
+         * walks chunk columns directly.
+         *
+         * @param func Callable taking (Entity, Ts&...) or (Ts&...)
+         */
+        template<typename Func>
+        void each(Func func) const {
+            if (!mArchetypeMode) {
+                eachInRange(func, 0, mDriver->size());
+                return;
+            }
+
+            for (const Archetype* archetype : mArchetypes) {
+                for (size_t chunk = 0; chunk < archetype->getChunkCount(); ++chunk) {
+                    eachInChunk(func, *archetype, chunk);
+                }
+            }
+        }
+
+        /**
+         * @brief Calls a function for every matching entity, spread over a job pool
+         *
+         * The matching range is cut into jobs of at most grainSize entities.
+         * With sparse storage, job boundaries are rounded to whole cache lines
+         * of the iterated component array so that two jobs never write to the
+         * same line; with archetype storage, jobs are made of whole chunks.
+         *
+         * Every entity is visited by exactly one job, so the function may write
+         * to the components it receives. It must not touch other entities'
+         * components, add or remove components, or destroy entities.
+         *
+         * @param jobs Pool that runs the jobs (the calling thread helps)
+         * @param func Callable taking (Entity, Ts&...) or (Ts&...); called concurrently
+         * @param grainSize Target number of entities per job
+         */
+        template<typename Func>
+        void parallelForEach(JobSystem& jobs, const Func& func, size_t grainSize = DEFAULT_GRAIN_SIZE) const {
+            if (!mArchetypeMode) {
+                const size_t grain = alignGrain(grainSize, mDriverLineElements);
+                jobs.parallelFor(mDriver->size(), grain, [this, &func](size_t begin, size_t end) {
+                    eachInRange(func, begin, end);
+                });
+                return;
+            }
+
+            std::vector<std::pair<const Archetype*, size_t>> chunks;
+            size_t smallestChunk = std::numeric_limits<size_t>::max();
+            for (const Archetype* archetype : mArchetypes) {
+                smallestChunk = std::min(smallestChunk, archetype->getChunkCapacity());
+                for (size_t chunk = 0; chunk < archetype->getChunkCount(); ++chunk) {
+                    if (passesFilter(*archetype, chunk)) {
+                        chunks.emplace_back(archetype, chunk);
+                    }
+                }
+            }
+            if (chunks.empty()) {
+                return;
+            }
+
+            const size_t chunksPerJob = std::max<size_t>(1, grainSize / smallestChunk);
+            jobs.parallelFor(chunks.size(), chunksPerJob, [this, &func, &chunks](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    eachInChunk(func, *chunks[i].first, chunks[i].second);
+                }
+            });
+        }
+
+        /**
+         * @brief Rounds a grain size up to whole cache lines of an array
+         * @param grainSize Requested entities per job
+         * @param lineElements Elements after which the array starts a new cache line
+         * @return Grain that is a non-zero multiple of lineElements
+         */
+        static constexpr size_t alignGrain(size_t grainSize, size_t lineElements) {
+            const size_t lines = (std::max<size_t>(grainSize, 1) + lineElements - 1) / lineElements;
+            return lines * lineElements;
+        }
+
+        /**
+         * @brief Gets an upper bound on the number of matching entities
+         *
+         * Exact for archetype storage; for sparse storage this is the size of
+         * the smallest component array.
+         */
+        size_t sizeHint() const {
+            if (!mArchetypeMode) {
+                return mDriver->size();
+            }
+            size_t count = 0;
+            for (const Archetype* archetype : mArchetypes) {
+                count += archetype->size();
+            }
+            return count;
+        }
+    };
+
+} // namespace ecs
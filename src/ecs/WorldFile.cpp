@@ -0,0 +1,439 @@
+#include "WorldFile.h"
+#include <fstream>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ecs {
+
+    namespace {
+        constexpr std::array<char, 4> WORLD_FILE_MAGIC = { 'E', 'C', 'S', 'W' };
+        constexpr std::uint32_t WORLD_FILE_BYTE_ORDER = 0x01020304;
+
+        size_t alignToFile(size_t value) {
+            return (value + WORLD_FILE_ALIGNMENT - 1) / WORLD_FILE_ALIGNMENT * WORLD_FILE_ALIGNMENT;
+        }
+
+        /**
+         * @brief Byte buffer a world file is assembled in before writing
+         */
+        class FileBuilder {
+        private:
+            std::vector<std::byte> mBytes;
+
+        public:
+            /// Appends zeroed space on a section boundary and returns its offset
+            size_t allocate(size_t size) {
+                const size_t offset = alignToFile(mBytes.size());
+                mBytes.resize(offset + size);
+                return offset;
+            }
+
+            std::byte* at(size_t offset) {
+                return mBytes.data() + offset;
+            }
+
+            void write(size_t offset, const void* data, size_t size) {
+                if (size > 0) {
+                    std::memcpy(at(offset), data, size);
+                }
+            }
+
+            const std::vector<std::byte>& bytes() const {
+                return mBytes;
+            }
+        };
+
+        /// Column of a file being loaded, matched against the schema
+        struct LoadedColumn {
+            const WorldSchema::Column* column;
+            WorldFileColumn record;
+            std::span<const Entity> entities;
+        };
+    }
+
+#ifdef _WIN32
+    MappedFile::MappedFile(const std::string& path) {
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            throw std::runtime_error("Cannot open " + path);
+        }
+
+        LARGE_INTEGER size{};
+        GetFileSizeEx(file, &size);
+        mSize = static_cast<size_t>(size.QuadPart);
+
+        HANDLE mapping = mSize > 0 ? CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr) : nullptr;
+        CloseHandle(file);
+        if (mSize > 0 && !mapping) {
+            throw std::runtime_error("Cannot map " + path);
+        }
+        if (mapping) {
+            // The view keeps the mapping object alive
+            mData = static_cast<std::byte*>(MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0));
+            CloseHandle(mapping);
+            if (!mData) {
+                throw std::runtime_error("Cannot map " + path);
+            }
+        }
+    }
+
+    MappedFile::~MappedFile() {
+        if (mData) {
+            UnmapViewOfFile(mData);
+        }
+    }
+#else
+    MappedFile::MappedFile(const std::string& path) {
+        const int file = ::open(path.c_str(), O_RDONLY);
+        if (file < 0) {
+            throw std::runtime_error("Cannot open " + path);
+        }
+
+        struct stat status {};
+        if (::fstat(file, &status) != 0) {
+            ::close(file);
+            throw std::runtime_error("Cannot read size of " + path);
+        }
+        mSize = static_cast<size_t>(status.st_size);
+
+        if (mSize > 0) {
+            // Private mapping: writes go to copies of the pages, never to the file
+            void* address = ::mmap(nullptr, mSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0);
+            if (address == MAP_FAILED) {
+                ::close(file);
+                throw std::runtime_error("Cannot map " + path);
+            }
+            mData = static_cast<std::byte*>(address);
+        }
+        ::close(file);
+    }
+
+    MappedFile::~MappedFile() {
+        if (mData) {
+            ::munmap(mData, mSize);
+        }
+    }
+#endif
+
+    void Coordinator::saveWorld(const std::string& path, const WorldSchema& schema) const {
+        // Every component type in use needs a column
+        Signature used;
+        mEntityManager->forEachEntity([this, &used](Entity entity) {
+            used |= mEntityManager->getSignature(entity);
+        });
+        used.forEachSet([&schema](size_t type) {
+            if (!schema.find(static_cast<ComponentType>(type))) {
+                throw std::runtime_error("Component type " + std::to_string(type) + " is not in the world schema");
+            }
+        });
+
+        const std::span<const WorldSchema::Column> columns = schema.getColumns();
+        const std::span<const Entity> slots = mEntityManager->getSlots();
+
+        FileBuilder file;
+        WorldFileHeader header{};
+        header.magic = WORLD_FILE_MAGIC;
+        header.version = WORLD_FILE_VERSION;
+        header.byteOrder = WORLD_FILE_BYTE_ORDER;
+        header.columnCount = static_cast<std::uint32_t>(columns.size());
+        header.slotCount = slots.size();
+        header.livingEntityCount = mEntityManager->getLivingEntityCount();
+        header.freeHead = mEntityManager->getFreeHead();
+
+        const size_t headerOffset = file.allocate(sizeof(WorldFileHeader));
+        header.columnsOffset = file.allocate(columns.size() * sizeof(WorldFileColumn));
+        header.slotsOffset = file.allocate(slots.size_bytes());
+        file.write(header.slotsOffset, slots.data(), slots.size_bytes());
+
+        std::vector<Entity> entities;
+        std::vector<std::byte> values;
+        std::vector<std::byte> encoded;
+        std::vector<std::uint64_t> encodedOffsets;
+        for (size_t index = 0; index < columns.size(); ++index) {
+            const WorldSchema::Column& column = columns[index];
+            WorldFileColumn record{};
+            std::copy(column.name.begin(), column.name.end(), record.name.begin());
+            record.kind = column.kind;
+            record.elementSize = static_cast<std::uint32_t>(column.elementSize);
+            record.chunkElements = column.chunkElements;
+            record.chunkStride = alignToFile(column.chunkElements * column.elementSize);
+
+            Signature required;
+            required.set(column.type);
+
+            if (column.kind == WorldColumnKind::Raw && !mArchetypeStorage) {
+                // Dense array chunks already have the file layout
+                const IComponentArray* array = mComponentManager->getArray(column.type);
+                const std::span<const Entity> owners = array ? array->getEntities() : std::span<const Entity>();
+                const size_t chunkCount = (owners.size() + column.chunkElements - 1) / column.chunkElements;
+
+                record.count = owners.size();
+                record.entitiesOffset = file.allocate(owners.size_bytes());
+                file.write(record.entitiesOffset, owners.data(), owners.size_bytes());
+                record.valuesOffset = file.allocate(chunkCount * record.chunkStride);
+                for (size_t chunk = 0; chunk < chunkCount; ++chunk) {
+                    const size_t elements = std::min(column.chunkElements, owners.size() - chunk * column.chunkElements);
+                    file.write(record.valuesOffset + chunk * record.chunkStride, array->getChunkData(chunk), elements * column.elementSize);
+                }
+            } else if (column.kind == WorldColumnKind::Raw) {
+                // Gather the column from every archetype that has it
+                entities.clear();
+                values.clear();
+                mArchetypeStorage->forEachChunk(required, [&](const Archetype& archetype, size_t chunk) {
+                    const size_t rows = archetype.getChunkSize(chunk);
+                    const Entity* owners = archetype.getEntities(chunk);
+                    const auto* components = static_cast<const std::byte*>(archetype.getColumn(column.type, chunk));
+                    entities.insert(entities.end(), owners, owners + rows);
+                    values.insert(values.end(), components, components + rows * column.elementSize);
+                });
+                const size_t chunkCount = (entities.size() + column.chunkElements - 1) / column.chunkElements;
+
+                record.count = entities.size();
+                record.entitiesOffset = file.allocate(entities.size() * sizeof(Entity));
+                file.write(record.entitiesOffset, entities.data(), entities.size() * sizeof(Entity));
+                record.valuesOffset = file.allocate(chunkCount * record.chunkStride);
+                for (size_t chunk = 0; chunk < chunkCount; ++chunk) {
+                    const size_t first = chunk * column.chunkElements;
+                    const size_t elements = std::min(column.chunkElements, entities.size() - first);
+                    file.write(record.valuesOffset + chunk * record.chunkStride, values.data() + first * column.elementSize,
+                        elements * column.elementSize);
+                }
+            } else {
+                // Tags and encoded components are listed in slot order
+                entities.clear();
+                mEntityManager->forEachMatching(required, [&entities](Entity entity) {
+                    entities.push_back(entity);
+                });
+
+                record.count = entities.size();
+                record.entitiesOffset = file.allocate(entities.size() * sizeof(Entity));
+                file.write(record.entitiesOffset, entities.data(), entities.size() * sizeof(Entity));
+
+                if (column.kind == WorldColumnKind::Encoded) {
+                    encoded.clear();
+                    encodedOffsets.clear();
+                    EncodedWriter writer(encoded);
+                    for (Entity entity : entities) {
+                        encodedOffsets.push_back(encoded.size());
+                        column.encode(*this, entity, writer);
+                    }
+                    encodedOffsets.push_back(encoded.size());
+
+                    const size_t tableBytes = encodedOffsets.size() * sizeof(std::uint64_t);
+                    record.valuesOffset = file.allocate(tableBytes + encoded.size());
+                    file.write(record.valuesOffset, encodedOffsets.data(), tableBytes);
+                    file.write(record.valuesOffset + tableBytes, encoded.data(), encoded.size());
+                }
+            }
+
+            file.write(header.columnsOffset + index * sizeof(WorldFileColumn), &record, sizeof(record));
+        }
+        file.write(headerOffset, &header, sizeof(header));
+
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(file.bytes().data()), static_cast<std::streamsize>(file.bytes().size()));
+        if (!out) {
+            throw std::runtime_error("Cannot write world file " + path);
+        }
+    }
+
+    void Coordinator::loadWorld(const std::string& path, const WorldSchema& schema) {
+        assert(mEntityManager->getEntitySlotCount() == 0 && "World files load into a coordinator without entities.");
+
+        auto file = std::make_shared<MappedFile>(path);
+        std::byte* const data = file->data();
+        const size_t fileSize = file->size();
+
+        auto fail = [&path](const std::string& reason) {
+            throw std::runtime_error("World file " + path + ": " + reason);
+        };
+        auto checkRange = [&](std::uint64_t offset, std::uint64_t count, std::uint64_t elementSize) {
+            if (offset % WORLD_FILE_ALIGNMENT != 0 || offset > fileSize || count > (fileSize - offset) / std::max<std::uint64_t>(elementSize, 1)) {
+                fail("section out of bounds");
+            }
+        };
+
+        WorldFileHeader header;
+        if (fileSize < sizeof(header)) {
+            fail("too small");
+        }
+        std::memcpy(&header, data, sizeof(header));
+        if (header.magic != WORLD_FILE_MAGIC) {
+            fail("not a world file");
+        }
+        if (header.byteOrder != WORLD_FILE_BYTE_ORDER) {
+            fail("written with another byte order");
+        }
+        if (header.version != WORLD_FILE_VERSION) {
+            fail("format version " + std::to_string(header.version) + ", expected " + std::to_string(WORLD_FILE_VERSION));
+        }
+        checkRange(header.columnsOffset, header.columnCount, sizeof(WorldFileColumn));
+        checkRange(header.slotsOffset, header.slotCount, sizeof(Entity));
+        if (header.slotCount >= MAX_ENTITIES || header.livingEntityCount > header.slotCount) {
+            fail("entity table does not fit");
+        }
+        const std::span<const Entity> slots(reinterpret_cast<const Entity*>(data + header.slotsOffset), header.slotCount);
+
+        // A slot holding its own index is alive; the others link the free list
+        size_t livingCount = 0;
+        for (size_t index = 0; index < slots.size(); ++index) {
+            livingCount += entityIndex(slots[index]) == index ? 1 : 0;
+        }
+        if (livingCount != header.livingEntityCount) {
+            fail("living entity count does not match the entity table");
+        }
+        // The list must visit every free slot once: a walk that ends within that many steps has no cycle
+        const size_t freeCount = slots.size() - livingCount;
+        size_t visited = 0;
+        for (Entity slot = header.freeHead; slot != EntityManager::NULL_INDEX; slot = entityIndex(slots[slot])) {
+            if (visited == freeCount || slot >= slots.size() || entityIndex(slots[slot]) == slot) {
+                fail("free slot list does not match the entity table");
+            }
+            ++visited;
+        }
+        if (visited != freeCount) {
+            fail("free slot list does not match the entity table");
+        }
+
+        // Match every column with the schema before touching the world
+        std::vector<LoadedColumn> loaded;
+        loaded.reserve(header.columnCount);
+        Signature loadedTypes;
+        // Column that last claimed each slot, plus one, to catch an entity listed twice
+        std::vector<std::uint32_t> ownerColumn(slots.size(), 0);
+        for (size_t index = 0; index < header.columnCount; ++index) {
+            WorldFileColumn record;
+            std::memcpy(&record, data + header.columnsOffset + index * sizeof(WorldFileColumn), sizeof(record));
+            record.name.back() = '\0';
+            const std::string name = record.name.data();
+
+            const WorldSchema::Column* column = schema.find(std::string_view(name));
+            if (!column) {
+                fail("component " + name + " is not in the schema");
+            }
+            if (record.kind != column->kind || record.elementSize != column->elementSize || record.chunkElements != column->chunkElements) {
+                fail("component " + name + " was saved with another layout");
+            }
+            if (!mComponentManager->isRegistered(column->type)) {
+                fail("component " + name + " is not registered");
+            }
+            if (loadedTypes.test(column->type)) {
+                fail("component " + name + " is stored twice");
+            }
+            loadedTypes.set(column->type);
+
+            checkRange(record.entitiesOffset, record.count, sizeof(Entity));
+            if (record.kind == WorldColumnKind::Raw) {
+                const std::uint64_t chunkCount = (record.count + record.chunkElements - 1) / record.chunkElements;
+                if (record.chunkStride < record.chunkElements * record.elementSize || record.chunkStride % WORLD_FILE_ALIGNMENT != 0) {
+                    fail("component " + name + " has a bad chunk stride");
+                }
+                checkRange(record.valuesOffset, chunkCount, record.chunkStride);
+            } else if (record.kind == WorldColumnKind::Encoded) {
+                checkRange(record.valuesOffset, record.count + 1, sizeof(std::uint64_t));
+                const auto* offsets = reinterpret_cast<const std::uint64_t*>(data + record.valuesOffset);
+                const size_t available = fileSize - static_cast<size_t>(record.valuesOffset + (record.count + 1) * sizeof(std::uint64_t));
+                for (size_t i = 0; i < record.count; ++i) {
+                    if (offsets[i] > offsets[i + 1] || offsets[i + 1] > available) {
+                        fail("component " + name + " has a bad encoded value");
+                    }
+                }
+            }
+
+            const std::span<const Entity> owners(reinterpret_cast<const Entity*>(data + record.entitiesOffset), record.count);
+            const auto columnMark = static_cast<std::uint32_t>(index + 1);
+            for (Entity entity : owners) {
+                if (entityIndex(entity) >= slots.size() || slots[entityIndex(entity)] != entity) {
+                    fail("component " + name + " belongs to a dead entity");
+                }
+                if (ownerColumn[entityIndex(entity)] == columnMark) {
+                    fail("component " + name + " is stored twice for one entity");
+                }
+                ownerColumn[entityIndex(entity)] = columnMark;
+            }
+            loaded.push_back({ column, record, owners });
+        }
+
+        mEntityManager->assignSlots(slots, header.freeHead, header.livingEntityCount);
+
+        // Signatures are rebuilt from the entity lists, in this process's type IDs
+        Signature rawTypes;
+        for (const LoadedColumn& column : loaded) {
+            if (column.record.kind == WorldColumnKind::Encoded) {
+                continue;
+            }
+            for (Entity entity : column.entities) {
+                Signature signature = mEntityManager->getSignature(entity);
+                signature.set(column.column->type);
+                mEntityManager->setSignature(entity, signature);
+            }
+            if (column.record.kind == WorldColumnKind::Raw) {
+                rawTypes.set(column.column->type);
+            }
+        }
+
+        const ChangeTick tick = getChangeTick();
+        if (mArchetypeStorage) {
+            // Place every entity in its final archetype once, then copy the columns in
+            mEntityManager->forEachEntity([this, &rawTypes, tick](Entity entity) {
+                const Signature stored = mEntityManager->getSignature(entity) & rawTypes;
+                if (stored.any()) {
+                    mArchetypeStorage->allocateEntity(entity, stored, tick);
+                }
+            });
+            for (const LoadedColumn& column : loaded) {
+                if (column.record.kind != WorldColumnKind::Raw) {
+                    continue;
+                }
+                const std::byte* values = data + column.record.valuesOffset;
+                for (size_t i = 0; i < column.entities.size(); ++i) {
+                    const std::byte* value = values + i / column.record.chunkElements * column.record.chunkStride +
+                        i % column.record.chunkElements * column.record.elementSize;
+                    std::memcpy(mArchetypeStorage->getComponent(column.entities[i], column.column->type), value, column.record.elementSize);
+                }
+            }
+        } else {
+            // The mapped chunks become the component storage
+            bool adopted = false;
+            for (const LoadedColumn& column : loaded) {
+                if (column.record.kind == WorldColumnKind::Raw) {
+                    mComponentManager->getArray(column.column->type)->adoptChunks(column.entities,
+                        data + column.record.valuesOffset, column.record.chunkStride, tick);
+                    adopted = adopted || !column.entities.empty();
+                }
+            }
+            if (adopted) {
+                mMappedFiles.push_back(file);
+            }
+        }
+
+        for (const LoadedColumn& column : loaded) {
+            if (column.record.kind != WorldColumnKind::Encoded) {
+                continue;
+            }
+            // Offsets were checked with the column
+            const auto* offsets = reinterpret_cast<const std::uint64_t*>(data + column.record.valuesOffset);
+            const std::byte* bytes = data + column.record.valuesOffset + (column.record.count + 1) * sizeof(std::uint64_t);
+            for (size_t i = 0; i < column.entities.size(); ++i) {
+                EncodedReader reader(std::span<const std::byte>(bytes + offsets[i], bytes + offsets[i + 1]));
+                column.column->decode(*this, column.entities[i], reader);
+            }
+        }
+
+        mSystemManager->rebuildEntityLists(*mEntityManager);
+    }
+
+} // namespace ecs
@@ -0,0 +1,283 @@
+#pragma once
+
+#include "Coordinator.h"
+#include "ChunkedArray.h"
+#include "ECSTypes.h"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace ecs {
+
+    /*
+     * World file layout (all integers in the writer's byte order, checked
+     * with WorldFileHeader::byteOrder; every section starts on a
+     * WORLD_FILE_ALIGNMENT boundary):
+     *
+     *   WorldFileHeader
+     *   WorldFileColumn[columnCount]
+     *   Entity slot table[slotCount]
+     *   per column: owning entities[count], then the values
+     *
+     * Raw columns store their values in ChunkedArray layout: chunks of
+     * chunkElements values, chunkStride bytes apart, so a loader can use
+     * the mapped chunks directly as ComponentArray storage. Encoded columns
+     * store (count + 1) byte offsets followed by the encoded bytes.
+     * Signatures are not stored; they are rebuilt from the column entity
+     * lists, so component type IDs may differ between writer and reader.
+     */
+
+    /// Format version, raised on every incompatible layout change
+    static constexpr std::uint32_t WORLD_FILE_VERSION = 1;
+
+    /// Alignment of every section of a world file
+    static constexpr size_t WORLD_FILE_ALIGNMENT = CACHE_LINE_SIZE;
+
+    /// Longest component name a world file can store, including the terminator
+    static constexpr size_t WORLD_FILE_NAME_SIZE = 48;
+
+    /**
+     * @brief How a column stores its components
+     */
+    enum class WorldColumnKind : std::uint32_t {
+        /// Tag component: entity list only
+        Tag,
+        /// Trivially copyable component: raw bytes in ChunkedArray layout
+        Raw,
+        /// Other component: bytes produced by an encoder, one run per entity
+        Encoded
+    };
+
+    /**
+     * @brief Fixed-size header at the start of a world file
+     */
+    struct WorldFileHeader {
+        std::array<char, 4> magic;
+        std::uint32_t version;
+        std::uint32_t byteOrder;
+        std::uint32_t columnCount;
+        std::uint64_t columnsOffset;
+        std::uint64_t slotCount;
+        std::uint64_t slotsOffset;
+        std::uint64_t livingEntityCount;
+        std::uint32_t freeHead;
+        std::uint32_t reserved;
+    };
+
+    /**
+     * @brief Description of one component column in a world file
+     */
+    struct WorldFileColumn {
+        std::array<char, WORLD_FILE_NAME_SIZE> name;
+        WorldColumnKind kind;
+        std::uint32_t elementSize;
+        std::uint64_t count;
+        std::uint64_t entitiesOffset;
+        std::uint64_t valuesOffset;
+        std::uint64_t chunkElements;
+        std::uint64_t chunkStride;
+    };
+
+    static_assert(std::is_trivially_copyable_v<WorldFileHeader> && std::is_trivially_copyable_v<WorldFileColumn>,
+        "World file records are written as raw bytes.");
+
+    /**
+     * @brief Read-only file mapped into memory with copy-on-write pages
+     *
+     * Writing through data() changes only this process's copy; the file on
+     * disk is never modified.
+     */
+    class MappedFile {
+    private:
+        std::byte* mData = nullptr;
+        size_t mSize = 0;
+
+    public:
+        /**
+         * @brief Maps a whole file
+         * @param path File to map
+         * @throws std::runtime_error if the file cannot be opened or mapped
+         */
+        explicit MappedFile(const std::string& path);
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        std::byte* data() const { return mData; }
+        size_t size() const { return mSize; }
+    };
+
+    /**
+     * @brief Appends the encoded form of a component (see WorldSchema::add)
+     */
+    class EncodedWriter {
+    private:
+        std::vector<std::byte>& mBytes;
+
+    public:
+        explicit EncodedWriter(std::vector<std::byte>& bytes) : mBytes(bytes) {}
+
+        /**
+         * @brief Appends a trivially copyable value
+         */
+        template<typename T>
+        void write(const T& value) {
+            static_assert(std::is_trivially_copyable_v<T>, "Encoded values are copied as raw bytes.");
+            const auto* bytes = reinterpret_cast<const std::byte*>(&value);
+            mBytes.insert(mBytes.end(), bytes, bytes + sizeof(T));
+        }
+
+        /**
+         * @brief Appends a string as its length followed by its characters
+         */
+        void writeString(std::string_view text) {
+            write(static_cast<std::uint32_t>(text.size()));
+            const auto* bytes = reinterpret_cast<const std::byte*>(text.data());
+            mBytes.insert(mBytes.end(), bytes, bytes + text.size());
+        }
+    };
+
+    /**
+     * @brief Reads back what an EncodedWriter wrote, in the same order
+     */
+    class EncodedReader {
+    private:
+        std::span<const std::byte> mBytes;
+
+        std::span<const std::byte> take(size_t size) {
+            if (size > mBytes.size()) {
+                throw std::runtime_error("Encoded component is truncated");
+            }
+            std::span<const std::byte> taken = mBytes.first(size);
+            mBytes = mBytes.subspan(size);
+            return taken;
+        }
+
+    public:
+        explicit EncodedReader(std::span<const std::byte> bytes) : mBytes(bytes) {}
+
+        /**
+         * @brief Reads a trivially copyable value
+         */
+        template<typename T>
+        T read() {
+            static_assert(std::is_trivially_copyable_v<T>, "Encoded values are copied as raw bytes.");
+            T value;
+            std::memcpy(&value, take(sizeof(T)).data(), sizeof(T));
+            return value;
+        }
+
+        /**
+         * @brief Reads a string written by EncodedWriter::writeString()
+         */
+        std::string readString() {
+            const std::span<const std::byte> characters = take(read<std::uint32_t>());
+            return std::string(reinterpret_cast<const char*>(characters.data()), characters.size());
+        }
+    };
+
+    /**
+     * @brief Names and storage formats of the component types in a world file
+     *
+     * Component type IDs depend on the order types are first used, so world
+     * files identify columns by the name given here. Tags and trivially
+     * copyable components need only a name; other components also need an
+     * encoder and a decoder, and are loaded one entity at a time.
+     */
+    class WorldSchema {
+    public:
+        struct Column {
+            std::string name;
+            ComponentType type;
+            WorldColumnKind kind;
+            size_t elementSize;
+            size_t chunkElements;
+            std::function<void(const Coordinator&, Entity, EncodedWriter&)> encode;
+            std::function<void(Coordinator&, Entity, EncodedReader&)> decode;
+        };
+
+    private:
+        std::vector<Column> mColumns;
+
+        void addColumn(Column column) {
+            assert(column.name.size() < WORLD_FILE_NAME_SIZE && "World file component name too long.");
+            assert(!find(column.name) && !find(column.type) && "Component listed twice in world schema.");
+            mColumns.push_back(std::move(column));
+        }
+
+    public:
+        /**
+         * @brief Adds a tag or trivially copyable component type
+         * @tparam T Component type
+         * @param name Name stored in the file
+         */
+        template<typename T>
+        WorldSchema& add(std::string name) {
+            static_assert(std::is_trivially_copyable_v<T>, "Components that are not trivially copyable need an encoder and a decoder.");
+            if constexpr (isTagComponent<T>) {
+                addColumn({ std::move(name), ComponentManager::typeId<T>(), WorldColumnKind::Tag, 0, 0, {}, {} });
+            } else {
+                static_assert(alignof(T) <= WORLD_FILE_ALIGNMENT, "World file chunks are aligned to cache lines.");
+                addColumn({ std::move(name), ComponentManager::typeId<T>(), WorldColumnKind::Raw, sizeof(T), ChunkedArray<T>::CHUNK_SIZE, {}, {} });
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Adds a component type stored through an encoder
+         * @tparam T Component type
+         * @param name Name stored in the file
+         * @param encode Writes a component
+         * @param decode Reads a component back
+         */
+        template<typename T>
+        WorldSchema& add(std::string name, void (*encode)(const T&, EncodedWriter&), T (*decode)(EncodedReader&)) {
+            static_assert(!isTagComponent<T>, "Tags carry no data to encode.");
+            addColumn({ std::move(name), ComponentManager::typeId<T>(), WorldColumnKind::Encoded, 0, 0,
+                [encode](const Coordinator& coordinator, Entity entity, EncodedWriter& writer) {
+                    encode(coordinator.getComponent<T>(entity), writer);
+                },
+                [decode](Coordinator& coordinator, Entity entity, EncodedReader& reader) {
+                    coordinator.addComponent(entity, decode(reader));
+                } });
+            return *this;
+        }
+
+        /**
+         * @brief Finds a column by name
+         * @return The column, or nullptr
+         */
+        const Column* find(std::string_view name) const {
+            auto it = std::find_if(mColumns.begin(), mColumns.end(), [name](const Column& column) { return column.name == name; });
+            return it != mColumns.end() ? &*it : nullptr;
+        }
+
+        /**
+         * @brief Finds a column by component type ID
+         * @return The column, or nullptr
+         */
+        const Column* find(ComponentType type) const {
+            auto it = std::find_if(mColumns.begin(), mColumns.end(), [type](const Column& column) { return column.type == type; });
+            return it != mColumns.end() ? &*it : nullptr;
+        }
+
+        /**
+         * @brief Gets all columns, in the order they were added
+         */
+        std::span<const Column> getColumns() const {
+            return mColumns;
+        }
+    };
+
+} // namespace ecs
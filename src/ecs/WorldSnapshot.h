@@ -0,0 +1,289 @@
+#pragma once
+
+#include "ECSTypes.h"
+#include "ChunkedArray.h"
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace ecs {
+
+    /**
+     * @brief Copy of a Coordinator's entities and components, for save states and rollback
+     *
+     * Filled by Coordinator::snapshot() and applied by Coordinator::restore().
+     * The world is written as a sequence of blocks of at most BLOCK_BYTES
+     * (one component chunk, archetype chunk or slice of a packed array each)
+     * into a byte arena. The arena and block list keep their capacity, so
+     * taking snapshots repeatedly into the same object does not allocate
+     * once it has grown to the size of the world; reserve() preallocates.
+     *
+     * A delta snapshot is taken against a base snapshot and only stores the
+     * blocks whose bytes differ from the base's block at the same position;
+     * the others are read from the base on restore. The base (and its own
+     * base, for a chain of deltas) must outlive the delta and must not be
+     * retaken while the delta is in use.
+     *
+     * Only trivially copyable components can be stored, since they are
+     * copied as raw bytes.
+     */
+    class WorldSnapshot {
+    public:
+        /// Largest block; larger writes are split so deltas work at this granularity
+        static constexpr size_t BLOCK_BYTES = 16 * 1024;
+
+    private:
+        friend class SnapshotReader;
+
+        static constexpr size_t NOT_STORED = ~size_t{ 0 };
+        static constexpr size_t BLOCK_ALIGNMENT = 16;
+
+        struct Block {
+            size_t offset; // Position in mArena, or NOT_STORED when kept by the base
+            size_t size;
+        };
+
+        std::vector<std::byte> mArena;
+        size_t mUsedBytes = 0;
+        std::vector<Block> mBlocks;
+
+        /// Snapshot this one is a delta of, or nullptr
+        const WorldSnapshot* mBase = nullptr;
+
+        /// mBase->mSerial when this delta was taken
+        std::uint64_t mBaseSerial = 0;
+
+        /// Raised every time the snapshot is retaken
+        std::uint64_t mSerial = 0;
+
+        /// Coordinator the snapshot was taken from
+        const void* mSource = nullptr;
+
+        void appendBlock(const void* data, size_t size) {
+            const size_t index = mBlocks.size();
+            if (mBase) {
+                const std::span<const std::byte> previous = mBase->getBlock(index);
+                if (previous.size() == size && (size == 0 || std::memcmp(previous.data(), data, size) == 0)) {
+                    mBlocks.push_back({ NOT_STORED, size });
+                    return;
+                }
+            }
+
+            const size_t offset = (mUsedBytes + BLOCK_ALIGNMENT - 1) / BLOCK_ALIGNMENT * BLOCK_ALIGNMENT;
+            if (offset + size > mArena.size()) {
+                mArena.resize(std::max(offset + size, mArena.size() * 2));
+            }
+            if (size > 0) {
+                std::memcpy(mArena.data() + offset, data, size);
+            }
+            mUsedBytes = offset + size;
+            mBlocks.push_back({ offset, size });
+        }
+
+    public:
+        WorldSnapshot() = default;
+
+        WorldSnapshot(const WorldSnapshot&) = delete;
+        WorldSnapshot& operator=(const WorldSnapshot&) = delete;
+
+        /**
+         * @brief Preallocates the arena
+         * @param bytes Arena size to make room for
+         */
+        void reserve(size_t bytes) {
+            if (mArena.size() < bytes) {
+                mArena.resize(bytes);
+            }
+        }
+
+        /**
+         * @brief Starts a new snapshot, discarding the current contents (capacity is kept)
+         * @param source Coordinator being captured
+         * @param base Snapshot to take a delta against, or nullptr for a full snapshot
+         */
+        void begin(const void* source, const WorldSnapshot* base) {
+            assert(base != this && "A snapshot cannot be its own base.");
+            mUsedBytes = 0;
+            mBlocks.clear();
+            mBase = base;
+            mBaseSerial = base ? base->mSerial : 0;
+            mSource = source;
+            ++mSerial;
+        }
+
+        /**
+         * @brief Appends raw bytes, split into blocks of at most BLOCK_BYTES
+         * @param data Bytes to copy
+         * @param size Number of bytes
+         */
+        void write(const void* data, size_t size) {
+            const auto* bytes = static_cast<const std::byte*>(data);
+            do {
+                const size_t blockSize = std::min(size, BLOCK_BYTES);
+                appendBlock(bytes, blockSize);
+                bytes += blockSize;
+                size -= blockSize;
+            } while (size > 0);
+        }
+
+        /**
+         * @brief Appends one trivially copyable value
+         */
+        template<typename T>
+        void writeValue(const T& value) {
+            static_assert(std::is_trivially_copyable_v<T>, "Snapshot values are copied as raw bytes.");
+            appendBlock(&value, sizeof(T));
+        }
+
+        /**
+         * @brief Appends the elements of a chunked array, one block per chunk
+         */
+        template<typename T>
+        void writeChunked(const ChunkedArray<T>& array) {
+            static_assert(std::is_trivially_copyable_v<T>, "Snapshot values are copied as raw bytes.");
+            writeValue(array.size());
+            for (size_t first = 0, chunk = 0; first < array.size(); first += ChunkedArray<T>::CHUNK_SIZE, ++chunk) {
+                write(array.getChunk(chunk), std::min(ChunkedArray<T>::CHUNK_SIZE, array.size() - first) * sizeof(T));
+            }
+        }
+
+        /**
+         * @brief Gets the bytes of a block, following deltas to the snapshot that stores it
+         * @param index Block position
+         * @return The block, or an empty span past the last block
+         */
+        std::span<const std::byte> getBlock(size_t index) const {
+            if (index >= mBlocks.size()) {
+                return {};
+            }
+            const Block& block = mBlocks[index];
+            if (block.offset == NOT_STORED) {
+                assert(mBase && mBase->mSerial == mBaseSerial && "Base snapshot was retaken after this delta.");
+                return mBase->getBlock(index);
+            }
+            return { mArena.data() + block.offset, block.size };
+        }
+
+        /**
+         * @brief Checks whether this snapshot is a delta of another
+         */
+        bool isDelta() const {
+            return mBase != nullptr;
+        }
+
+        /**
+         * @brief Checks whether the snapshot holds anything
+         */
+        bool empty() const {
+            return mBlocks.empty();
+        }
+
+        /**
+         * @brief Gets the coordinator the snapshot was taken from
+         */
+        const void* getSource() const {
+            return mSource;
+        }
+
+        /**
+         * @brief Gets the number of blocks in the snapshot, stored or taken from the base
+         */
+        size_t getBlockCount() const {
+            return mBlocks.size();
+        }
+
+        /**
+         * @brief Gets the number of blocks stored in this snapshot itself
+         */
+        size_t getStoredBlockCount() const {
+            return static_cast<size_t>(std::count_if(mBlocks.begin(), mBlocks.end(),
+                [](const Block& block) { return block.offset != NOT_STORED; }));
+        }
+
+        /**
+         * @brief Gets the arena bytes used by this snapshot itself
+         */
+        size_t getStoredBytes() const {
+            return mUsedBytes;
+        }
+
+        /**
+         * @brief Gets the arena bytes allocated
+         */
+        size_t getCapacity() const {
+            return mArena.size();
+        }
+    };
+
+    /**
+     * @brief Reads the blocks of a WorldSnapshot back in the order they were written
+     */
+    class SnapshotReader {
+    private:
+        const WorldSnapshot& mSnapshot;
+        size_t mNextBlock = 0;
+
+    public:
+        explicit SnapshotReader(const WorldSnapshot& snapshot) : mSnapshot(snapshot) {}
+
+        /**
+         * @brief Gets the next block
+         */
+        std::span<const std::byte> next() {
+            assert(mNextBlock < mSnapshot.getBlockCount() && "Read past the end of the snapshot.");
+            return mSnapshot.getBlock(mNextBlock++);
+        }
+
+        /**
+         * @brief Copies bytes written by WorldSnapshot::write()
+         * @param destination Where to copy to
+         * @param size Number of bytes, as written
+         */
+        void read(void* destination, size_t size) {
+            auto* bytes = static_cast<std::byte*>(destination);
+            do {
+                const std::span<const std::byte> block = next();
+                assert(block.size() == std::min(size, WorldSnapshot::BLOCK_BYTES) && "Snapshot block size mismatch.");
+                if (!block.empty()) {
+                    std::memcpy(bytes, block.data(), block.size());
+                }
+                bytes += block.size();
+                size -= block.size();
+            } while (size > 0);
+        }
+
+        /**
+         * @brief Reads a value written by WorldSnapshot::writeValue()
+         */
+        template<typename T>
+        T readValue() {
+            static_assert(std::is_trivially_copyable_v<T>, "Snapshot values are copied as raw bytes.");
+            T value;
+            const std::span<const std::byte> block = next();
+            assert(block.size() == sizeof(T) && "Snapshot value size mismatch.");
+            std::memcpy(&value, block.data(), sizeof(T));
+            return value;
+        }
+
+        /**
+         * @brief Reads a chunked array written by WorldSnapshot::writeChunked()
+         *
+         * The array is resized without constructing elements, then every
+         * chunk is overwritten.
+         */
+        template<typename T>
+        void readChunked(ChunkedArray<T>& array) {
+            const size_t size = readValue<size_t>();
+            array.resizeForOverwrite(size);
+            for (size_t first = 0, chunk = 0; first < size; first += ChunkedArray<T>::CHUNK_SIZE, ++chunk) {
+                read(array.getChunk(chunk), std::min(ChunkedArray<T>::CHUNK_SIZE, size - first) * sizeof(T));
+            }
+        }
+    };
+
+} // namespace ecs
@@ -187,3 +187,4 @@ namespace ecs::components {
 
 // Include additional component types
 #include "Renderable2D.h"
+#include "Hierarchy.h"
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "../ECSTypes.h"
+#include <cstdint>
+
+namespace ecs::components {
+
+    /**
+     * @brief Parent of an entity in the ECS hierarchy, and its place among its siblings
+     *
+     * The parent handle is what defines the hierarchy. The sibling links
+     * form an intrusive list that HierarchySystem keeps in step with it:
+     * setParent() and removeParent() update the list at once, and a parent
+     * set any other way (for instance through the command buffer) is linked
+     * in by the next HierarchySystem::update(), after its existing siblings.
+     * Plain handles keep the component trivially copyable, so hierarchies
+     * can be snapshotted and stored as raw world file columns.
+     */
+    struct Parent {
+        Entity entity = NULL_ENTITY;
+        Entity previousSibling = NULL_ENTITY;
+        Entity nextSibling = NULL_ENTITY;
+
+        Parent() = default;
+
+        explicit Parent(Entity parent) : entity(parent) {}
+    };
+
+    /**
+     * @brief Ends of the intrusive list of an entity's direct children
+     *
+     * Walk it with HierarchySystem::forEachChild().
+     */
+    struct Children {
+        Entity first = NULL_ENTITY;
+        Entity last = NULL_ENTITY;
+        std::uint32_t count = 0;
+    };
+
+} // namespace ecs::components
@@ -90,4 +90,20 @@ namespace ecs::events {
         RawInputEvent(const SDL_Event& event) : sdlEvent(event) {}
     };
 
+    /**
+     * @brief Adds every input event type to an EventRecorder or EventReplay
+     *
+     * The names are the stable identity of the types in event logs, so a
+     * renamed struct still replays old recordings.
+     */
+    template<typename EventLog>
+    void addInputEventTypes(EventLog& log) {
+        log.template addType<MoveIntent>("MoveIntent");
+        log.template addType<FireIntent>("FireIntent");
+        log.template addType<UiSelect>("UiSelect");
+        log.template addType<SceneTransition>("SceneTransition");
+        log.template addType<PauseToggle>("PauseToggle");
+        log.template addType<RawInputEvent>("RawInputEvent");
+    }
+
 } // namespace ecs::events
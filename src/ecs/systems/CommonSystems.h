@@ -20,27 +20,40 @@ namespace ecs::systems {
          * @param coordinator Pointer to ECS coordinator
          */
         explicit PhysicsSystem(Coordinator* coordinator)
-            : mCoordinator(coordinator) {}
+            : mCoordinator(coordinator) {
+            declareWrites<components::Transform>();
+            declareReads<components::Velocity>();
+        }
 
         /**
          * @brief Updates physics for all entities with Transform and Velocity components
          * @param deltaTime Time elapsed since last update
          */
         void update(float deltaTime) override {
-            for (auto const& entity : mEntities) {
-                auto& transform = mCoordinator->getComponent<components::Transform>(entity);
-                auto& velocity = mCoordinator->getComponent<components::Velocity>(entity);
-
-                // Update position based on linear velocity
-                transform.position = transform.position + velocity.linear * deltaTime;
-
-                // Update rotation based on angular velocity (quaternion integration)
-                if (velocity.angular.length() > 0.0f) {
-                    float angle = velocity.angular.length() * deltaTime;
-                    math::Vec3f axis = velocity.angular.normalized();
-                    math::Quatf deltaRotation(angle, axis);
-                    transform.rotation = transform.rotation * deltaRotation;
-                }
+            // The view walks chunk columns directly when archetype storage is active
+            auto view = mCoordinator->view<components::Transform, const components::Velocity>();
+            auto step = [deltaTime](components::Transform& transform, const components::Velocity& velocity) {
+                integrate(transform, velocity, deltaTime);
+            };
+
+            if (JobSystem* jobs = mCoordinator->getJobSystem()) {
+                view.parallelForEach(*jobs, step);
+            } else {
+                view.each(step);
+            }
+        }
+
+    private:
+        static void integrate(components::Transform& transform, const components::Velocity& velocity, float deltaTime) {
+            // Update position based on linear velocity
+            transform.position = transform.position + velocity.linear * deltaTime;
+
+            // Update rotation based on angular velocity (quaternion integration)
+            if (velocity.angular.length() > 0.0f) {
+                float angle = velocity.angular.length() * deltaTime;
+                math::Vec3f axis = velocity.angular.normalized();
+                math::Quatf deltaRotation(angle, axis);
+                transform.rotation = transform.rotation * deltaRotation;
             }
         }
     };
@@ -58,7 +71,9 @@ namespace ecs::systems {
          * @param coordinator Pointer to ECS coordinator
          */
         explicit RenderSystem(Coordinator* coordinator)
-            : mCoordinator(coordinator) {}
+            : mCoordinator(coordinator) {
+            declareReads<components::Renderable>();
+        }
 
         /**
          * @brief Renders all entities with Transform and Renderable components
@@ -69,9 +84,7 @@ namespace ecs::systems {
             // For demonstration purposes, we'll just count visible entities
 
             size_t visibleCount = 0;
-            for (auto const& entity : mEntities) {
-                auto& renderable = mCoordinator->getComponent<components::Renderable>(entity);
-
+            for (auto [entity, renderable] : mCoordinator->view<const components::Renderable>()) {
                 if (renderable.visible) {
                     visibleCount++;
                     // Here you would submit the entity for rendering
@@ -89,11 +102,14 @@ namespace ecs::systems {
 
     /**
      * @brief Health system that manages entity health and death
+     *
+     * Dead entities are destroyed through the coordinator's command buffer,
+     * so they disappear when the buffer is played back after the systems
+     * have updated, not while other systems may be iterating them.
      */
     class HealthSystem : public System {
     private:
         Coordinator* mCoordinator;
-        std::vector<Entity> mEntitiesToDestroy; // Entities to be destroyed this frame
 
     public:
         /**
@@ -101,29 +117,24 @@ namespace ecs::systems {
          * @param coordinator Pointer to ECS coordinator
          */
         explicit HealthSystem(Coordinator* coordinator)
-            : mCoordinator(coordinator) {}
+            : mCoordinator(coordinator) {
+            declareReads<components::Health>();
+        }
 
         /**
-         * @brief Updates health status and handles entity death
+         * @brief Updates health status and queues dead entities for destruction
          * @param deltaTime Time elapsed since last update
          */
         void update(float deltaTime) override {
-            mEntitiesToDestroy.clear();
-
-            for (auto const& entity : mEntities) {
-                auto& health = mCoordinator->getComponent<components::Health>(entity);
+            EntityCommandBuffer& commands = mCoordinator->getCommandBuffer();
 
+            mCoordinator->view<const components::Health>().each([&commands](Entity entity, const components::Health& health) {
                 // Check if entity should be destroyed
                 if (!health.isAlive()) {
-                    mEntitiesToDestroy.push_back(entity);
+                    std::cout << "[HealthSystem] Entity " << entity << " died and will be destroyed" << std::endl;
+                    commands.destroyEntity(entity);
                 }
-            }
-
-            // Destroy dead entities
-            for (auto entity : mEntitiesToDestroy) {
-                std::cout << "[HealthSystem] Entity " << entity << " died and will be destroyed" << std::endl;
-                mCoordinator->destroyEntity(entity);
-            }
+            });
         }
 
         /**
@@ -161,3 +172,4 @@ namespace ecs::systems {
 
 // Include additional system types
 #include "Renderer2DSystem.h"
+#include "HierarchySystem.h"
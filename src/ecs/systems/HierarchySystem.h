@@ -0,0 +1,476 @@
+#pragma once
+
+#include "../System.h"
+#include "../Coordinator.h"
+#include "../components/CommonComponents.h"
+#include "../../math/math.h"
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace ecs::systems {
+
+    /**
+     * @brief Parent/child hierarchy stored in the ECS with linear world transform propagation
+     *
+     * Links are kept as Parent and Children components on the entities: each
+     * child names its parent and its neighbouring siblings, and each parent
+     * the ends of its child list. The system flattens them into a depth-first
+     * order: every parent comes before its descendants, and each entry
+     * stores the position of its parent in the same order. Local matrices
+     * are cached in that order too, so propagating world matrices is one
+     * pass over contiguous arrays, reading each parent's matrix from an
+     * earlier slot, with no recursion, pointer chasing or per-entity lookup.
+     * Only Transforms changed since the previous update are fetched from
+     * component storage, to refresh their cached local matrix.
+     *
+     * The order is rebuilt lazily in update() after setParent(), removeParent(),
+     * any change to the system's entities, or any Parent added, removed or
+     * written some other way, such as through the command buffer. A rebuild
+     * also relinks the sibling lists from the Parent handles. Entities whose
+     * parent is gone or has no Transform are treated as roots.
+     *
+     * Requires Parent and Children to be registered and the system signature
+     * to contain Transform.
+     */
+    class HierarchySystem : public System {
+    public:
+        /// Parent index of a root entry
+        static constexpr std::uint32_t NO_PARENT = ~std::uint32_t{ 0 };
+
+    private:
+        static constexpr std::uint32_t NO_ORDER = ~std::uint32_t{ 0 };
+        static constexpr std::uint32_t NO_RANK = ~std::uint32_t{ 0 };
+
+        /// A child under its parent, sorted by rank to relink the sibling lists
+        struct Link {
+            Entity parent;
+            std::uint64_t rank;
+            Entity child;
+        };
+
+        Coordinator* mCoordinator;
+
+        /// Entities in depth-first order
+        std::vector<Entity> mOrder;
+
+        /// Position of each entry's parent in mOrder, or NO_PARENT
+        std::vector<std::uint32_t> mParentIndex;
+
+        /// Local matrix of each entry, parallel to mOrder
+        std::vector<math::Matrix4f> mLocal;
+
+        /// World matrix of each entry, parallel to mOrder
+        std::vector<math::Matrix4f> mWorld;
+
+        /// Position in mOrder indexed by entity slot
+        std::vector<std::uint32_t> mOrderOfSlot;
+
+        /// Every parented entity, grouped by parent in sibling order
+        std::vector<Link> mLinks;
+
+        /// First entry of each parent's group in mLinks, indexed by entity slot
+        std::vector<std::uint32_t> mLinksOfSlot;
+
+        /// Position of each child in its parent's list before relinking, indexed by entity slot
+        std::vector<std::uint32_t> mRankOfSlot;
+
+        /// Scratch stack for the depth-first walk
+        std::vector<std::pair<Entity, std::uint32_t>> mStack;
+
+        uint64_t mBuiltMembershipVersion = 0;
+        size_t mBuiltParentCount = 0;
+        size_t mBuiltChildrenCount = 0;
+        bool mOrderDirty = true;
+
+        /// Changes stamped after this tick are new to the system
+        ChangeTick mSeenTick = 0;
+
+    public:
+        /**
+         * @brief Constructor
+         * @param coordinator Pointer to ECS coordinator
+         */
+        explicit HierarchySystem(Coordinator* coordinator)
+            : mCoordinator(coordinator) {
+            declareReads<components::Transform>();
+            declareWrites<components::Parent, components::Children>();
+        }
+
+        /**
+         * @brief Attaches an entity to a parent as its last child, detaching it from its previous one
+         *
+         * Making an entity a child of one of its own descendants is rejected.
+         *
+         * @param child Entity to attach
+         * @param parent New parent (must be alive)
+         */
+        void setParent(Entity child, Entity parent) {
+            assert(child != parent && "An entity cannot be its own parent.");
+            assert(mCoordinator->isAlive(parent) && "Parent entity is not alive.");
+            if (isAncestor(child, parent)) {
+                assert(false && "Parenting would create a cycle.");
+                return;
+            }
+
+            removeParent(child);
+
+            if (!mCoordinator->hasComponent<components::Children>(parent)) {
+                mCoordinator->addComponent(parent, components::Children{});
+            }
+
+            // Adding the component may move rows, so references are taken afresh afterwards
+            components::Parent link(parent);
+            const Entity previous = std::as_const(*mCoordinator).getComponent<components::Children>(parent).last;
+            const bool linked = isChildOf(previous, parent);
+            link.previousSibling = linked ? previous : NULL_ENTITY;
+            mCoordinator->addComponent(child, link);
+
+            if (linked) {
+                mCoordinator->getComponent<components::Parent>(previous).nextSibling = child;
+            }
+            auto& children = mCoordinator->getComponent<components::Children>(parent);
+            if (children.first == NULL_ENTITY) {
+                children.first = child;
+            }
+            children.last = child;
+            ++children.count;
+            mOrderDirty = true;
+        }
+
+        /**
+         * @brief Detaches an entity from its parent, making it a root
+         * @param child Entity to detach
+         */
+        void removeParent(Entity child) {
+            if (!mCoordinator->hasComponent<components::Parent>(child)) {
+                return;
+            }
+
+            const components::Parent link = std::as_const(*mCoordinator).getComponent<components::Parent>(child);
+            if (mCoordinator->isAlive(link.entity) && mCoordinator->hasComponent<components::Children>(link.entity)) {
+                if (isChildOf(link.previousSibling, link.entity)) {
+                    mCoordinator->getComponent<components::Parent>(link.previousSibling).nextSibling = link.nextSibling;
+                }
+                if (isChildOf(link.nextSibling, link.entity)) {
+                    mCoordinator->getComponent<components::Parent>(link.nextSibling).previousSibling = link.previousSibling;
+                }
+                auto& children = mCoordinator->getComponent<components::Children>(link.entity);
+                if (children.first == child) {
+                    children.first = link.nextSibling;
+                }
+                if (children.last == child) {
+                    children.last = link.previousSibling;
+                }
+                children.count -= children.count > 0 ? 1 : 0;
+            }
+
+            mCoordinator->removeComponent<components::Parent>(child);
+            mOrderDirty = true;
+        }
+
+        /**
+         * @brief Gets the parent of an entity
+         * @param entity Entity to look up
+         * @return Parent entity, or NULL_ENTITY for roots
+         */
+        Entity getParent(Entity entity) const {
+            const Coordinator& coordinator = *mCoordinator;
+            if (!coordinator.hasComponent<components::Parent>(entity)) {
+                return NULL_ENTITY;
+            }
+            const Entity parent = coordinator.getComponent<components::Parent>(entity).entity;
+            return coordinator.isAlive(parent) ? parent : NULL_ENTITY;
+        }
+
+        /**
+         * @brief Calls a function for each child of an entity, in sibling order
+         *
+         * Children parented other than through setParent(), and siblings of
+         * destroyed children, are listed from the next update() on.
+         *
+         * @param parent Entity whose children are visited
+         * @param func Callable taking the child Entity
+         */
+        template<typename Func>
+        void forEachChild(Entity parent, Func&& func) const {
+            const Coordinator& coordinator = *mCoordinator;
+            if (!coordinator.isAlive(parent) || !coordinator.hasComponent<components::Children>(parent)) {
+                return;
+            }
+            const components::Children& children = coordinator.getComponent<components::Children>(parent);
+            Entity child = children.first;
+            for (std::uint32_t visited = 0; visited < children.count && isChildOf(child, parent); ++visited) {
+                const Entity next = coordinator.getComponent<components::Parent>(child).nextSibling;
+                func(child);
+                child = next;
+            }
+        }
+
+        /**
+         * @brief Recomputes the world matrix of every entity in the hierarchy
+         * @param deltaTime Time elapsed since last update (unused)
+         */
+        void update(float deltaTime) override {
+            (void)deltaTime;
+
+            if (mOrderDirty || mBuiltMembershipVersion != getMembershipVersion() || parentsChanged()) {
+                rebuildOrder();
+            } else {
+                refreshChangedLocals();
+            }
+
+            // Parents precede their children, so mWorld[parent] is already final
+            const size_t count = mOrder.size();
+            for (size_t i = 0; i < count; ++i) {
+                const std::uint32_t parent = mParentIndex[i];
+                mWorld[i] = parent == NO_PARENT ? mLocal[i] : mWorld[parent] * mLocal[i];
+            }
+
+            mSeenTick = mCoordinator->advanceChangeTick();
+        }
+
+        /**
+         * @brief Gets the world matrix computed by the last update()
+         * @param entity Entity to look up
+         * @return World matrix, or identity if the entity was not in the hierarchy
+         */
+        math::Matrix4f getWorldMatrix(Entity entity) const {
+            const std::uint32_t index = orderOf(entity);
+            return index != NO_ORDER ? mWorld[index] : math::Matrix4f::identity();
+        }
+
+        /**
+         * @brief Gets the entities in depth-first order
+         */
+        std::span<const Entity> getOrder() const {
+            return mOrder;
+        }
+
+        /**
+         * @brief Gets the parent position of each entry of getOrder()
+         */
+        std::span<const std::uint32_t> getParentIndices() const {
+            return mParentIndex;
+        }
+
+        /**
+         * @brief Gets the world matrices, parallel to getOrder()
+         */
+        std::span<const math::Matrix4f> getWorldMatrices() const {
+            return mWorld;
+        }
+
+    private:
+        /**
+         * @brief Gets the position of an entity in mOrder, or NO_ORDER
+         */
+        std::uint32_t orderOf(Entity entity) const {
+            const size_t slot = entityIndex(entity);
+            if (slot < mOrderOfSlot.size()) {
+                const std::uint32_t index = mOrderOfSlot[slot];
+                if (index != NO_ORDER && index < mOrder.size() && mOrder[index] == entity) {
+                    return index;
+                }
+            }
+            return NO_ORDER;
+        }
+
+        /**
+         * @brief Checks whether an entity is alive and currently parented to parent
+         */
+        bool isChildOf(Entity entity, Entity parent) const {
+            const Coordinator& coordinator = *mCoordinator;
+            return entity != NULL_ENTITY && coordinator.isAlive(entity) &&
+                coordinator.hasComponent<components::Parent>(entity) &&
+                coordinator.getComponent<components::Parent>(entity).entity == parent;
+        }
+
+        /**
+         * @brief Checks whether ancestor is entity itself or one of its ancestors
+         */
+        bool isAncestor(Entity ancestor, Entity entity) const {
+            for (Entity current = entity; current != NULL_ENTITY; current = getParent(current)) {
+                if (current == ancestor) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /**
+         * @brief Checks whether an entity starts a tree of the hierarchy
+         */
+        bool isRoot(Entity entity) const {
+            const Coordinator& coordinator = *mCoordinator;
+            return !coordinator.hasComponent<components::Parent>(entity) ||
+                !hasEntity(coordinator.getComponent<components::Parent>(entity).entity);
+        }
+
+        /**
+         * @brief Checks for Parent or Children changes made since the last rebuild other than through this system
+         */
+        bool parentsChanged() const {
+            const Coordinator& coordinator = *mCoordinator;
+            if (coordinator.getComponentCount<components::Parent>() != mBuiltParentCount ||
+                coordinator.getComponentCount<components::Children>() != mBuiltChildrenCount) {
+                return true;
+            }
+            // Removals show in the counts; additions and edits are stamped
+            auto changed = mCoordinator->view<const components::Parent>().changedSince<components::Parent>(mSeenTick);
+            return changed.begin() != changed.end();
+        }
+
+        /**
+         * @brief Copies the Transforms changed since the last update into the cached local matrices
+         */
+        void refreshChangedLocals() {
+            auto changed = mCoordinator->view<const components::Transform>().changedSince<components::Transform>(mSeenTick);
+            for (auto [entity, transform] : changed) {
+                const std::uint32_t index = orderOf(entity);
+                if (index != NO_ORDER) {
+                    mLocal[index] = transform.getMatrix();
+                }
+            }
+        }
+
+        template<typename Vector>
+        static void growForSlot(Vector& table, size_t slot, std::uint32_t fill) {
+            if (slot >= table.size()) {
+                table.resize(slot + 1, fill);
+            }
+        }
+
+        /**
+         * @brief Regroups every parented entity by parent and rewrites the sibling lists from the Parent handles
+         *
+         * Children keep their position in the current lists; children the
+         * lists miss (parented through the command buffer, or behind a
+         * destroyed sibling) follow, in storage order.
+         */
+        void relink() {
+            Coordinator& coordinator = *mCoordinator;
+            const Coordinator& reader = coordinator;
+            const size_t parentCount = reader.getComponentCount<components::Parent>();
+
+            std::fill(mRankOfSlot.begin(), mRankOfSlot.end(), NO_RANK);
+            for (auto [parent, children] : coordinator.view<const components::Children>()) {
+                Entity child = children.first;
+                for (std::uint32_t rank = 0; rank < parentCount && isChildOf(child, parent); ++rank) {
+                    growForSlot(mRankOfSlot, entityIndex(child), NO_RANK);
+                    mRankOfSlot[entityIndex(child)] = rank;
+                    child = reader.getComponent<components::Parent>(child).nextSibling;
+                }
+            }
+
+            mLinks.clear();
+            std::uint64_t unranked = std::uint64_t{ NO_RANK } + 1;
+            for (auto [child, link] : coordinator.view<const components::Parent>()) {
+                const size_t slot = entityIndex(child);
+                const std::uint32_t rank = slot < mRankOfSlot.size() ? mRankOfSlot[slot] : NO_RANK;
+                const Entity parent = reader.isAlive(link.entity) ? link.entity : NULL_ENTITY;
+                mLinks.push_back({ parent, rank != NO_RANK ? rank : unranked++, child });
+            }
+            std::sort(mLinks.begin(), mLinks.end(), [](const Link& a, const Link& b) {
+                return a.parent != b.parent ? a.parent < b.parent : a.rank < b.rank;
+            });
+
+            for (auto [parent, children] : coordinator.view<components::Children>()) {
+                children = components::Children{};
+            }
+
+            std::fill(mLinksOfSlot.begin(), mLinksOfSlot.end(), NO_ORDER);
+            for (size_t begin = 0, end = 0; begin < mLinks.size(); begin = end) {
+                const Entity parent = mLinks[begin].parent;
+                end = begin;
+                while (end < mLinks.size() && mLinks[end].parent == parent) {
+                    auto& link = coordinator.getComponent<components::Parent>(mLinks[end].child);
+                    const bool listed = parent != NULL_ENTITY;
+                    link.previousSibling = listed && end > begin ? mLinks[end - 1].child : NULL_ENTITY;
+                    link.nextSibling = listed && end + 1 < mLinks.size() && mLinks[end + 1].parent == parent ? mLinks[end + 1].child : NULL_ENTITY;
+                    ++end;
+                }
+                if (parent == NULL_ENTITY) {
+                    continue;
+                }
+
+                growForSlot(mLinksOfSlot, entityIndex(parent), NO_ORDER);
+                mLinksOfSlot[entityIndex(parent)] = static_cast<std::uint32_t>(begin);
+                if (reader.hasComponent<components::Children>(parent)) {
+                    coordinator.getComponent<components::Children>(parent) =
+                        components::Children{ mLinks[begin].child, mLinks[end - 1].child, static_cast<std::uint32_t>(end - begin) };
+                } else {
+                    // Adding a component is a structural change: leave it to the sync point
+                    coordinator.getCommandBuffer().addComponent(parent, components::Children{});
+                }
+            }
+        }
+
+        /**
+         * @brief Relinks the hierarchy and flattens it into depth-first order
+         */
+        void rebuildOrder() {
+            relink();
+
+            const Coordinator& coordinator = *mCoordinator;
+            const size_t count = getEntityCount();
+
+            mOrder.clear();
+            mParentIndex.clear();
+            mOrder.reserve(count);
+            mParentIndex.reserve(count);
+
+            for (Entity root : getEntities()) {
+                if (!isRoot(root)) {
+                    continue;
+                }
+
+                mStack.clear();
+                mStack.emplace_back(root, NO_PARENT);
+                while (!mStack.empty()) {
+                    const auto [entity, parentIndex] = mStack.back();
+                    mStack.pop_back();
+
+                    const auto index = static_cast<std::uint32_t>(mOrder.size());
+                    mOrder.push_back(entity);
+                    mParentIndex.push_back(parentIndex);
+
+                    const size_t slot = entityIndex(entity);
+                    if (slot >= mLinksOfSlot.size() || mLinksOfSlot[slot] == NO_ORDER) {
+                        continue;
+                    }
+
+                    // Pushed in reverse so the first child is visited first
+                    size_t end = mLinksOfSlot[slot];
+                    while (end < mLinks.size() && mLinks[end].parent == entity) {
+                        ++end;
+                    }
+                    for (size_t link = end; link-- > mLinksOfSlot[slot];) {
+                        // Children without a Transform are left out, with their subtrees
+                        if (hasEntity(mLinks[link].child)) {
+                            mStack.emplace_back(mLinks[link].child, index);
+                        }
+                    }
+                }
+            }
+
+            mLocal.resize(mOrder.size());
+            mWorld.resize(mOrder.size());
+            std::fill(mOrderOfSlot.begin(), mOrderOfSlot.end(), NO_ORDER);
+            for (size_t i = 0; i < mOrder.size(); ++i) {
+                growForSlot(mOrderOfSlot, entityIndex(mOrder[i]), NO_ORDER);
+                mOrderOfSlot[entityIndex(mOrder[i])] = static_cast<std::uint32_t>(i);
+                mLocal[i] = coordinator.getComponent<components::Transform>(mOrder[i]).getMatrix();
+            }
+
+            mBuiltMembershipVersion = getMembershipVersion();
+            mBuiltParentCount = coordinator.getComponentCount<components::Parent>();
+            mBuiltChildrenCount = coordinator.getComponentCount<components::Children>();
+            mOrderDirty = false;
+        }
+    };
+
+} // namespace ecs::systems
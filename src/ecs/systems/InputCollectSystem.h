@@ -4,6 +4,7 @@
 #include "../InputState.h"
 #include "../GlobalFlags.h"
 #include "../EventBus.h"
+#include "../EventLog.h"
 #include "../events/InputEvents.h"
 #include <SDL2/SDL.h>
 
@@ -14,12 +15,17 @@ namespace ecs::systems {
      *
      * This system should run first in the system pipeline every frame.
      * It polls SDL events and updates the global InputState resource.
+     *
+     * With a replay set, it takes each frame's SDL events from the replay's
+     * recorded RawInputEvents instead of SDL, so InputState, GlobalFlags and
+     * every event it emits come out as they did in the recorded session.
      */
     class InputCollectSystem : public System {
     private:
         InputState* mInputState = nullptr;
         GlobalFlags* mGlobalFlags = nullptr;
         EventBus* mEventBus = nullptr;
+        EventReplay* mReplay = nullptr;
 
     public:
         /**
@@ -31,6 +37,14 @@ namespace ecs::systems {
             mEventBus = eventBus;
         }
 
+        /**
+         * @brief Replays recorded input instead of polling SDL, or polls SDL again with nullptr
+         * @param replay Replay with the input event types added; advanced one frame per update
+         */
+        void setReplay(EventReplay* replay) {
+            mReplay = replay;
+        }
+
         /**
          * @brief Update method called every frame
          * @param deltaTime Time elapsed since last frame
@@ -43,6 +57,14 @@ namespace ecs::systems {
             // Clear frame-specific input data
             mInputState->clearFrameData();
 
+            if (mReplay) {
+                mReplay->forEach<events::RawInputEvent>([this](const events::RawInputEvent& recorded) {
+                    handleSDLEvent(recorded.sdlEvent);
+                });
+                mReplay->nextFrame();
+                return;
+            }
+
             // Poll SDL events
             SDL_Event event;
             while (SDL_PollEvent(&event)) {
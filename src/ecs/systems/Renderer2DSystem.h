@@ -31,7 +31,10 @@ namespace ecs::systems {
          * @param renderer Renderer2D instance for this scene
          */
         Renderer2DSystem(Coordinator* coord, scene::IRenderer2D* renderer)
-            : coordinator(coord), renderer2D(renderer) {}
+            : coordinator(coord), renderer2D(renderer) {
+            // Submits to the renderer, which must stay on the updating thread
+            declareExclusive();
+        }
 
         /**
          * @brief Update system - collect all 2D entities and submit to facade
@@ -46,10 +49,7 @@ namespace ecs::systems {
             facade.clear();
 
             // Process all entities with Transform and Renderable2D components
-            for (auto const& entity : mEntities) {
-                auto& transform = coordinator->getComponent<ecs::components::Transform>(entity);
-                auto& renderable = coordinator->getComponent<ecs::components::Renderable2D>(entity);
-
+            for (auto [entity, transform, renderable] : coordinator->view<const ecs::components::Transform, const ecs::components::Renderable2D>()) {
                 // Skip invisible entities
                 if (!renderable.visible) {
                     continue;
@@ -146,14 +146,14 @@ namespace ecs::systems {
          * @param texture Texture identifier
          * @param color Sprite tint color
          * @param layer Rendering layer
-         * @return Created entity ID
+         * @return Created entity ID, or NULL_ENTITY without a coordinator
          */
         ecs::Entity createSpriteEntity(const math::Vec2f& position,
             const math::Vec2f& size,
             const std::string& texture,
             const scene::Color& color = scene::Color::White,
             uint32_t layer = 0) {
-            if (!coordinator) return 0;
+            if (!coordinator) return NULL_ENTITY;
 
             auto entity = coordinator->createEntity();
 
@@ -178,13 +178,13 @@ namespace ecs::systems {
          * @param size Quad size
          * @param color Quad color
          * @param layer Rendering layer
-         * @return Created entity ID
+         * @return Created entity ID, or NULL_ENTITY without a coordinator
          */
         ecs::Entity createQuadEntity(const math::Vec2f& position,
             const math::Vec2f& size,
             const scene::Color& color,
             uint32_t layer = 0) {
-            if (!coordinator) return 0;
+            if (!coordinator) return NULL_ENTITY;
 
             auto entity = coordinator->createEntity();
 
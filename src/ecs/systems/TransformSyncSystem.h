@@ -5,6 +5,7 @@
 #include "../../scene/SceneNode.h"
 #include "../../math/math.h"
 #include <unordered_map>
+#include <utility>
 
 namespace scene {
 
@@ -14,6 +15,11 @@ namespace scene {
      * This system ensures that SceneNode matrices reflect the authoritative
      * Transform component data. It runs once per frame and handles the
      * propagation of transformations through the hierarchy.
+     *
+     * Only nodes whose Transform changed since the previous update are
+     * re-read: the system keeps the coordinator's change tick between runs
+     * and visits a changedSince() view. World matrices are recomputed for
+     * dirty subtrees only.
      */
     class TransformSyncSystem : public ecs::System {
     private:
@@ -26,6 +32,9 @@ namespace scene {
         // Reference to coordinator for accessing Transform components
         ecs::Coordinator* coordinator = nullptr;
 
+        // Change tick that ended at the previous update
+        ecs::ChangeTick lastSyncTick = 0;
+
     public:
         /**
          * @brief Register a scene node with its linked entity
@@ -91,6 +100,20 @@ namespace scene {
          * @param deltaTime Time elapsed since last update
          */
         void update(float deltaTime) override {
+            // Flag the nodes whose Transform was written since the last update
+            if (coordinator) {
+                const ecs::ChangeTick since = lastSyncTick;
+                lastSyncTick = coordinator->advanceChangeTick();
+                coordinator->view<const ecs::components::Transform>()
+                    .changedSince<ecs::components::Transform>(since)
+                    .each([this](ecs::Entity entity, const ecs::components::Transform&) {
+                        auto it = entityToNode.find(entity);
+                        if (it != entityToNode.end()) {
+                            it->second->markTransformDirty();
+                        }
+                    });
+            }
+
             // Process all root nodes and their hierarchies
             for (SceneNode* rootNode : rootNodes) {
                 updateNodeHierarchy(rootNode, math::Matrix4f::identity());
@@ -103,6 +126,7 @@ namespace scene {
          */
         void setCoordinator(ecs::Coordinator* coord) {
             coordinator = coord;
+            lastSyncTick = 0;
         }
 
     private:
@@ -156,6 +180,7 @@ namespace scene {
         void clear() {
             entityToNode.clear();
             rootNodes.clear();
+            lastSyncTick = 0;
         }
 
     private:
@@ -167,13 +192,24 @@ namespace scene {
         void updateNodeHierarchy(SceneNode* node, const math::Matrix4f& parentWorldMatrix) {
             if (!node) return;
 
+            // Clean nodes keep their matrices, but a child below may have changed
+            if (!node->isTransformDirty()) {
+                for (const auto& child : node->getChildren()) {
+                    updateNodeHierarchy(child.get(), node->getWorldMatrix());
+                }
+                return;
+            }
+
             // Update local matrix from Transform component if entity is linked
             if (node->hasEntity() && coordinator) {
                 ecs::Entity entity = node->getEntity().value();
 
-                // Check if entity has Transform component and update if dirty
-                if (coordinator->hasComponent<ecs::components::Transform>(entity) && node->isTransformDirty()) {
-                    auto& transform = coordinator->getComponent<ecs::components::Transform>(entity);
+                // Check if entity is still alive, has a Transform component and is dirty
+                // (a stale link may point at a destroyed entity whose slot was reused)
+                if (coordinator->isAlive(entity) &&
+                    coordinator->hasComponent<ecs::components::Transform>(entity)) {
+                    // Read through const access so the sync itself is not a change
+                    const auto& transform = std::as_const(*coordinator).getComponent<ecs::components::Transform>(entity);
                     node->updateLocalMatrix(getTransformMatrix(transform));
                 }
             }
@@ -2,10 +2,12 @@
 
 #include <iostream>
 #include <algorithm>
+#include <fstream>
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_image.h>
 #include "../core/Renderer.h"
 #include "../core/Window.h"
+#include "../core/Trace.h"
 // Include unified scene-based system
 #include "../scenes/MenuScene.h"
 #include "../scenes/GameScene.h"
@@ -43,7 +45,10 @@ void game::Game::mainLoop() {
     float accumulator = 0.0f;
     bool running = true;
 
+    TRACE_THREAD_NAME("Main");
+
     while (running) {
+        TRACE_ZONE("Game::frame");
         Uint64 currentCounter = SDL_GetPerformanceCounter();
         float frameTime = static_cast<float>(currentCounter - lastCounter) / static_cast<float>(performanceFrequency);
         lastCounter = currentCounter;
@@ -58,6 +63,13 @@ void game::Game::mainLoop() {
         // --- INPUT HANDLING ---
         SDL_Event event;
         while (SDL_PollEvent(&event)) {
+            // F12 dumps the recent trace zones, with the current scene's system
+            // updates nested inside them, for chrome://tracing or Perfetto
+            if (core::TRACE_ZONES_ENABLED && event.type == SDL_KEYDOWN && !event.key.repeat
+                && event.key.keysym.scancode == SDL_SCANCODE_F12) {
+                const bool written = writeTrace("trace.json");
+                std::cout << "[Game] " << (written ? "Trace written to trace.json" : "Failed to write trace.json") << std::endl;
+            }
         }
 
         // Check if any scene has requested quit
@@ -91,11 +103,32 @@ void game::Game::mainLoop() {
         }
 
         // little delay to avoid maxing out the CPU
-        SDL_Delay(1);
+        {
+            TRACE_ZONE("Game::sleep");
+            SDL_Delay(1);
+        }
     }
 }
 
 
+bool game::Game::writeTrace(const std::string& path) const {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        return false;
+    }
+
+    core::chrome::TraceEventWriter writer(file);
+    core::Trace::writeEvents(writer);
+    // Both share the trace clock and thread tracks, so each system update
+    // lands inside the SceneManager::update zone that ran it
+    auto* currentScene = sceneManager ? sceneManager->getCurrentScene() : nullptr;
+    if (currentScene && currentScene->getCoordinator()) {
+        currentScene->getCoordinator()->getSystemProfiler().writeTraceEvents(writer);
+    }
+    writer.finish();
+    return static_cast<bool>(file);
+}
+
 core::Renderer& game::Game::getRenderer() {
     return renderer;
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <string>
 #include <iostream>
 #include <SDL2/SDL.h>
 #include "Avatar.h"
@@ -49,5 +50,12 @@ namespace game {
 
         void initializeSceneSystem();
         void handleInput(const SDL_Event& event);
+
+        /**
+         * @brief Writes the trace zones and the current scene's system updates as one Chrome trace
+         *
+         * @return False when the file could not be written
+         */
+        bool writeTrace(const std::string& path) const;
     };
 } // namespace game
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "RenderBackend.h"
+#include "../../core/Trace.h"
 #include <iostream>
 
 namespace rendering::backend {
@@ -64,6 +65,7 @@ namespace rendering::backend {
     }
 
     void RenderBackend::executeCommandBuffer(const CommandBuffer& commandBuffer) {
+        TRACE_ZONE("RenderBackend::executeCommandBuffer");
         if (!initialized) return;
 
         for (const auto& command : commandBuffer.getCommands()) {
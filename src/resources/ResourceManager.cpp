@@ -1,4 +1,5 @@
 #include "ResourceManager.h"
+#include "../core/Trace.h"
 
 namespace resources {
 
@@ -13,6 +14,7 @@ namespace resources {
     }
 
     LoadResult ResourceManager::load(const std::string& path, const LoadOptions& options) {
+        TRACE_ZONE("ResourceManager::load");
         totalLoadsAttempted++;
 
         if (path.empty()) {
@@ -113,6 +113,9 @@ namespace scene {
 
         /**
          * @brief Reset registry (for testing)
+         *
+         * IDs already cached by ecs::ComponentManager::typeId<T>() are not
+         * cleared, so only reset before any coordinator has used a component.
          */
         static void reset() {
             std::lock_guard<std::mutex> lock(registryMutex);
@@ -4,6 +4,7 @@
 #include "SceneBundle.h"
 #include "SceneNode.h"
 #include "ComponentTypeRegistry.h"
+#include "SceneWorldSchema.h"
 #include "rendering/RenderQueueBuilder.h"
 #include "../ecs/ECS.h"
 #include "../ecs/components/CommonComponents.h"
@@ -147,6 +148,32 @@ namespace scene {
          */
         ecs::Coordinator* getCoordinator() const { return coordinator.get(); }
 
+        /**
+         * @brief Write the ECS world to a binary world file
+         *
+         * Converts a world built in code (e.g. after onAttach) into a file
+         * that loadWorld() reads back without replaying the
+         * createEntity/addComponent calls.
+         *
+         * @param path File to write
+         * @throws std::runtime_error if the world holds components outside getSceneWorldSchema()
+         */
+        void saveWorld(const std::string& path) const {
+            coordinator->saveWorld(path, getSceneWorldSchema());
+        }
+
+        /**
+         * @brief Load entities from a world file written by saveWorld()
+         *
+         * Must run before the scene creates any entity.
+         *
+         * @param path File to load
+         * @throws std::runtime_error if the file is missing or malformed
+         */
+        void loadWorld(const std::string& path) {
+            coordinator->loadWorld(path, getSceneWorldSchema());
+        }
+
         /**
          * @brief Get root scene node
          */
@@ -213,6 +240,8 @@ namespace scene {
             coordinator->registerComponent<ecs::components::Health>();
             coordinator->registerComponent<ecs::components::PlayerTag>();
             coordinator->registerComponent<ecs::components::EnemyTag>();
+            coordinator->registerComponent<ecs::components::Parent>();
+            coordinator->registerComponent<ecs::components::Children>();
         }
 
         /**
@@ -3,6 +3,8 @@
 #include "rendering/NullBackend.h"
 #include "rendering/Renderer2DImpl.h"
 #include "../math/math.h"
+#include "../core/Trace.h"
+#include <iomanip>
 #include <iostream>
 #include <sstream>
 #include <algorithm>
@@ -202,6 +204,7 @@ namespace scene {
     }
 
     void SceneManager::update(float deltaTime) {
+        TRACE_ZONE("SceneManager::update");
         if (!initialized) return;
 
         // Update transition first
@@ -226,6 +229,7 @@ namespace scene {
     }
 
     bool SceneManager::render() {
+        TRACE_ZONE("SceneManager::render");
         if (!initialized || !renderBackend) {
             return false;
         }
@@ -295,6 +299,7 @@ namespace scene {
 
     std::string SceneManager::getDebugInfo() const {
         std::ostringstream oss;
+        oss << std::fixed << std::setprecision(3);
         oss << "SceneManager Debug Info:\n";
         oss << "  Initialized: " << (initialized ? "Yes" : "No") << "\n";
         oss << "  Backend: " << (renderBackend ? renderBackend->getBackendType() : "None") << "\n";
@@ -309,6 +314,20 @@ namespace scene {
                 oss << "    [" << i << "] " << scene->getName()
                     << " (WorldID: " << scene->getWorldId()
                     << ", Paused: " << (scene->isPaused() ? "Yes" : "No") << ")\n";
+
+                if constexpr (ecs::SYSTEM_PROFILING_ENABLED) {
+                    if (const ecs::Coordinator* coordinator = scene->getCoordinator()) {
+                        for (const auto& stats : coordinator->getSystemProfiler().getStats()) {
+                            oss << "        " << stats.name << ": avg " << stats.avgMs
+                                << " ms, min " << stats.minMs << " ms, p99 " << stats.p99Ms
+                                << " ms, " << stats.entityCount << " entities";
+                            if constexpr (ecs::ALLOCATION_COUNTING_ENABLED) {
+                                oss << ", " << stats.lastAllocations << " allocations";
+                            }
+                            oss << "\n";
+                        }
+                    }
+                }
             }
         }
 
@@ -428,6 +447,7 @@ namespace scene {
     }
 
     bool SceneManager::renderFrame() {
+        TRACE_ZONE("SceneManager::renderFrame");
         if (!initialized || !renderBackend) {
             return false;
         }
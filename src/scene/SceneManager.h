@@ -237,6 +237,9 @@ namespace scene {
 
         /**
          * @brief Get debug information about the scene stack
+         *
+         * Includes each scene's system timings when system profiling is
+         * compiled in.
          */
         std::string getDebugInfo() const;
 
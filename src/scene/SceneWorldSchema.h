@@ -0,0 +1,58 @@
+#pragma once
+
+#include "../ecs/ECS.h"
+#include "../ecs/components/CommonComponents.h"
+
+namespace scene {
+
+    /**
+     * @brief World file schema for the components every Scene registers
+     *
+     * Used by Scene::saveWorld() and Scene::loadWorld(). Renderable2D holds
+     * strings, so it is encoded per entity; the other components are stored
+     * as raw columns and adopted in place on load. Hierarchy links are
+     * entity handles, which a loaded world keeps.
+     */
+    inline const ecs::WorldSchema& getSceneWorldSchema() {
+        static const ecs::WorldSchema schema = [] {
+            using namespace ecs::components;
+
+            ecs::WorldSchema result;
+            result.add<Transform>("Transform")
+                .add<Velocity>("Velocity")
+                .add<Health>("Health")
+                .add<PlayerTag>("PlayerTag")
+                .add<EnemyTag>("EnemyTag")
+                .add<Parent>("Parent")
+                .add<Children>("Children")
+                .add<Renderable2D>("Renderable2D",
+                    [](const Renderable2D& renderable, ecs::EncodedWriter& writer) {
+                        writer.write(renderable.color);
+                        writer.write(renderable.layer);
+                        writer.write(renderable.depth);
+                        writer.write(renderable.visible);
+                        writer.write(renderable.uvMin);
+                        writer.write(renderable.uvMax);
+                        writer.write(renderable.size);
+                        writer.writeString(renderable.textureId);
+                        writer.writeString(renderable.materialId);
+                    },
+                    [](ecs::EncodedReader& reader) {
+                        Renderable2D renderable;
+                        renderable.color = reader.read<Color>();
+                        renderable.layer = reader.read<uint32_t>();
+                        renderable.depth = reader.read<float>();
+                        renderable.visible = reader.read<bool>();
+                        renderable.uvMin = reader.read<math::Vec2f>();
+                        renderable.uvMax = reader.read<math::Vec2f>();
+                        renderable.size = reader.read<math::Vec2f>();
+                        renderable.textureId = reader.readString();
+                        renderable.materialId = reader.readString();
+                        return renderable;
+                    });
+            return result;
+        }();
+        return schema;
+    }
+
+} // namespace scene
@@ -3,6 +3,7 @@
 #include "QuadCommand.h"
 #include "Material2D.h"
 #include "RenderQueueBuilder.h"
+#include "../../core/Trace.h"
 #include <vector>
 #include <unordered_map>
 #include <algorithm>
@@ -68,6 +69,7 @@ namespace scene {
          * @brief Flush tutti i batch al RenderQueueBuilder
          */
         void flush(RenderQueueBuilder& builder) {
+            TRACE_ZONE("QuadBatch::flush");
             if (batches.empty()) {
                 return;
             }
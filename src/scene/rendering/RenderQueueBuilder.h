@@ -1,6 +1,7 @@
 #pragma once
 
 #include "CommandBuffer.h"
+#include "../../core/Trace.h"
 #include <algorithm>
 
 namespace scene {
@@ -76,6 +77,7 @@ namespace scene {
          * @return Built command buffer
          */
         CommandBuffer flush(const CameraParams& camera, const RenderTarget& target) {
+            TRACE_ZONE("RenderQueueBuilder::flush");
             CommandBuffer commandBuffer;
 
             // Set camera and target
@@ -3,6 +3,7 @@
 #include "../scene/Scene2D.h"
 #include "../ecs/InputState.h"
 #include "../ecs/EventBus.h"
+#include "../ecs/EventLog.h"
 #include "../ecs/GlobalFlags.h"
 #include "../ecs/systems/InputCollectSystem.h"
 #include "../ecs/systems/InputMappingSystem.h"
@@ -18,6 +19,12 @@ namespace game {
      * - GlobalFlags global resource
      * - InputCollectSystem (runs first)
      * - InputMappingSystem (runs second)
+     *
+     * Its input events can be recorded to an event log, and a recorded log
+     * can drive the scene in place of SDL input.
+     *
+     * Quit requests are handled by an EventBus handler, once per request,
+     * in the frame the SceneTransition::QUIT event is emitted.
      */
     class InputEnabledScene : public scene::Scene2D {
     protected:
@@ -25,6 +32,9 @@ namespace game {
         std::shared_ptr<ecs::systems::InputCollectSystem> inputCollectSystem;
         std::shared_ptr<ecs::systems::InputMappingSystem> inputMappingSystem;
 
+        std::unique_ptr<ecs::EventRecorder> eventRecorder;
+        std::unique_ptr<ecs::EventReplay> eventReplay;
+
     public:
         InputEnabledScene(const std::string& name = "InputEnabledScene")
             : Scene2D() {
@@ -41,17 +51,13 @@ namespace game {
         }
 
         void update(float deltaTime) override {
-            // Check if we should quit the game
-            if (coordinator->hasRuntimeResource<ecs::GlobalFlags>()) {
-                auto& globalFlags = coordinator->getRuntimeResource<ecs::GlobalFlags>();
-                if (globalFlags.quit) {
-                    // Handle quit - this could emit an event or call a callback
-                    handleQuitRequest();
-                }
-            }
-
             // Update base scene (this will run all systems including input systems)
             Scene2D::update(deltaTime);
+
+            // End of frame: make this frame's events readable during the next one
+            if (auto* eventBus = getEventBus()) {
+                eventBus->update();
+            }
         }
 
         /**
@@ -75,6 +81,55 @@ namespace game {
             return coordinator->getRuntimeResourcePtr<ecs::GlobalFlags>();
         }
 
+        /**
+         * @brief Starts recording every input event, beginning with the frame being built
+         * @param path Event log to create or replace
+         * @param timestep Fixed frame time a replay of the log should run at
+         * @throws std::runtime_error if the log cannot be created
+         */
+        void startEventRecording(const std::string& path, float timestep) {
+            stopEventRecording();
+            eventRecorder = std::make_unique<ecs::EventRecorder>(*getEventBus(), path, timestep);
+            ecs::events::addInputEventTypes(*eventRecorder);
+            eventRecorder->start();
+        }
+
+        /**
+         * @brief Stops recording and finishes the event log
+         * @throws std::runtime_error if writing the log failed
+         */
+        void stopEventRecording() {
+            if (eventRecorder) {
+                auto recorder = std::move(eventRecorder);
+                recorder->stop();
+            }
+        }
+
+        /**
+         * @brief Drives the input systems from a recorded event log instead of SDL
+         *
+         * Update the scene at the returned timestep, once per recorded frame,
+         * to reproduce the session.
+         *
+         * @param path Event log written by startEventRecording()
+         * @return Fixed timestep of the recording
+         * @throws std::runtime_error if the log cannot be read
+         */
+        float startEventReplay(const std::string& path) {
+            auto replay = std::make_unique<ecs::EventReplay>(path);
+            ecs::events::addInputEventTypes(*replay);
+            inputCollectSystem->setReplay(replay.get());
+            eventReplay = std::move(replay);
+            return eventReplay->getTimestep();
+        }
+
+        /**
+         * @brief Gets the running replay, or nullptr
+         */
+        const ecs::EventReplay* getEventReplay() const {
+            return eventReplay.get();
+        }
+
     protected:
         /**
          * @brief Set up input-related global resources
@@ -112,27 +167,30 @@ namespace game {
             coordinator->setSystemSignature<ecs::systems::InputCollectSystem>(inputSignature);
             coordinator->setSystemSignature<ecs::systems::InputMappingSystem>(inputSignature);
 
+            // React to quit within the frame it is requested in
+            auto* eventBus = coordinator->getRuntimeResourcePtr<ecs::EventBus>();
+            eventBus->subscribe<ecs::events::SceneTransition, &InputEnabledScene::onSceneTransition>(*this);
+
             std::cout << "[InputEnabledScene] Input systems initialized successfully for scene: " << getName() << std::endl;
         }
 
         /**
-         * @brief Handle quit request - can be overridden by derived classes
+         * @brief Forwards QUIT transitions to handleQuitRequest()
          */
-        virtual void handleQuitRequest() {
-            std::cout << "[InputEnabledScene] Quit requested from scene: " << getName() << std::endl;
-            // Default implementation - derived classes should override this
+        void onSceneTransition(const ecs::events::SceneTransition& transition) {
+            if (transition.type == ecs::events::SceneTransition::Type::QUIT) {
+                handleQuitRequest();
+            }
         }
 
         /**
-         * @brief Setup ECS systems - adds input systems to base setup
+         * @brief Handle quit request - can be overridden by derived classes
+         *
+         * Called once per quit request, from the emitting system's update.
          */
-        void setupECSSystems() override {
-            // Call base setup
-            Scene2D::setupECSSystems();
-
-            // Add input systems - these are already set up in setupInputSystems()
-            // but we ensure they're called in the right order here
-            std::cout << "[InputEnabledScene] Input systems added to ECS pipeline for scene: " << getName() << std::endl;
+        virtual void handleQuitRequest() {
+            std::cout << "[InputEnabledScene] Quit requested from scene: " << getName() << std::endl;
+            // Default implementation - derived classes should override this
         }
     };
 
@@ -0,0 +1,966 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include "../ecs/ECS.h"
+#include "../ecs/components/CommonComponents.h"
+#include "../ecs/systems/CommonSystems.h"
+#include "../ecs/systems/TransformSyncSystem.h"
+#include "../scene/SceneNode.h"
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cmath>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <typeindex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Benchmarks are hidden from the default run; execute them with:
+//   sdl_appTests "[benchmark]"
+
+using namespace ecs;
+using namespace ecs::components;
+using namespace ecs::systems;
+
+namespace {
+
+    /**
+     * @brief Reference copy of the previous hash-map indexed component array
+     *
+     * Kept here only so the benchmarks can compare the sparse set index against
+     * the layout it replaced.
+     */
+    template<typename T>
+    class MapComponentArray {
+    private:
+        std::vector<T> mComponentArray;
+        std::unordered_map<Entity, size_t> mEntityToIndexMap;
+        std::unordered_map<size_t, Entity> mIndexToEntityMap;
+        size_t mSize = 0;
+
+    public:
+        explicit MapComponentArray(size_t capacity) : mComponentArray(capacity) {}
+
+        void insertData(Entity entity, const T& component) {
+            size_t newIndex = mSize;
+            mEntityToIndexMap[entity] = newIndex;
+            mIndexToEntityMap[newIndex] = entity;
+            mComponentArray[newIndex] = component;
+            ++mSize;
+        }
+
+        void removeData(Entity entity) {
+            size_t indexOfRemovedEntity = mEntityToIndexMap[entity];
+            size_t indexOfLastElement = mSize - 1;
+            mComponentArray[indexOfRemovedEntity] = mComponentArray[indexOfLastElement];
+
+            Entity entityOfLastElement = mIndexToEntityMap[indexOfLastElement];
+            mEntityToIndexMap[entityOfLastElement] = indexOfRemovedEntity;
+            mIndexToEntityMap[indexOfRemovedEntity] = entityOfLastElement;
+
+            mEntityToIndexMap.erase(entity);
+            mIndexToEntityMap.erase(indexOfLastElement);
+            --mSize;
+        }
+
+        T& getData(Entity entity) {
+            return mComponentArray[mEntityToIndexMap[entity]];
+        }
+
+        bool hasData(Entity entity) const {
+            return mEntityToIndexMap.find(entity) != mEntityToIndexMap.end();
+        }
+    };
+
+    /**
+     * @brief Entity IDs in the order a system would visit them
+     *
+     * Shuffled so lookups do not degenerate into a linear walk of the dense array.
+     */
+    std::vector<Entity> makeEntityOrder(size_t count) {
+        std::vector<Entity> entities(count);
+        for (size_t i = 0; i < count; ++i) {
+            entities[i] = static_cast<Entity>(i);
+        }
+        std::shuffle(entities.begin(), entities.end(), std::mt19937(1234));
+        return entities;
+    }
+
+    template<typename Array>
+    void fillArray(Array& array, const std::vector<Entity>& entities) {
+        for (Entity entity : entities) {
+            array.insertData(entity, Velocity{ math::Vec3f{1.0f, 2.0f, 3.0f} });
+        }
+    }
+
+    template<typename Array>
+    float sumLookups(Array& array, const std::vector<Entity>& entities) {
+        float sum = 0.0f;
+        for (Entity entity : entities) {
+            sum += array.getData(entity).linear.x();
+        }
+        return sum;
+    }
+
+    template<typename Array>
+    size_t churn(Array& array, const std::vector<Entity>& entities) {
+        // Remove and re-add every other entity, as a spawn/despawn heavy frame would
+        size_t touched = 0;
+        for (size_t i = 0; i < entities.size(); i += 2) {
+            array.removeData(entities[i]);
+            ++touched;
+        }
+        for (size_t i = 0; i < entities.size(); i += 2) {
+            array.insertData(entities[i], Velocity{});
+        }
+        return touched;
+    }
+
+} // namespace
+
+TEST_CASE("ECS component array lookup", "[.][benchmark][ECS][SparseSet]") {
+    const size_t entityCount = GENERATE(1000, 5000, 100000);
+    const std::string suffix = " (" + std::to_string(entityCount) + " entities)";
+    const auto entities = makeEntityOrder(entityCount);
+
+    MapComponentArray<Velocity> mapArray(entityCount);
+    ComponentArray<Velocity> sparseArray;
+    fillArray(mapArray, entities);
+    fillArray(sparseArray, entities);
+
+    REQUIRE(sumLookups(mapArray, entities) == sumLookups(sparseArray, entities));
+
+    BENCHMARK("unordered_map getData" + suffix) {
+        return sumLookups(mapArray, entities);
+    };
+
+    BENCHMARK("sparse set getData" + suffix) {
+        return sumLookups(sparseArray, entities);
+    };
+
+    BENCHMARK("unordered_map hasData" + suffix) {
+        size_t hits = 0;
+        for (Entity entity : entities) {
+            hits += mapArray.hasData(entity + 1) ? 1 : 0;
+        }
+        return hits;
+    };
+
+    BENCHMARK("sparse set hasData" + suffix) {
+        size_t hits = 0;
+        for (Entity entity : entities) {
+            hits += sparseArray.hasData(entity + 1) ? 1 : 0;
+        }
+        return hits;
+    };
+
+    BENCHMARK("unordered_map remove/insert" + suffix) {
+        return churn(mapArray, entities);
+    };
+
+    BENCHMARK("sparse set remove/insert" + suffix) {
+        return churn(sparseArray, entities);
+    };
+}
+
+TEST_CASE("ECS archetype chunk iteration", "[.][benchmark][ECS][Archetype]") {
+    const size_t entityCount = GENERATE(10000, 100000);
+    const std::string suffix = " (" + std::to_string(entityCount) + " entities)";
+
+    // Same world in both layouts; every third entity also has Health so the
+    // sparse arrays are not in matching order
+    auto makeWorld = [entityCount](StorageMode mode) {
+        auto coordinator = createCoordinator(mode);
+        coordinator->registerComponent<Transform>();
+        coordinator->registerComponent<Velocity>();
+        coordinator->registerComponent<Health>();
+
+        auto physicsSystem = coordinator->registerSystem<PhysicsSystem>(coordinator.get());
+        Signature signature;
+        signature.set(coordinator->getComponentType<Transform>());
+        signature.set(coordinator->getComponentType<Velocity>());
+        coordinator->setSystemSignature<PhysicsSystem>(signature);
+
+        for (size_t i = 0; i < entityCount; ++i) {
+            Entity entity = coordinator->createEntity();
+            if (i % 3 == 0) {
+                coordinator->addComponent(entity, Health{});
+            }
+            coordinator->addComponent(entity, Velocity{ math::Vec3f{1.0f, 0.0f, 0.0f} });
+            coordinator->addComponent(entity, Transform{});
+        }
+        return std::make_pair(std::move(coordinator), physicsSystem);
+    };
+
+    auto [sparseWorld, sparsePhysics] = makeWorld(StorageMode::Sparse);
+    auto [archetypeWorld, archetypePhysics] = makeWorld(StorageMode::Archetype);
+
+    BENCHMARK("sparse PhysicsSystem::update" + suffix) {
+        sparsePhysics->update(0.016f);
+        return sparseWorld->getComponentCount<Transform>();
+    };
+
+    BENCHMARK("archetype PhysicsSystem::update" + suffix) {
+        archetypePhysics->update(0.016f);
+        return archetypeWorld->getComponentCount<Transform>();
+    };
+
+    BENCHMARK("sparse getComponent loop" + suffix) {
+        float sum = 0.0f;
+        for (Entity entity : sparsePhysics->getEntities()) {
+            sum += sparseWorld->getComponent<Transform>(entity).position.x() + sparseWorld->getComponent<Velocity>(entity).linear.x();
+        }
+        return sum;
+    };
+
+    BENCHMARK("archetype forEachChunk loop" + suffix) {
+        float sum = 0.0f;
+        archetypeWorld->forEachChunk<Transform, Velocity>([&sum](size_t count, const Entity*, Transform* transforms, Velocity* velocities) {
+            for (size_t i = 0; i < count; ++i) {
+                sum += transforms[i].position.x() + velocities[i].linear.x();
+            }
+        });
+        return sum;
+    };
+}
+
+TEST_CASE("ECS view iteration", "[.][benchmark][ECS][View]") {
+    const size_t entityCount = GENERATE(10000, 100000);
+    const std::string suffix = " (" + std::to_string(entityCount) + " entities)";
+
+    auto coordinator = createCoordinator();
+    coordinator->registerComponent<Transform>();
+    coordinator->registerComponent<Velocity>();
+
+    std::vector<Entity> entities;
+    for (size_t i = 0; i < entityCount; ++i) {
+        Entity entity = coordinator->createEntity();
+        coordinator->addComponent(entity, Transform{});
+        coordinator->addComponent(entity, Velocity{ math::Vec3f{1.0f, 0.0f, 0.0f} });
+        entities.push_back(entity);
+    }
+
+    BENCHMARK("getComponent per entity" + suffix) {
+        float sum = 0.0f;
+        for (Entity entity : entities) {
+            sum += coordinator->getComponent<Transform>(entity).position.x() + coordinator->getComponent<Velocity>(entity).linear.x();
+        }
+        return sum;
+    };
+
+    BENCHMARK("view range-for" + suffix) {
+        float sum = 0.0f;
+        for (auto [entity, transform, velocity] : coordinator->view<Transform, Velocity>()) {
+            sum += transform.position.x() + velocity.linear.x();
+        }
+        return sum;
+    };
+
+    BENCHMARK("view each" + suffix) {
+        float sum = 0.0f;
+        coordinator->view<Transform, Velocity>().each([&sum](const Transform& transform, const Velocity& velocity) {
+            sum += transform.position.x() + velocity.linear.x();
+        });
+        return sum;
+    };
+}
+
+TEST_CASE("ECS component type lookup", "[.][benchmark][ECS][ComponentType]") {
+    auto coordinator = createCoordinator();
+    coordinator->registerComponent<Transform>();
+    coordinator->registerComponent<Velocity>();
+
+    std::unordered_map<std::type_index, ComponentType> typeIndexMap;
+    typeIndexMap[std::type_index(typeid(Transform))] = coordinator->getComponentType<Transform>();
+    typeIndexMap[std::type_index(typeid(Velocity))] = coordinator->getComponentType<Velocity>();
+
+    constexpr size_t lookups = 100000;
+
+    BENCHMARK("type_index hash lookup") {
+        size_t sum = 0;
+        for (size_t i = 0; i < lookups; ++i) {
+            sum += typeIndexMap[std::type_index(i % 2 ? typeid(Transform) : typeid(Velocity))];
+        }
+        return sum;
+    };
+
+    BENCHMARK("cached type ID") {
+        size_t sum = 0;
+        for (size_t i = 0; i < lookups; ++i) {
+            sum += i % 2 ? coordinator->getComponentType<Transform>() : coordinator->getComponentType<Velocity>();
+        }
+        return sum;
+    };
+}
+
+namespace {
+
+    /// Independent payload per system, so the systems do not conflict
+    template<int N>
+    struct Lane {
+        float value = 1.0f;
+    };
+
+    /**
+     * @brief System doing a fixed amount of math per entity on its own component
+     */
+    template<int N>
+    class LaneSystem : public System {
+    private:
+        Coordinator* mCoordinator;
+
+    public:
+        explicit LaneSystem(Coordinator* coordinator) : mCoordinator(coordinator) {
+            declareWrites<Lane<N>>();
+        }
+
+        void update(float deltaTime) override {
+            mCoordinator->view<Lane<N>>().each([deltaTime](Lane<N>& lane) {
+                for (int i = 0; i < 16; ++i) {
+                    lane.value = std::sqrt(lane.value * lane.value + deltaTime);
+                }
+            });
+        }
+    };
+
+    template<int... Ns>
+    void populateLanes(Coordinator& coordinator, size_t entityCount, std::integer_sequence<int, Ns...>) {
+        (coordinator.registerComponent<Lane<Ns>>(), ...);
+        (coordinator.registerSystem<LaneSystem<Ns>>(&coordinator), ...);
+        for (size_t i = 0; i < entityCount; ++i) {
+            Entity entity = coordinator.createEntity();
+            (coordinator.addComponent(entity, Lane<Ns>{}), ...);
+        }
+    }
+
+} // namespace
+
+TEST_CASE("ECS parallel system scheduling", "[.][benchmark][ECS][Scheduler]") {
+    constexpr size_t entityCount = 20000;
+
+    auto coordinator = createCoordinator();
+    populateLanes(*coordinator, entityCount, std::make_integer_sequence<int, 8>{});
+
+    BENCHMARK("sequential updateSystems (8 systems, 20000 entities)") {
+        coordinator->updateSystems(0.016f);
+        return coordinator->getSystemCount();
+    };
+
+    const size_t maxThreads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    for (size_t threads = 1; threads <= maxThreads; threads *= 2) {
+        JobSystem jobs(threads - 1);
+        BENCHMARK("parallel updateSystems, " + std::to_string(threads) + " threads") {
+            coordinator->updateSystems(0.016f, jobs);
+            return coordinator->getSystemCount();
+        };
+    }
+}
+
+TEST_CASE("ECS system profiling", "[.][benchmark][ECS][Profiler]") {
+    // Cheap systems, so the per-update timing cost dominates
+    auto coordinator = createCoordinator();
+    populateLanes(*coordinator, 16, std::make_integer_sequence<int, 32>{});
+
+    const std::string profiling = SYSTEM_PROFILING_ENABLED ? "profiled" : "unprofiled";
+    BENCHMARK("updateSystems, 32 small systems, " + profiling) {
+        coordinator->updateSystems(0.016f);
+        return coordinator->getSystemCount();
+    };
+
+    BENCHMARK("getStats, 32 systems") {
+        return coordinator->getSystemProfiler().getStats().size();
+    };
+}
+
+TEST_CASE("ECS parallel iteration", "[.][benchmark][ECS][Jobs]") {
+    constexpr size_t entityCount = 100000;
+
+    auto storageMode = GENERATE(StorageMode::Sparse, StorageMode::Archetype);
+    const std::string modeName = storageMode == StorageMode::Sparse ? "sparse" : "archetype";
+
+    auto coordinator = createCoordinator(storageMode);
+    coordinator->registerComponent<Transform>();
+    coordinator->registerComponent<Velocity>();
+    for (size_t i = 0; i < entityCount; ++i) {
+        Entity entity = coordinator->createEntity();
+        coordinator->addComponent(entity, Transform{});
+        coordinator->addComponent(entity, Velocity{ { 1.0f, 2.0f, 3.0f }, { 0.0f, 0.0f, 0.0f } });
+    }
+
+    auto integrate = [](Transform& transform, const Velocity& velocity) {
+        for (int axis = 0; axis < 3; ++axis) {
+            transform.position[axis] += velocity.linear[axis] * 0.016f;
+        }
+    };
+
+    BENCHMARK(modeName + " each (100000 entities)") {
+        coordinator->view<Transform, Velocity>().each(integrate);
+        return coordinator->getLivingEntityCount();
+    };
+
+    const size_t maxThreads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    for (size_t threads = 1; threads <= maxThreads; threads *= 2) {
+        JobSystem jobs(threads - 1);
+        for (size_t grain : { size_t{ 256 }, size_t{ 1024 }, size_t{ 8192 } }) {
+            BENCHMARK(modeName + " parallelForEach, " + std::to_string(threads) + " threads, grain " + std::to_string(grain)) {
+                coordinator->view<Transform, Velocity>().parallelForEach(jobs, integrate, grain);
+                return coordinator->getLivingEntityCount();
+            };
+        }
+    }
+}
+
+namespace {
+
+    /**
+     * @brief Fresh coordinators with a PhysicsSystem, one per benchmark run
+     */
+    std::vector<std::unique_ptr<Coordinator>> makePhysicsCoordinators(int count, StorageMode mode = StorageMode::Sparse) {
+        std::vector<std::unique_ptr<Coordinator>> coordinators;
+        for (int i = 0; i < count; ++i) {
+            auto coordinator = createCoordinator(mode);
+            coordinator->registerComponent<Transform>();
+            coordinator->registerComponent<Velocity>();
+            coordinator->registerComponent<Health>();
+            coordinator->registerSystem<PhysicsSystem>(coordinator.get());
+            Signature signature;
+            signature.set(coordinator->getComponentType<Transform>());
+            signature.set(coordinator->getComponentType<Velocity>());
+            coordinator->setSystemSignature<PhysicsSystem>(signature);
+            coordinators.push_back(std::move(coordinator));
+        }
+        return coordinators;
+    }
+
+} // namespace
+
+TEST_CASE("ECS system membership", "[.][benchmark][ECS][System]") {
+    constexpr size_t entityCount = 50000;
+
+    BENCHMARK_ADVANCED("spawn 50000 entities into a system")(Catch::Benchmark::Chronometer meter) {
+        auto coordinators = makePhysicsCoordinators(meter.runs());
+        meter.measure([&](int run) {
+            Coordinator& coordinator = *coordinators[run];
+            for (size_t i = 0; i < entityCount; ++i) {
+                Entity entity = coordinator.createEntity();
+                coordinator.addComponent(entity, Transform{});
+                coordinator.addComponent(entity, Velocity{});
+            }
+            return coordinator.getLivingEntityCount();
+        });
+    };
+}
+
+TEST_CASE("ECS batch creation", "[.][benchmark][ECS][Batch]") {
+    constexpr size_t entityCount = 50000;
+
+    auto storageMode = GENERATE(StorageMode::Sparse, StorageMode::Archetype);
+    const std::string modeName = storageMode == StorageMode::Sparse ? "sparse" : "archetype";
+
+    BENCHMARK_ADVANCED(modeName + " createEntity + addComponent x3 (50000)")(Catch::Benchmark::Chronometer meter) {
+        auto coordinators = makePhysicsCoordinators(meter.runs(), storageMode);
+        meter.measure([&](int run) {
+            Coordinator& coordinator = *coordinators[run];
+            for (size_t i = 0; i < entityCount; ++i) {
+                Entity entity = coordinator.createEntity();
+                coordinator.addComponent(entity, Transform{});
+                coordinator.addComponent(entity, Velocity{});
+                coordinator.addComponent(entity, Health{});
+            }
+            return coordinator.getLivingEntityCount();
+        });
+    };
+
+    BENCHMARK_ADVANCED(modeName + " createEntities (50000)")(Catch::Benchmark::Chronometer meter) {
+        auto coordinators = makePhysicsCoordinators(meter.runs(), storageMode);
+        meter.measure([&](int run) {
+            return coordinators[run]->createEntities(entityCount, Transform{}, Velocity{}, Health{}).size();
+        });
+    };
+}
+
+TEST_CASE("ECS change tracking", "[.][benchmark][ECS][Changes]") {
+    constexpr size_t entityCount = 100000;
+    constexpr size_t moverCount = entityCount / 20;
+
+    auto storageMode = GENERATE(StorageMode::Sparse, StorageMode::Archetype);
+    const std::string modeName = storageMode == StorageMode::Sparse ? "sparse" : "archetype";
+
+    auto coordinators = makePhysicsCoordinators(1, storageMode);
+    Coordinator& coordinator = *coordinators.front();
+    auto physicsSystem = coordinator.getSystem<PhysicsSystem>();
+
+    // 5% of the entities move each frame, the rest stay put
+    coordinator.createEntities(entityCount - moverCount, Transform{});
+    coordinator.createEntities(moverCount, Transform{}, Velocity{ math::Vec3f{1.0f, 0.0f, 0.0f} });
+
+    std::vector<math::Matrix4f> matrices(entityCount);
+    auto rebuild = [&matrices](Entity entity, const Transform& transform) {
+        matrices[entityIndex(entity)] = math::Matrix4f::translation(transform.position) *
+            transform.rotation.toMatrix() * math::Matrix4f::scale(transform.scale);
+    };
+
+    BENCHMARK(modeName + " physics + rebuild every matrix (5% of 100000 moving)") {
+        physicsSystem->update(0.016f);
+        coordinator.view<const Transform>().each(rebuild);
+        return matrices[entityCount - 1](0, 3);
+    };
+
+    ChangeTick lastTick = coordinator.advanceChangeTick();
+    BENCHMARK(modeName + " physics + rebuild changedSince (5% of 100000 moving)") {
+        physicsSystem->update(0.016f);
+        const ChangeTick since = lastTick;
+        lastTick = coordinator.advanceChangeTick();
+        coordinator.view<const Transform>().changedSince<Transform>(since).each(rebuild);
+        return matrices[entityCount - 1](0, 3);
+    };
+}
+
+TEST_CASE("ECS signature matching", "[.][benchmark][ECS][Signature]") {
+    constexpr size_t signatureCount = 100000;
+
+    // Entities with about half of the first 32 component types, tested
+    // against a system that needs three of them
+    std::mt19937 random(11);
+    std::vector<std::bitset<32>> narrow(signatureCount);
+    std::vector<std::bitset<MAX_COMPONENTS>> wideBitsets(signatureCount);
+    std::vector<Signature> signatures(signatureCount);
+    for (size_t i = 0; i < signatureCount; ++i) {
+        const std::uint32_t bits = static_cast<std::uint32_t>(random());
+        narrow[i] = std::bitset<32>(bits);
+        for (size_t bit = 0; bit < 32; ++bit) {
+            if (bits & (1u << bit)) {
+                wideBitsets[i].set(bit);
+                signatures[i].set(bit);
+            }
+        }
+    }
+
+    std::bitset<32> narrowRequired;
+    std::bitset<MAX_COMPONENTS> wideRequired;
+    Signature required;
+    for (size_t bit : { 1, 7, 20 }) {
+        narrowRequired.set(bit);
+        wideRequired.set(bit);
+        required.set(bit);
+    }
+
+    BENCHMARK("std::bitset<32> (s & r) == r (100000 signatures)") {
+        size_t matches = 0;
+        for (const auto& signature : narrow) {
+            matches += (signature & narrowRequired) == narrowRequired ? 1 : 0;
+        }
+        return matches;
+    };
+
+    BENCHMARK("std::bitset<" + std::to_string(MAX_COMPONENTS) + "> (s & r) == r (100000 signatures)") {
+        size_t matches = 0;
+        for (const auto& signature : wideBitsets) {
+            matches += (signature & wideRequired) == wideRequired ? 1 : 0;
+        }
+        return matches;
+    };
+
+    BENCHMARK("Signature<" + std::to_string(MAX_COMPONENTS) + ">::containsAll (100000 signatures)") {
+        size_t matches = 0;
+        for (const auto& signature : signatures) {
+            matches += signature.containsAll(required) ? 1 : 0;
+        }
+        return matches;
+    };
+}
+
+TEST_CASE("ECS hierarchy propagation", "[.][benchmark][ECS][Hierarchy]") {
+    const size_t nodeCount = GENERATE(size_t{ 10000 }, size_t{ 100000 });
+    const std::string countName = std::to_string(nodeCount);
+
+    auto coordinator = createCoordinator();
+    coordinator->registerComponent<Transform>();
+    coordinator->registerComponent<Parent>();
+    coordinator->registerComponent<Children>();
+
+    auto hierarchy = coordinator->registerSystem<HierarchySystem>(coordinator.get());
+    Signature signature;
+    signature.set(coordinator->getComponentType<Transform>());
+    coordinator->setSystemSignature<HierarchySystem>(signature);
+
+    // The same random tree twice: as ECS relationships and as a SceneNode
+    // pointer tree synced by TransformSyncSystem. Every node picks an
+    // earlier node as its parent.
+    std::vector<Entity> entities(nodeCount);
+    std::vector<scene::SceneNode*> nodes(nodeCount);
+    auto rootNode = std::make_unique<scene::SceneNode>("root");
+    scene::TransformSyncSystem transformSync;
+    transformSync.setCoordinator(coordinator.get());
+
+    std::mt19937 random(15);
+    for (size_t i = 0; i < nodeCount; ++i) {
+        entities[i] = coordinator->createEntity();
+        coordinator->addComponent(entities[i], Transform{ math::Vec3f{1.0f, 0.5f, 0.0f}, math::Quatf{ math::Vec3f{0.0f, 0.0f, 0.1f} } });
+
+        auto node = std::make_unique<scene::SceneNode>(entities[i]);
+        if (i == 0) {
+            nodes[i] = rootNode->addChild(std::move(node));
+        } else {
+            const size_t parent = std::uniform_int_distribution<size_t>(0, i - 1)(random);
+            hierarchy->setParent(entities[i], entities[parent]);
+            nodes[i] = nodes[parent]->addChild(std::move(node));
+        }
+        transformSync.registerNode(entities[i], nodes[i]);
+    }
+    transformSync.addRootNode(rootNode.get());
+    hierarchy->update(0.0f);
+    transformSync.update(0.0f);
+
+    // Moving the root invalidates every world matrix in both paths
+    BENCHMARK("SceneNode + TransformSyncSystem (" + countName + " nodes)") {
+        coordinator->getComponent<Transform>(entities[0]).position[0] += 1.0f;
+        transformSync.update(0.0f);
+        return nodes[nodeCount - 1]->getWorldMatrix()(0, 3);
+    };
+
+    BENCHMARK("HierarchySystem linear pass (" + countName + " nodes)") {
+        coordinator->getComponent<Transform>(entities[0]).position[0] += 1.0f;
+        hierarchy->update(0.0f);
+        return hierarchy->getWorldMatrix(entities[nodeCount - 1])(0, 3);
+    };
+}
+
+TEST_CASE("ECS snapshot", "[.][benchmark][ECS][Snapshot]") {
+    constexpr size_t entityCount = 10000;
+    constexpr size_t moverCount = entityCount / 20;
+
+    auto storageMode = GENERATE(StorageMode::Sparse, StorageMode::Archetype);
+    const std::string modeName = storageMode == StorageMode::Sparse ? "sparse" : "archetype";
+
+    auto coordinators = makePhysicsCoordinators(1, storageMode);
+    Coordinator& coordinator = *coordinators.front();
+    auto physicsSystem = coordinator.getSystem<PhysicsSystem>();
+
+    coordinator.createEntities(entityCount - moverCount, Transform{}, Health{});
+    coordinator.createEntities(moverCount, Transform{}, Velocity{ math::Vec3f{1.0f, 0.0f, 0.0f} });
+
+    WorldSnapshot base;
+    WorldSnapshot snapshot;
+    coordinator.snapshot(base);
+    coordinator.snapshot(snapshot);
+
+    BENCHMARK(modeName + " full snapshot (10000 entities)") {
+        coordinator.snapshot(snapshot);
+        return snapshot.getStoredBytes();
+    };
+
+    BENCHMARK(modeName + " restore (10000 entities)") {
+        coordinator.restore(snapshot);
+        return coordinator.getLivingEntityCount();
+    };
+
+    // 5% of the entities move between snapshots
+    WorldSnapshot delta;
+    BENCHMARK(modeName + " delta snapshot (5% of 10000 moving)") {
+        physicsSystem->update(0.016f);
+        coordinator.snapshot(delta, base);
+        return delta.getStoredBytes();
+    };
+}
+
+TEST_CASE("ECS world file load", "[.][benchmark][ECS][WorldFile]") {
+    constexpr size_t entityCount = 10000;
+    const std::string path = (std::filesystem::temp_directory_path() / "ecs_world_file_benchmark.ecsw").string();
+
+    auto storageMode = GENERATE(StorageMode::Sparse, StorageMode::Archetype);
+    const std::string modeName = storageMode == StorageMode::Sparse ? "sparse" : "archetype";
+
+    WorldSchema schema;
+    schema.add<Transform>("Transform").add<Velocity>("Velocity").add<Health>("Health");
+
+    // The in-code setup a scene performs today, one call per component
+    auto buildInCode = [](Coordinator& coordinator) {
+        for (size_t i = 0; i < entityCount; ++i) {
+            Entity entity = coordinator.createEntity();
+            coordinator.addComponent(entity, Transform{ math::Vec3f{static_cast<float>(i), 0.0f, 0.0f} });
+            coordinator.addComponent(entity, i % 2 == 0 ? Health{} : Health{ 50.0f });
+            if (i % 4 == 0) {
+                coordinator.addComponent(entity, Velocity{ math::Vec3f{1.0f, 0.0f, 0.0f} });
+            }
+        }
+    };
+
+    {
+        auto source = makePhysicsCoordinators(1, storageMode);
+        buildInCode(*source.front());
+        source.front()->saveWorld(path, schema);
+    }
+
+    BENCHMARK_ADVANCED(modeName + " in-code setup (10000 entities)")(Catch::Benchmark::Chronometer meter) {
+        auto coordinators = makePhysicsCoordinators(meter.runs(), storageMode);
+        meter.measure([&](int run) {
+            buildInCode(*coordinators[run]);
+            return coordinators[run]->getLivingEntityCount();
+        });
+    };
+
+    BENCHMARK_ADVANCED(modeName + " world file load (10000 entities)")(Catch::Benchmark::Chronometer meter) {
+        auto coordinators = makePhysicsCoordinators(meter.runs(), storageMode);
+        meter.measure([&](int run) {
+            coordinators[run]->loadWorld(path, schema);
+            return coordinators[run]->getLivingEntityCount();
+        });
+    };
+
+    std::filesystem::remove(path);
+}
+
+namespace {
+
+    struct BenchMoveEvent {
+        float x;
+        float y;
+
+        BenchMoveEvent(float x, float y) : x(x), y(y) {}
+    };
+
+    /// Same size as an SDL_Event, like events::RawInputEvent
+    struct BenchRawEvent {
+        uint32_t type;
+        unsigned char payload[52];
+
+        explicit BenchRawEvent(uint32_t type) : type(type), payload{} {}
+    };
+
+    /**
+     * @brief Reference copy of the previous EventBus emit path: one mutex around typed queues
+     *
+     * Kept here only so the contention benchmark can compare the per-thread
+     * lanes against the lock they replaced.
+     */
+    template<typename T>
+    class MutexEventQueue {
+        std::mutex mMutex;
+        std::vector<T> mEvents;
+
+    public:
+        template<typename... Args>
+        void emit(Args&&... args) {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mEvents.emplace_back(std::forward<Args>(args)...);
+        }
+
+        size_t update() {
+            std::lock_guard<std::mutex> lock(mMutex);
+            const size_t count = mEvents.size();
+            mEvents.clear();
+            return count;
+        }
+    };
+
+    /**
+     * @brief Reference of the usual subscriber design: std::function handlers in a type_index map
+     *
+     * Kept here only so the handler benchmark can compare the EventBus
+     * dispatch tables against a hash lookup and std::function per dispatch.
+     */
+    class FunctionEventDispatcher {
+        std::unordered_map<std::type_index, std::vector<std::function<void(const void*)>>> mHandlers;
+
+    public:
+        template<typename T, typename Function>
+        void subscribe(Function&& function) {
+            mHandlers[std::type_index(typeid(T))].emplace_back(
+                [function = std::forward<Function>(function)](const void* event) { function(*static_cast<const T*>(event)); });
+        }
+
+        template<typename T>
+        void dispatch(const T& event) {
+            auto handlers = mHandlers.find(std::type_index(typeid(T)));
+            if (handlers != mHandlers.end()) {
+                for (const auto& handler : handlers->second) {
+                    handler(&event);
+                }
+            }
+        }
+    };
+
+    struct BenchMoveListener {
+        float moved = 0.0f;
+
+        void onMove(const BenchMoveEvent& event) { moved += event.x; }
+    };
+
+    /// Runs emitOne(thread, i) for eventCount events split over threadCount threads
+    template<typename Function>
+    void emitFromThreads(size_t threadCount, size_t eventCount, Function emitOne) {
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < threadCount; ++t) {
+            threads.emplace_back([&emitOne, t, count = eventCount / threadCount] {
+                for (size_t i = 0; i < count; ++i) {
+                    emitOne(t, i);
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+}
+
+TEST_CASE("ECS event bus", "[.][benchmark][ECS][Events]") {
+    EventBus bus;
+
+    // One frame of input traffic: a MoveIntent plus a burst of raw events
+    BENCHMARK("emit + read + frame end (1 move, 64 raw events)") {
+        bus.emit<BenchMoveEvent>(1.0f, 0.0f);
+        for (uint32_t i = 0; i < 64; ++i) {
+            bus.emit<BenchRawEvent>(i);
+        }
+
+        float moved = 0.0f;
+        for (const auto& event : bus.read<BenchMoveEvent>()) {
+            moved += event.x;
+        }
+        uint32_t types = 0;
+        for (const auto& event : bus.read<BenchRawEvent>()) {
+            types += event.type;
+        }
+        bus.update();
+        return moved + static_cast<float>(types);
+    };
+
+    BENCHMARK("emit 10000 events + frame end") {
+        for (int i = 0; i < 10000; ++i) {
+            bus.emit<BenchMoveEvent>(static_cast<float>(i), 0.0f);
+        }
+        bus.update();
+        return bus.getTotalEventCount();
+    };
+}
+
+TEST_CASE("ECS event handlers", "[.][benchmark][ECS][Events]") {
+    constexpr int eventCount = 10000;
+    std::array<BenchMoveListener, 4> listeners;
+
+    FunctionEventDispatcher reference;
+    for (auto& listener : listeners) {
+        reference.subscribe<BenchMoveEvent>([&listener](const BenchMoveEvent& event) { listener.onMove(event); });
+    }
+    BENCHMARK("std::function + type_index map, 10000 events to 4 handlers") {
+        for (int i = 0; i < eventCount; ++i) {
+            reference.dispatch(BenchMoveEvent(static_cast<float>(i), 0.0f));
+        }
+        return listeners[0].moved;
+    };
+
+    EventBus polled;
+    BENCHMARK("EventBus emit + frame end + 4 readers polling, 10000 events") {
+        for (int i = 0; i < eventCount; ++i) {
+            polled.emit<BenchMoveEvent>(static_cast<float>(i), 0.0f);
+        }
+        polled.update();
+        for (auto& listener : listeners) {
+            for (const auto& event : polled.read<BenchMoveEvent>()) {
+                listener.onMove(event);
+            }
+        }
+        return listeners[0].moved;
+    };
+
+    EventBus bus;
+    for (auto& listener : listeners) {
+        bus.subscribe<BenchMoveEvent, &BenchMoveListener::onMove>(listener);
+    }
+    BENCHMARK("EventBus emit to 4 handlers + frame end, 10000 events") {
+        for (int i = 0; i < eventCount; ++i) {
+            bus.emit<BenchMoveEvent>(static_cast<float>(i), 0.0f);
+        }
+        bus.update();
+        return listeners[0].moved;
+    };
+}
+
+TEST_CASE("ECS event recording", "[.][benchmark][ECS][Events]") {
+    const std::string path = (std::filesystem::temp_directory_path() / "ecs_event_recording_bench.ecse").string();
+    EventBus bus;
+    auto inputFrame = [&bus] {
+        bus.emit<BenchMoveEvent>(1.0f, 0.0f);
+        for (uint32_t i = 0; i < 64; ++i) {
+            bus.emit<BenchRawEvent>(i);
+        }
+        bus.update();
+        return bus.getTotalEventCount();
+    };
+
+    BENCHMARK("emit + frame end, not recorded (1 move, 64 raw events)") {
+        return inputFrame();
+    };
+
+    {
+        EventRecorder recorder(bus, path, 1.0f / 60.0f);
+        recorder.addType<BenchMoveEvent>("BenchMoveEvent");
+        recorder.addType<BenchRawEvent>("BenchRawEvent");
+        recorder.start();
+
+        BENCHMARK("emit + frame end, recorded (1 move, 64 raw events)") {
+            return inputFrame();
+        };
+        recorder.stop();
+    }
+
+    // A fixed-length session for the replay side
+    {
+        EventRecorder recorder(bus, path, 1.0f / 60.0f);
+        recorder.addType<BenchMoveEvent>("BenchMoveEvent");
+        recorder.addType<BenchRawEvent>("BenchRawEvent");
+        recorder.start();
+        for (int frame = 0; frame < 1000; ++frame) {
+            inputFrame();
+        }
+        recorder.stop();
+    }
+
+    EventReplay replay(path);
+    replay.addType<BenchMoveEvent>("BenchMoveEvent");
+    replay.addType<BenchRawEvent>("BenchRawEvent");
+    BENCHMARK("replay 1000 frames (1 move, 64 raw events each)") {
+        replay.rewind();
+        uint32_t types = 0;
+        while (!replay.isFinished()) {
+            replay.forEach<BenchRawEvent>([&types](const BenchRawEvent& event) { types += event.type; });
+            replay.nextFrame();
+        }
+        return types;
+    };
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("ECS event bus contention", "[.][benchmark][ECS][Events]") {
+    constexpr size_t eventCount = 1000000;
+    const size_t threadCount = GENERATE(1, 8);
+    const std::string threads = std::to_string(threadCount) + " threads";
+
+    EventBus bus;
+    MutexEventQueue<BenchMoveEvent> locked;
+
+    BENCHMARK("mutex queue, " + threads + " emitting 1M events + frame end") {
+        emitFromThreads(threadCount, eventCount, [&locked](size_t, size_t i) {
+            locked.emit(static_cast<float>(i), 0.0f);
+        });
+        return locked.update();
+    };
+
+    BENCHMARK("EventBus lanes, " + threads + " emitting 1M events + frame end") {
+        emitFromThreads(threadCount, eventCount, [&bus](size_t t, size_t i) {
+            EventSourceScope source(static_cast<uint32_t>(t));
+            bus.emit<BenchMoveEvent>(static_cast<float>(i), 0.0f);
+        });
+        bus.update();
+        return bus.getEventCount<BenchMoveEvent>();
+    };
+}
@@ -1,8 +1,26 @@
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/catch_approx.hpp>
+#include <catch2/generators/catch_generators.hpp>
 #include "../ecs/ECS.h"
 #include "../ecs/components/CommonComponents.h"
 #include "../ecs/systems/CommonSystems.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
 using namespace ecs;
 using namespace ecs::components;
@@ -30,7 +48,45 @@ TEST_CASE("ECS Basic Entity Management", "[ECS][Entity]") {
         Entity entity4 = coordinator->createEntity();
         REQUIRE(coordinator->getLivingEntityCount() == 3);
         // Just verify we have a valid entity ID
-        REQUIRE(entity4 < MAX_ENTITIES);
+        REQUIRE(entityIndex(entity4) < MAX_ENTITIES);
+    }
+
+    SECTION("Recycled slots get a new generation") {
+        Entity entity1 = coordinator->createEntity();
+        coordinator->destroyEntity(entity1);
+        Entity entity2 = coordinator->createEntity();
+
+        // Same slot, different handle
+        REQUIRE(entityIndex(entity2) == entityIndex(entity1));
+        REQUIRE(entityGeneration(entity2) == entityGeneration(entity1) + 1);
+        REQUIRE(entity2 != entity1);
+
+        REQUIRE_FALSE(coordinator->isAlive(entity1));
+        REQUIRE(coordinator->isAlive(entity2));
+        REQUIRE_FALSE(coordinator->isAlive(NULL_ENTITY));
+    }
+
+    SECTION("Stale handles do not see the new entity's components") {
+        coordinator->registerComponent<Transform>();
+
+        Entity stale = coordinator->createEntity();
+        coordinator->destroyEntity(stale);
+
+        Entity fresh = coordinator->createEntity();
+        coordinator->addComponent(fresh, Transform{});
+
+        REQUIRE(coordinator->hasComponent<Transform>(fresh));
+        REQUIRE_FALSE(coordinator->hasComponent<Transform>(stale));
+    }
+
+    SECTION("Free slots are reused most recently destroyed first") {
+        Entity a = coordinator->createEntity();
+        Entity b = coordinator->createEntity();
+        coordinator->destroyEntity(a);
+        coordinator->destroyEntity(b);
+
+        REQUIRE(entityIndex(coordinator->createEntity()) == entityIndex(b));
+        REQUIRE(entityIndex(coordinator->createEntity()) == entityIndex(a));
     }
 
     SECTION("Entity signature management") {
@@ -173,6 +229,51 @@ TEST_CASE("ECS System Management", "[ECS][System]") {
         REQUIRE_FALSE(physicsSystem->hasEntity(entity2));
         REQUIRE(physicsSystem->hasEntity(entity3));
     }
+
+    SECTION("Membership stays consistent through removals and recycling") {
+        auto physicsSystem = coordinator->registerSystem<PhysicsSystem>(coordinator.get());
+        Signature physicsSignature;
+        physicsSignature.set(coordinator->getComponentType<Transform>());
+        physicsSignature.set(coordinator->getComponentType<Velocity>());
+        coordinator->setSystemSignature<PhysicsSystem>(physicsSignature);
+
+        std::vector<Entity> entities;
+        for (int i = 0; i < 100; ++i) {
+            Entity entity = coordinator->createEntity();
+            coordinator->addComponent(entity, Transform{});
+            coordinator->addComponent(entity, Velocity{});
+            entities.push_back(entity);
+        }
+
+        // Adding a component the system does not need must not duplicate members
+        coordinator->addComponent(entities[0], Health{});
+        REQUIRE(physicsSystem->getEntityCount() == 100);
+
+        for (size_t i = 0; i < entities.size(); i += 2) {
+            coordinator->destroyEntity(entities[i]);
+        }
+        REQUIRE(physicsSystem->getEntityCount() == 50);
+
+        // A recycled slot is a new member; the stale handle is not
+        Entity recycled = coordinator->createEntity();
+        coordinator->addComponent(recycled, Transform{});
+        coordinator->addComponent(recycled, Velocity{});
+        REQUIRE(physicsSystem->hasEntity(recycled));
+        REQUIRE(physicsSystem->getEntityCount() == 51);
+
+        size_t staleMembers = 0;
+        for (size_t i = 0; i < entities.size(); i += 2) {
+            staleMembers += physicsSystem->hasEntity(entities[i]) ? 1 : 0;
+        }
+        REQUIRE(staleMembers == 0);
+
+        const auto& members = physicsSystem->getEntities();
+        REQUIRE(members.size() == 51);
+        REQUIRE(std::count(members.begin(), members.end(), recycled) == 1);
+        for (size_t i = 1; i < entities.size(); i += 2) {
+            REQUIRE(std::find(members.begin(), members.end(), entities[i]) != members.end());
+        }
+    }
 }
 
 TEST_CASE("ECS Physics System", "[ECS][Physics]") {
@@ -258,8 +359,12 @@ TEST_CASE("ECS Health System", "[ECS][Health]") {
         // Damage the entity to death
         healthSystem->damageEntity(entity, 60.0f);
 
-        // Update the health system - should destroy the entity
+        // Update the health system - should queue the entity for destruction
         healthSystem->update(0.016f);
+        REQUIRE(coordinator->getLivingEntityCount() == 1);
+        REQUIRE(coordinator->getCommandBuffer().getCommandCount() == 1);
+
+        coordinator->playbackCommands();
 
         REQUIRE(coordinator->getLivingEntityCount() == 0);
         REQUIRE(healthSystem->getEntityCount() == 0);
@@ -340,6 +445,2303 @@ TEST_CASE("ECS Component Array Functionality", "[ECS][ComponentArray]") {
     }
 }
 
+TEST_CASE("ECS Sparse Set", "[ECS][SparseSet]") {
+    SparseSet set;
+
+    SECTION("Insertion assigns dense indices in order") {
+        REQUIRE(set.insert(10) == 0);
+        REQUIRE(set.insert(3) == 1);
+        REQUIRE(set.insert(4100) == 2); // Lands on a second sparse page
+
+        REQUIRE(set.size() == 3);
+        REQUIRE(set.contains(10));
+        REQUIRE(set.contains(3));
+        REQUIRE(set.contains(4100));
+        REQUIRE_FALSE(set.contains(11));
+        REQUIRE(set.index(4100) == 2);
+        REQUIRE(set.getPageCount() == 2);
+    }
+
+    SECTION("Erase swaps the last entity into the vacated slot") {
+        set.insert(1);
+        set.insert(2);
+        set.insert(3);
+
+        REQUIRE(set.erase(1) == 0);
+        REQUIRE(set.size() == 2);
+        REQUIRE_FALSE(set.contains(1));
+        REQUIRE(set[0] == 3);
+        REQUIRE(set.index(3) == 0);
+        REQUIRE(set.index(2) == 1);
+
+        // Erasing the last element leaves the others untouched
+        REQUIRE(set.erase(2) == 1);
+        REQUIRE(set.size() == 1);
+        REQUIRE(set.index(3) == 0);
+    }
+
+    SECTION("Lookups outside allocated pages are misses") {
+        set.insert(5);
+        REQUIRE_FALSE(set.contains(MAX_ENTITIES - 1));
+        REQUIRE(set.getPageCount() == 1);
+    }
+
+    SECTION("Clear keeps pages but empties the set") {
+        set.insert(7);
+        set.insert(8);
+        set.clear();
+
+        REQUIRE(set.empty());
+        REQUIRE_FALSE(set.contains(7));
+        REQUIRE(set.insert(8) == 0);
+    }
+}
+
+namespace {
+
+    /// Distinct component types, to push type IDs past the old 32-bit signature
+    template<size_t N>
+    struct WideComponent {
+        size_t value = N;
+    };
+
+} // namespace
+
+TEST_CASE("ECS Signature", "[ECS][Signature]") {
+    STATIC_REQUIRE(Signature::size() == MAX_COMPONENTS);
+    STATIC_REQUIRE(alignof(Signature) >= std::min<size_t>(MAX_COMPONENTS / 8, 32));
+
+    SECTION("Bits in every word can be set, tested and cleared") {
+        Signature signature;
+        REQUIRE(signature.none());
+        for (size_t bit : { size_t{ 0 }, size_t{ 31 }, size_t{ 63 }, MAX_COMPONENTS - 1 }) {
+            signature.set(bit);
+            REQUIRE(signature.test(bit));
+        }
+        REQUIRE(signature.count() == 4);
+
+        std::vector<size_t> visited;
+        signature.forEachSet([&visited](size_t bit) { visited.push_back(bit); });
+        REQUIRE(visited == std::vector<size_t>{ 0, 31, 63, MAX_COMPONENTS - 1 });
+
+        signature.reset(MAX_COMPONENTS - 1);
+        REQUIRE_FALSE(signature.test(MAX_COMPONENTS - 1));
+        signature.reset();
+        REQUIRE(signature.none());
+    }
+
+    SECTION("containsAll matches the bitwise definition") {
+        std::mt19937 random(7);
+        auto randomSignature = [&random](size_t density) {
+            Signature signature;
+            for (size_t bit = 0; bit < MAX_COMPONENTS; ++bit) {
+                if (random() % density == 0) {
+                    signature.set(bit);
+                }
+            }
+            return signature;
+        };
+
+        size_t wrong = 0;
+        size_t matches = 0;
+        for (int i = 0; i < 2000; ++i) {
+            Signature entity = randomSignature(2);
+            Signature required = randomSignature(i % 2 == 0 ? 16 : 4);
+            if (i % 3 == 0) {
+                entity |= required;
+            }
+            const bool expected = (entity & required) == required;
+            wrong += entity.containsAll(required) == expected ? 0 : 1;
+            matches += expected ? 1 : 0;
+        }
+        REQUIRE(wrong == 0);
+        REQUIRE(matches > 0);
+        REQUIRE(matches < 2000);
+    }
+
+    SECTION("Equal signatures hash equally") {
+        Signature a;
+        Signature b;
+        a.set(3).set(MAX_COMPONENTS - 2);
+        b.set(MAX_COMPONENTS - 2).set(3);
+        REQUIRE(a == b);
+        REQUIRE(std::hash<Signature>{}(a) == std::hash<Signature>{}(b));
+        REQUIRE(a.intersects(b));
+        REQUIRE_FALSE(a.intersects(~a));
+    }
+
+    SECTION("More than 32 component types work in both storage modes") {
+        auto mode = GENERATE(StorageMode::Sparse, StorageMode::Archetype);
+        auto coordinator = createCoordinator(mode);
+        coordinator->registerComponent<Transform>();
+
+        constexpr size_t wideCount = 40;
+        [&]<size_t... N>(std::index_sequence<N...>) {
+            (coordinator->registerComponent<WideComponent<N>>(), ...);
+        }(std::make_index_sequence<wideCount>{});
+        const ComponentType lastType = coordinator->getComponentType<WideComponent<wideCount - 1>>();
+        REQUIRE(lastType >= 32);
+
+        auto physicsSystem = coordinator->registerSystem<PhysicsSystem>(coordinator.get());
+        Entity entity = coordinator->createEntity();
+        coordinator->addComponent(entity, Transform{});
+        coordinator->addComponent(entity, WideComponent<wideCount - 1>{});
+
+        Signature signature;
+        signature.set(coordinator->getComponentType<Transform>());
+        signature.set(lastType);
+        coordinator->setSystemSignature<PhysicsSystem>(signature);
+        REQUIRE(physicsSystem->hasEntity(entity));
+        REQUIRE(coordinator->getComponent<WideComponent<wideCount - 1>>(entity).value == wideCount - 1);
+
+        coordinator->removeComponent<WideComponent<wideCount - 1>>(entity);
+        REQUIRE_FALSE(physicsSystem->hasEntity(entity));
+    }
+}
+
+TEST_CASE("ECS Growable Storage", "[ECS][Storage]") {
+    SECTION("Component arrays allocate nothing until used") {
+        ComponentArray<Transform> transformArray;
+        REQUIRE(transformArray.getCapacity() == 0);
+
+        transformArray.insertData(0, Transform{});
+        REQUIRE(transformArray.getCapacity() == ChunkedArray<Transform>::CHUNK_SIZE);
+    }
+
+    SECTION("References stay valid while the array grows") {
+        ComponentArray<Transform> transformArray;
+        transformArray.insertData(0, Transform{ math::Vec3f{7.0f, 0.0f, 0.0f} });
+        Transform& first = transformArray.getData(0);
+
+        for (Entity entity = 1; entity < 3 * ChunkedArray<Transform>::CHUNK_SIZE; ++entity) {
+            transformArray.insertData(entity, Transform{});
+        }
+
+        REQUIRE(&first == &transformArray.getData(0));
+        REQUIRE(first.position[0] == Catch::Approx(7.0f));
+    }
+
+    SECTION("More entities than the former 5000 cap") {
+        auto coordinator = createCoordinator();
+        coordinator->registerComponent<Velocity>();
+
+        constexpr size_t entityCount = 100000;
+        for (size_t i = 0; i < entityCount; ++i) {
+            Entity entity = coordinator->createEntity();
+            coordinator->addComponent(entity, Velocity{ math::Vec3f{static_cast<float>(i), 0.0f, 0.0f} });
+        }
+
+        REQUIRE(coordinator->getLivingEntityCount() == entityCount);
+        REQUIRE(coordinator->getComponentCount<Velocity>() == entityCount);
+    }
+}
+
+namespace {
+
+    /// Larger than a whole archetype chunk
+    struct TestOversizedComponent {
+        std::array<float, 5000> values;
+    };
+
+    /// Aligned beyond a cache line
+    struct alignas(256) TestOveralignedComponent {
+        float value;
+    };
+}
+
+TEST_CASE("ECS Archetype Storage", "[ECS][Archetype]") {
+    auto coordinator = createCoordinator(StorageMode::Archetype);
+    REQUIRE(coordinator->getStorageMode() == StorageMode::Archetype);
+
+    coordinator->registerComponent<Transform>();
+    coordinator->registerComponent<Velocity>();
+    coordinator->registerComponent<Health>();
+
+    SECTION("Components survive moves between archetypes") {
+        Entity entity = coordinator->createEntity();
+        coordinator->addComponent(entity, Transform{ math::Vec3f{1.0f, 2.0f, 3.0f} });
+        coordinator->addComponent(entity, Velocity{ math::Vec3f{4.0f, 0.0f, 0.0f} });
+        coordinator->addComponent(entity, Health{ 75.0f });
+
+        REQUIRE(coordinator->hasComponent<Velocity>(entity));
+        REQUIRE(coordinator->getComponent<Transform>(entity).position[1] == Catch::Approx(2.0f));
+        REQUIRE(coordinator->getComponent<Health>(entity).current == Catch::Approx(75.0f));
+
+        coordinator->removeComponent<Velocity>(entity);
+
+        REQUIRE_FALSE(coordinator->hasComponent<Velocity>(entity));
+        REQUIRE(coordinator->getComponent<Transform>(entity).position[2] == Catch::Approx(3.0f));
+        REQUIRE(coordinator->getComponent<Health>(entity).current == Catch::Approx(75.0f));
+        REQUIRE(coordinator->getComponentCount<Velocity>() == 0);
+        REQUIRE(coordinator->getComponentCount<Transform>() == 1);
+    }
+
+    SECTION("Rows moved to fill holes keep their data") {
+        std::vector<Entity> entities;
+        for (int i = 0; i < 10; ++i) {
+            Entity entity = coordinator->createEntity();
+            coordinator->addComponent(entity, Transform{ math::Vec3f{static_cast<float>(i), 0.0f, 0.0f} });
+            entities.push_back(entity);
+        }
+
+        coordinator->destroyEntity(entities[2]);
+        coordinator->removeComponent<Transform>(entities[5]);
+
+        REQUIRE(coordinator->getComponentCount<Transform>() == 8);
+        REQUIRE_FALSE(coordinator->hasComponent<Transform>(entities[2]));
+        for (int i : { 0, 1, 3, 4, 6, 7, 8, 9 }) {
+            REQUIRE(coordinator->getComponent<Transform>(entities[i]).position[0] == Catch::Approx(static_cast<float>(i)));
+        }
+    }
+
+    SECTION("Chunk iteration visits every matching entity once") {
+        constexpr size_t entityCount = 5000;
+        for (size_t i = 0; i < entityCount; ++i) {
+            Entity entity = coordinator->createEntity();
+            coordinator->addComponent(entity, Transform{});
+            if (i % 2 == 0) {
+                coordinator->addComponent(entity, Velocity{});
+            }
+            if (i % 3 == 0) {
+                coordinator->addComponent(entity, Health{});
+            }
+        }
+
+        size_t visited = 0;
+        size_t chunks = 0;
+        coordinator->forEachChunk<Transform, Velocity>([&](size_t count, const Entity* chunkEntities, Transform*, Velocity*) {
+            for (size_t i = 0; i < count; ++i) {
+                REQUIRE(coordinator->hasComponent<Velocity>(chunkEntities[i]));
+            }
+            visited += count;
+            ++chunks;
+        });
+
+        REQUIRE(visited == entityCount / 2);
+        REQUIRE(chunks > 2); // Two archetypes match, each spanning several chunks
+    }
+
+    SECTION("Chunk columns are cache-line aligned and fit in 16KiB") {
+        Signature signature;
+        signature.set(coordinator->getComponentType<Transform>());
+        signature.set(coordinator->getComponentType<Health>());
+
+        std::array<ComponentInfo, MAX_COMPONENTS> infos{};
+        infos[coordinator->getComponentType<Transform>()] = ComponentInfo::create<Transform>();
+        infos[coordinator->getComponentType<Health>()] = ComponentInfo::create<Health>();
+
+        Archetype archetype(signature, infos);
+        archetype.allocateRow(0);
+
+        const size_t capacity = archetype.getChunkCapacity();
+        REQUIRE(capacity * (sizeof(Entity) + sizeof(Transform) + sizeof(Health)) <= Archetype::CHUNK_BYTES);
+
+        auto address = [](const void* pointer) { return reinterpret_cast<std::uintptr_t>(pointer); };
+        auto* transforms = archetype.getColumn(coordinator->getComponentType<Transform>(), 0);
+        auto* healths = archetype.getColumn(coordinator->getComponentType<Health>(), 0);
+        REQUIRE(address(transforms) % Archetype::COLUMN_ALIGNMENT == 0);
+        REQUIRE(address(healths) % Archetype::COLUMN_ALIGNMENT == 0);
+        REQUIRE(address(healths) + capacity * sizeof(Health) <= address(archetype.getEntities(0)) + Archetype::CHUNK_BYTES);
+
+        // Rows not yet used are zeroed, so snapshots never copy indeterminate bytes
+        const auto* unused = static_cast<const std::byte*>(healths) + sizeof(Health);
+        REQUIRE(std::all_of(unused, unused + (capacity - 1) * sizeof(Health), [](std::byte value) { return value == std::byte{ 0 }; }));
+
+        ::new (transforms) Transform{};
+        ::new (healths) Health{};
+    }
+
+    SECTION("Rows larger than a chunk and over-aligned columns get chunks that fit them") {
+        coordinator->registerComponent<TestOversizedComponent>();
+        coordinator->registerComponent<TestOveralignedComponent>();
+
+        auto address = [](const void* pointer) { return reinterpret_cast<std::uintptr_t>(pointer); };
+        std::vector<Entity> entities;
+        for (int i = 0; i < 3; ++i) {
+            Entity entity = coordinator->createEntity();
+            TestOversizedComponent oversized{};
+            oversized.values.back() = static_cast<float>(i);
+            coordinator->addComponent(entity, oversized);
+            coordinator->addComponent(entity, TestOveralignedComponent{ static_cast<float>(i) });
+            entities.push_back(entity);
+        }
+
+        for (int i = 0; i < 3; ++i) {
+            REQUIRE(coordinator->getComponent<TestOversizedComponent>(entities[i]).values.back() == static_cast<float>(i));
+            const auto& overaligned = coordinator->getComponent<TestOveralignedComponent>(entities[i]);
+            REQUIRE(overaligned.value == static_cast<float>(i));
+            REQUIRE(address(&overaligned) % alignof(TestOveralignedComponent) == 0);
+        }
+
+        Signature signature;
+        signature.set(coordinator->getComponentType<TestOversizedComponent>());
+        std::array<ComponentInfo, MAX_COMPONENTS> infos{};
+        infos[coordinator->getComponentType<TestOversizedComponent>()] = ComponentInfo::create<TestOversizedComponent>();
+        Archetype archetype(signature, infos);
+        REQUIRE(archetype.getChunkCapacity() == 1);
+        REQUIRE(archetype.getChunkBytes() >= Archetype::COLUMN_ALIGNMENT + sizeof(TestOversizedComponent));
+    }
+
+    SECTION("Physics system integrates through chunks") {
+        auto physicsSystem = coordinator->registerSystem<PhysicsSystem>(coordinator.get());
+
+        Signature physicsSignature;
+        physicsSignature.set(coordinator->getComponentType<Transform>());
+        physicsSignature.set(coordinator->getComponentType<Velocity>());
+        coordinator->setSystemSignature<PhysicsSystem>(physicsSignature);
+
+        Entity entity = coordinator->createEntity();
+        coordinator->addComponent(entity, Transform{});
+        coordinator->addComponent(entity, Velocity{ math::Vec3f{1.0f, 2.0f, 3.0f} });
+
+        physicsSystem->update(0.5f);
+
+        Transform& transform = coordinator->getComponent<Transform>(entity);
+        REQUIRE(transform.position[0] == Catch::Approx(0.5f));
+        REQUIRE(transform.position[1] == Catch::Approx(1.0f));
+        REQUIRE(transform.position[2] == Catch::Approx(1.5f));
+    }
+}
+
+TEST_CASE("ECS Views", "[ECS][View]") {
+    auto mode = GENERATE(StorageMode::Sparse, StorageMode::Archetype);
+    auto coordinator = createCoordinator(mode);
+    coordinator->registerComponent<Transform>();
+    coordinator->registerComponent<Velocity>();
+    coordinator->registerComponent<Health>();
+
+    std::vector<Entity> movers;
+    for (int i = 0; i < 20; ++i) {
+        Entity entity = coordinator->createEntity();
+        coordinator->addComponent(entity, Transform{ math::Vec3f{static_cast<float>(i), 0.0f, 0.0f} });
+        if (i % 4 == 0) {
+            coordinator->addComponent(entity, Velocity{ math::Vec3f{1.0f, 0.0f, 0.0f} });
+            movers.push_back(entity);
+        }
+        if (i % 2 == 0) {
+            coordinator->addComponent(entity, Health{});
+        }
+    }
+
+    SECTION("Range-for yields only entities with every component") {
+        std::vector<Entity> visited;
+        for (auto [entity, transform, velocity] : coordinator->view<Transform, Velocity>()) {
+            REQUIRE(&transform == &coordinator->getComponent<Transform>(entity));
+            REQUIRE(velocity.linear[0] == Catch::Approx(1.0f));
+            visited.push_back(entity);
+        }
+
+        std::sort(visited.begin(), visited.end());
+        REQUIRE(visited == movers);
+    }
+
+    SECTION("each() hands out writable references") {
+        coordinator->view<Transform, Velocity>().each([](Transform& transform, const Velocity& velocity) {
+            transform.position = transform.position + velocity.linear;
+        });
+
+        // Movers were created at x = 0, 4, 8, ...
+        for (size_t i = 0; i < movers.size(); ++i) {
+            REQUIRE(coordinator->getComponent<Transform>(movers[i]).position[0] == Catch::Approx(i * 4.0f + 1.0f));
+        }
+    }
+
+    SECTION("each() can receive the entity") {
+        size_t count = 0;
+        coordinator->view<Health, Transform>().each([&](Entity entity, Health&, Transform&) {
+            REQUIRE(coordinator->hasComponent<Health>(entity));
+            ++count;
+        });
+        REQUIRE(count == 10);
+    }
+
+    SECTION("Views of unused components are empty") {
+        for (Entity entity : movers) {
+            coordinator->removeComponent<Velocity>(entity);
+        }
+        auto view = coordinator->view<Velocity>();
+        REQUIRE(view.begin() == view.end());
+    }
+}
+
+TEST_CASE("ECS Batch Creation", "[ECS][Batch]") {
+    auto mode = GENERATE(StorageMode::Sparse, StorageMode::Archetype);
+    auto coordinator = createCoordinator(mode);
+    coordinator->registerComponent<Transform>();
+    coordinator->registerComponent<Velocity>();
+    coordinator->registerComponent<Health>();
+
+    auto physicsSystem = coordinator->registerSystem<PhysicsSystem>(coordinator.get());
+    Signature physicsSignature;
+    physicsSignature.set(coordinator->getComponentType<Transform>());
+    physicsSignature.set(coordinator->getComponentType<Velocity>());
+    coordinator->setSystemSignature<PhysicsSystem>(physicsSignature);
+
+    SECTION("createEntities gives every entity the components and signature") {
+        auto entities = coordinator->createEntities(1000,
+            Transform{ math::Vec3f{1.0f, 2.0f, 3.0f} }, Velocity{ math::Vec3f{4.0f, 0.0f, 0.0f} });
+
+        REQUIRE(entities.size() == 1000);
+        REQUIRE(coordinator->getLivingEntityCount() == 1000);
+        REQUIRE(coordinator->getComponentCount<Transform>() == 1000);
+        REQUIRE(coordinator->getComponentCount<Velocity>() == 1000);
+        REQUIRE(physicsSystem->getEntityCount() == 1000);
+
+        size_t wrong = 0;
+        for (Entity entity : entities) {
+            wrong += physicsSystem->hasEntity(entity) ? 0 : 1;
+            wrong += coordinator->getComponent<Transform>(entity).position[1] == 2.0f ? 0 : 1;
+            wrong += coordinator->getComponent<Velocity>(entity).linear[0] == 4.0f ? 0 : 1;
+            wrong += coordinator->hasComponent<Health>(entity) ? 1 : 0;
+        }
+        REQUIRE(wrong == 0);
+    }
+
+    SECTION("createEntities without components only allocates handles") {
+        auto entities = coordinator->createEntities(10);
+        REQUIRE(entities.size() == 10);
+        REQUIRE(coordinator->getLivingEntityCount() == 10);
+        REQUIRE(physicsSystem->getEntityCount() == 0);
+    }
+
+    SECTION("addComponents matches adding one at a time") {
+        auto entities = coordinator->createEntities(300, Transform{});
+        REQUIRE(physicsSystem->getEntityCount() == 0);
+
+        // Give a third of them Health first, so the batch starts from two archetypes
+        for (size_t i = 0; i < entities.size(); i += 3) {
+            coordinator->addComponent(entities[i], Health{ 10.0f });
+        }
+
+        coordinator->addComponents(std::span<const Entity>(entities).subspan(100),
+            Velocity{ math::Vec3f{1.0f, 0.0f, 0.0f} });
+        REQUIRE(physicsSystem->getEntityCount() == 200);
+        REQUIRE(coordinator->getComponentCount<Velocity>() == 200);
+        REQUIRE(coordinator->getComponentCount<Health>() == 100);
+
+        size_t wrong = 0;
+        for (size_t i = 0; i < entities.size(); ++i) {
+            const bool moving = i >= 100;
+            wrong += physicsSystem->hasEntity(entities[i]) == moving ? 0 : 1;
+            wrong += coordinator->hasComponent<Velocity>(entities[i]) == moving ? 0 : 1;
+            wrong += coordinator->hasComponent<Health>(entities[i]) == (i % 3 == 0) ? 0 : 1;
+            if (i % 3 == 0) {
+                wrong += coordinator->getComponent<Health>(entities[i]).current == 10.0f ? 0 : 1;
+            }
+        }
+        REQUIRE(wrong == 0);
+
+        size_t moved = 0;
+        coordinator->view<Transform, Velocity>().each([&moved](const Transform&, const Velocity& velocity) {
+            moved += velocity.linear[0] == 1.0f ? 1 : 0;
+        });
+        REQUIRE(moved == 200);
+    }
+}
+
+namespace {
+
+    /// Renderer that only counts the quads it is handed
+    class CountingRenderer2D : public scene::IRenderer2D {
+    public:
+        uint32_t quads = 0;
+
+        bool init(const scene::RendererConfig2D&) override { return true; }
+        void beginScene(const scene::Camera2D&) override {}
+        void drawRect(const scene::Rect2D&, const scene::Color&, const scene::TextureHandle&) override { ++quads; }
+        void drawRect(const scene::Rect2D&, const scene::Color&, float, const scene::TextureHandle&, uint32_t, float) override { ++quads; }
+        void endScene() override {}
+        void shutdown() override {}
+        Stats getStats() const override { return { quads, 0, 0 }; }
+        void resetStats() override { quads = 0; }
+    };
+
+} // namespace
+
+TEST_CASE("ECS Change Tracking", "[ECS][Changes]") {
+    auto mode = GENERATE(StorageMode::Sparse, StorageMode::Archetype);
+    auto coordinator = createCoordinator(mode);
+    coordinator->registerComponent<Transform>();
+    coordinator->registerComponent<Velocity>();
+    coordinator->registerComponent<Health>();
+
+    auto entities = coordinator->createEntities(10, Transform{});
+
+    auto changedTransforms = [&](ChangeTick since) {
+        std::vector<Entity> changed;
+        coordinator->view<const Transform>().changedSince<Transform>(since).each([&changed](Entity entity, const Transform&) {
+            changed.push_back(entity);
+        });
+        return changed;
+    };
+
+    // With archetype storage changes are tracked per chunk, and these
+    // entities share one, so a single write reports all of them
+    const size_t sameChunk = mode == StorageMode::Sparse ? 1 : entities.size();
+
+    SECTION("Added components count as changed") {
+        REQUIRE(changedTransforms(0).size() == entities.size());
+
+        const ChangeTick since = coordinator->advanceChangeTick();
+        REQUIRE(changedTransforms(since).empty());
+
+        Entity late = coordinator->createEntity();
+        coordinator->addComponent(late, Transform{});
+        auto changed = changedTransforms(since);
+        REQUIRE(std::find(changed.begin(), changed.end(), late) != changed.end());
+    }
+
+    SECTION("Const access does not stamp, mutable access does") {
+        const ChangeTick since = coordinator->advanceChangeTick();
+
+        coordinator->view<const Transform>().each([](const Transform&) {});
+        for (Entity entity : entities) {
+            (void)std::as_const(*coordinator).getComponent<Transform>(entity);
+        }
+        REQUIRE(changedTransforms(since).empty());
+
+        coordinator->getComponent<Transform>(entities[3]).position[0] = 5.0f;
+        auto changed = changedTransforms(since);
+        REQUIRE(changed.size() == sameChunk);
+        REQUIRE(std::find(changed.begin(), changed.end(), entities[3]) != changed.end());
+    }
+
+    SECTION("Rendering reads components without stamping them") {
+        coordinator->registerComponent<Renderable2D>();
+        coordinator->addComponents(std::span<const Entity>(entities), Renderable2D{});
+
+        CountingRenderer2D renderer;
+        scene::Camera2D camera;
+        auto renderSystem = coordinator->registerSystem<Renderer2DSystem>(coordinator.get(), &renderer);
+        Signature signature;
+        signature.set(coordinator->getComponentType<Transform>());
+        signature.set(coordinator->getComponentType<Renderable2D>());
+        coordinator->setSystemSignature<Renderer2DSystem>(signature);
+        renderSystem->setActiveCamera(&camera);
+
+        const ChangeTick since = coordinator->advanceChangeTick();
+        renderSystem->update(0.016f);
+
+        REQUIRE(renderer.quads == entities.size());
+        REQUIRE(changedTransforms(since).empty());
+        size_t changedRenderables = 0;
+        coordinator->view<const Renderable2D>().changedSince<Renderable2D>(since).each([&](const Renderable2D&) {
+            ++changedRenderables;
+        });
+        REQUIRE(changedRenderables == 0);
+    }
+
+    SECTION("markChanged stamps without writing") {
+        const ChangeTick since = coordinator->advanceChangeTick();
+        coordinator->markChanged<Transform>(entities[7]);
+        auto changed = changedTransforms(since);
+        REQUIRE(changed.size() == sameChunk);
+        REQUIRE(std::find(changed.begin(), changed.end(), entities[7]) != changed.end());
+    }
+
+    SECTION("Mutable views stamp only their non-const components") {
+        coordinator->addComponents(std::span<const Entity>(entities).first(4), Velocity{});
+        const ChangeTick since = coordinator->advanceChangeTick();
+
+        coordinator->view<Transform, const Velocity>().each([](Transform&, const Velocity&) {});
+
+        // Movers sit in their own archetype, so the result is exact in both modes
+        REQUIRE(changedTransforms(since).size() == 4);
+        size_t changedVelocities = 0;
+        coordinator->view<const Velocity>().changedSince<Velocity>(since).each([&](const Velocity&) {
+            ++changedVelocities;
+        });
+        REQUIRE(changedVelocities == 0);
+
+        // The iterator interface stamps too
+        const ChangeTick next = coordinator->advanceChangeTick();
+        for (auto [entity, transform, velocity] : coordinator->view<Transform, const Velocity>()) {
+            transform.position[1] = velocity.linear[1];
+        }
+        REQUIRE(changedTransforms(next).size() == 4);
+    }
+
+    SECTION("Stamps survive swap-and-pop and archetype moves") {
+        const ChangeTick since = coordinator->advanceChangeTick();
+        coordinator->getComponent<Transform>(entities[9]).position[2] = 1.0f;
+
+        // Destroying the first entity moves the last one into its slot
+        coordinator->destroyEntity(entities[0]);
+        auto changed = changedTransforms(since);
+        REQUIRE(std::find(changed.begin(), changed.end(), entities[9]) != changed.end());
+
+        // Adding a component moves the entity to another archetype
+        coordinator->addComponent(entities[9], Health{});
+        const ChangeTick afterAdd = coordinator->advanceChangeTick();
+        changed = changedTransforms(since);
+        REQUIRE(std::find(changed.begin(), changed.end(), entities[9]) != changed.end());
+        REQUIRE(changedTransforms(afterAdd).empty());
+    }
+}
+
+namespace {
+
+    /// System that only collects entities, for signature tests
+    class MembershipSystem : public System {
+    public:
+        void update(float) override {}
+    };
+
+} // namespace
+
+TEST_CASE("ECS Tag Components", "[ECS][Tags]") {
+    STATIC_REQUIRE(isTagComponent<PlayerTag>);
+    STATIC_REQUIRE(isTagComponent<EnemyTag>);
+    STATIC_REQUIRE_FALSE(isTagComponent<Transform>);
+
+    auto mode = GENERATE(StorageMode::Sparse, StorageMode::Archetype);
+    auto coordinator = createCoordinator(mode);
+    coordinator->registerComponent<Transform>();
+    coordinator->registerComponent<PlayerTag>();
+    coordinator->registerComponent<EnemyTag>();
+    REQUIRE(coordinator->getRegisteredComponentCount() == 3);
+
+    auto players = coordinator->registerSystem<MembershipSystem>();
+    Signature playerSignature;
+    playerSignature.set(coordinator->getComponentType<Transform>());
+    playerSignature.set(coordinator->getComponentType<PlayerTag>());
+    coordinator->setSystemSignature<MembershipSystem>(playerSignature);
+
+    SECTION("Tags are signature bits") {
+        Entity entity = coordinator->createEntity();
+        coordinator->addComponent(entity, Transform{ math::Vec3f{1.0f, 2.0f, 3.0f} });
+        coordinator->addComponent(entity, PlayerTag{});
+
+        REQUIRE(coordinator->hasComponent<PlayerTag>(entity));
+        REQUIRE_FALSE(coordinator->hasComponent<EnemyTag>(entity));
+        REQUIRE(coordinator->getEntitySignature(entity).test(coordinator->getComponentType<PlayerTag>()));
+        REQUIRE(coordinator->getComponentCount<PlayerTag>() == 1);
+        REQUIRE(players->hasEntity(entity));
+
+        // Tags never touch component data
+        REQUIRE(coordinator->getComponent<Transform>(entity).position[1] == 2.0f);
+
+        coordinator->removeComponent<PlayerTag>(entity);
+        REQUIRE_FALSE(coordinator->hasComponent<PlayerTag>(entity));
+        REQUIRE_FALSE(players->hasEntity(entity));
+        REQUIRE(coordinator->getComponent<Transform>(entity).position[1] == 2.0f);
+    }
+
+    SECTION("Destroyed entities lose their tags") {
+        Entity entity = coordinator->createEntity();
+        coordinator->addComponent(entity, EnemyTag{});
+        coordinator->destroyEntity(entity);
+        REQUIRE_FALSE(coordinator->hasComponent<EnemyTag>(entity));
+        REQUIRE(coordinator->getComponentCount<EnemyTag>() == 0);
+
+        Entity reused = coordinator->createEntity();
+        REQUIRE_FALSE(coordinator->hasComponent<EnemyTag>(reused));
+    }
+
+    SECTION("Batches and command buffers accept tags") {
+        auto entities = coordinator->createEntities(100, Transform{}, PlayerTag{});
+        REQUIRE(coordinator->getComponentCount<PlayerTag>() == 100);
+        REQUIRE(coordinator->getComponentCount<Transform>() == 100);
+        REQUIRE(players->getEntityCount() == 100);
+
+        coordinator->addComponents(std::span<const Entity>(entities).first(10), EnemyTag{});
+        REQUIRE(coordinator->getComponentCount<EnemyTag>() == 10);
+
+        EntityCommandBuffer& commands = coordinator->getCommandBuffer();
+        commands.addComponent(entities[50], EnemyTag{});
+        commands.addComponent(entities[50], EnemyTag{});
+        commands.removeComponent<PlayerTag>(entities[51]);
+        commands.createEntity(EnemyTag{});
+        coordinator->playbackCommands();
+
+        REQUIRE(coordinator->hasComponent<EnemyTag>(entities[50]));
+        REQUIRE_FALSE(coordinator->hasComponent<PlayerTag>(entities[51]));
+        REQUIRE(coordinator->getComponentCount<EnemyTag>() == 12);
+        REQUIRE(players->getEntityCount() == 99);
+    }
+}
+
+TEST_CASE("ECS Hierarchy", "[ECS][Hierarchy]") {
+    auto mode = GENERATE(StorageMode::Sparse, StorageMode::Archetype);
+    auto coordinator = createCoordinator(mode);
+    coordinator->registerComponent<Transform>();
+    coordinator->registerComponent<Parent>();
+    coordinator->registerComponent<Children>();
+
+    auto hierarchy = coordinator->registerSystem<HierarchySystem>(coordinator.get());
+    Signature signature;
+    signature.set(coordinator->getComponentType<Transform>());
+    coordinator->setSystemSignature<HierarchySystem>(signature);
+
+    // root -> a -> b, root -> c
+    Entity root = coordinator->createEntity();
+    Entity a = coordinator->createEntity();
+    Entity b = coordinator->createEntity();
+    Entity c = coordinator->createEntity();
+    coordinator->addComponent(root, Transform{ math::Vec3f{10.0f, 0.0f, 0.0f} });
+    coordinator->addComponent(a, Transform{ math::Vec3f{0.0f, 1.0f, 0.0f} });
+    coordinator->addComponent(b, Transform{ math::Vec3f{0.0f, 0.0f, 2.0f} });
+    coordinator->addComponent(c, Transform{ math::Vec3f{3.0f, 0.0f, 0.0f}, math::Quatf{ 1.0f, 0.0f, 0.0f, 0.0f }, math::Vec3f{2.0f, 2.0f, 2.0f} });
+
+    // Added in an order that puts children before parents in the entity list
+    hierarchy->setParent(b, a);
+    hierarchy->setParent(a, root);
+    hierarchy->setParent(c, root);
+
+    auto translationOf = [&](Entity entity) {
+        const math::Matrix4f world = hierarchy->getWorldMatrix(entity);
+        return math::Vec3f{ world(0, 3), world(1, 3), world(2, 3) };
+    };
+
+    auto orderIndexOf = [&](Entity entity) {
+        auto order = hierarchy->getOrder();
+        return static_cast<size_t>(std::find(order.begin(), order.end(), entity) - order.begin());
+    };
+
+    auto childrenOf = [&](Entity parent) {
+        std::vector<Entity> children;
+        hierarchy->forEachChild(parent, [&children](Entity child) { children.push_back(child); });
+        return children;
+    };
+
+    SECTION("Parents come before their children") {
+        hierarchy->update(0.0f);
+
+        auto order = hierarchy->getOrder();
+        auto parents = hierarchy->getParentIndices();
+        REQUIRE(order.size() == 4);
+        REQUIRE(order.front() == root);
+        REQUIRE(parents.front() == HierarchySystem::NO_PARENT);
+        for (size_t i = 1; i < order.size(); ++i) {
+            REQUIRE(parents[i] < i);
+            REQUIRE(order[parents[i]] == hierarchy->getParent(order[i]));
+        }
+
+        // Depth first: a's subtree is contiguous
+        REQUIRE(orderIndexOf(b) == orderIndexOf(a) + 1);
+    }
+
+    SECTION("World matrices combine the chain of local transforms") {
+        hierarchy->update(0.0f);
+
+        REQUIRE(translationOf(root)[0] == Catch::Approx(10.0f));
+        REQUIRE(translationOf(b)[0] == Catch::Approx(10.0f));
+        REQUIRE(translationOf(b)[1] == Catch::Approx(1.0f));
+        REQUIRE(translationOf(b)[2] == Catch::Approx(2.0f));
+        REQUIRE(translationOf(c)[0] == Catch::Approx(13.0f));
+
+        const math::Matrix4f expected = coordinator->getComponent<Transform>(root).getMatrix() *
+            coordinator->getComponent<Transform>(a).getMatrix() *
+            coordinator->getComponent<Transform>(b).getMatrix();
+        const math::Matrix4f world = hierarchy->getWorldMatrix(b);
+        for (int row = 0; row < 4; ++row) {
+            for (int column = 0; column < 4; ++column) {
+                REQUIRE(world(row, column) == Catch::Approx(expected(row, column)));
+            }
+        }
+
+        // Moving the root moves the whole tree on the next update
+        coordinator->getComponent<Transform>(root).position[0] = 20.0f;
+        hierarchy->update(0.0f);
+        REQUIRE(translationOf(b)[0] == Catch::Approx(20.0f));
+    }
+
+    SECTION("Reparenting moves a subtree") {
+        hierarchy->setParent(a, c);
+        hierarchy->update(0.0f);
+
+        REQUIRE(hierarchy->getParent(a) == c);
+        REQUIRE(childrenOf(root) == std::vector<Entity>{ c });
+        REQUIRE(childrenOf(c) == std::vector<Entity>{ a });
+        REQUIRE(orderIndexOf(c) < orderIndexOf(a));
+        REQUIRE(orderIndexOf(a) < orderIndexOf(b));
+
+        // c scales its children by 2
+        REQUIRE(translationOf(b)[0] == Catch::Approx(13.0f));
+        REQUIRE(translationOf(b)[1] == Catch::Approx(2.0f));
+        REQUIRE(translationOf(b)[2] == Catch::Approx(4.0f));
+
+        hierarchy->removeParent(a);
+        hierarchy->update(0.0f);
+        REQUIRE(hierarchy->getParent(a) == NULL_ENTITY);
+        REQUIRE(translationOf(b)[0] == Catch::Approx(0.0f));
+        REQUIRE(translationOf(b)[1] == Catch::Approx(1.0f));
+    }
+
+    SECTION("Destroying a parent turns its children into roots") {
+        hierarchy->update(0.0f);
+        coordinator->destroyEntity(a);
+        hierarchy->update(0.0f);
+
+        REQUIRE(hierarchy->getOrder().size() == 3);
+        REQUIRE(hierarchy->getParent(b) == NULL_ENTITY);
+        REQUIRE(translationOf(b)[0] == Catch::Approx(0.0f));
+        REQUIRE(translationOf(b)[2] == Catch::Approx(2.0f));
+
+        // The destroyed child was unlinked from its siblings by the update
+        REQUIRE(childrenOf(root) == std::vector<Entity>{ c });
+        Entity d = coordinator->createEntity();
+        coordinator->addComponent(d, Transform{});
+        hierarchy->setParent(d, root);
+        REQUIRE(childrenOf(root) == std::vector<Entity>{ c, d });
+        REQUIRE(coordinator->getComponent<Children>(root).count == 2);
+    }
+
+    SECTION("Parents set through the command buffer are linked on the next update") {
+        hierarchy->update(0.0f);
+
+        Entity d = coordinator->createEntity();
+        Entity e = coordinator->createEntity();
+        coordinator->addComponent(d, Transform{ math::Vec3f{0.0f, 0.0f, 5.0f} });
+        coordinator->addComponent(e, Transform{ math::Vec3f{0.0f, 3.0f, 0.0f} });
+        coordinator->getCommandBuffer().addComponent(d, Parent{ b });
+        coordinator->getCommandBuffer().addComponent(e, Parent{ a });
+        coordinator->playbackCommands();
+        hierarchy->update(0.0f);
+        // b gains its Children component at the next sync point
+        coordinator->playbackCommands();
+        hierarchy->update(0.0f);
+
+        REQUIRE(childrenOf(root) == std::vector<Entity>{ a, c });
+        REQUIRE(childrenOf(a) == std::vector<Entity>{ b, e });
+        REQUIRE(childrenOf(b) == std::vector<Entity>{ d });
+        REQUIRE(orderIndexOf(b) < orderIndexOf(d));
+        REQUIRE(translationOf(d)[0] == Catch::Approx(10.0f));
+        REQUIRE(translationOf(d)[1] == Catch::Approx(1.0f));
+        REQUIRE(translationOf(d)[2] == Catch::Approx(7.0f));
+        REQUIRE(translationOf(e)[1] == Catch::Approx(4.0f));
+    }
+
+    SECTION("Only changed transforms are refreshed between rebuilds") {
+        hierarchy->update(0.0f);
+        coordinator->getComponent<Transform>(a).position[1] = 4.0f;
+        hierarchy->update(0.0f);
+        REQUIRE(translationOf(b)[1] == Catch::Approx(4.0f));
+
+        // Writes through a view are seen as well
+        for (auto [entity, transform] : coordinator->view<Transform>()) {
+            if (entity == root) {
+                transform.position[0] = -1.0f;
+            }
+        }
+        hierarchy->update(0.0f);
+        REQUIRE(translationOf(b)[0] == Catch::Approx(-1.0f));
+        REQUIRE(translationOf(c)[0] == Catch::Approx(2.0f));
+    }
+
+    SECTION("A hierarchy can be snapshotted") {
+        hierarchy->update(0.0f);
+        REQUIRE(coordinator->canSnapshot());
+
+        WorldSnapshot saved;
+        coordinator->snapshot(saved);
+        hierarchy->setParent(a, c);
+        hierarchy->removeParent(c);
+        coordinator->restore(saved);
+        hierarchy->update(0.0f);
+
+        REQUIRE(childrenOf(root) == std::vector<Entity>{ a, c });
+        REQUIRE(hierarchy->getParent(b) == a);
+        REQUIRE(translationOf(b)[0] == Catch::Approx(10.0f));
+    }
+}
+
+namespace {
+
+    /// Component with a non-trivial destructor, to exercise command payload lifetime
+    struct Label {
+        std::string text;
+    };
+
+} // namespace
+
+TEST_CASE("ECS Snapshot", "[ECS][Snapshot]") {
+    auto mode = GENERATE(StorageMode::Sparse, StorageMode::Archetype);
+    auto coordinator = createCoordinator(mode);
+    coordinator->registerComponent<Transform>();
+    coordinator->registerComponent<Velocity>();
+    coordinator->registerComponent<Health>();
+    coordinator->registerComponent<PlayerTag>();
+
+    auto physicsSystem = coordinator->registerSystem<PhysicsSystem>(coordinator.get());
+    Signature signature;
+    signature.set(coordinator->getComponentType<Transform>());
+    signature.set(coordinator->getComponentType<Velocity>());
+    coordinator->setSystemSignature<PhysicsSystem>(signature);
+
+    auto movers = coordinator->createEntities(300, Transform{}, Velocity{ math::Vec3f{1.0f, 0.0f, 0.0f} });
+    auto statics = coordinator->createEntities(200, Transform{ math::Vec3f{5.0f, 0.0f, 0.0f} }, Health{});
+    coordinator->addComponent(statics[0], PlayerTag{});
+
+    WorldSnapshot saved;
+    coordinator->snapshot(saved);
+    REQUIRE_FALSE(saved.isDelta());
+
+    SECTION("Restore undoes component writes and structural changes") {
+        Entity spawned = coordinator->createEntity();
+        coordinator->addComponent(spawned, Transform{});
+        coordinator->addComponent(spawned, Velocity{});
+        physicsSystem->update(1.0f);
+        coordinator->destroyEntity(movers[10]);
+        coordinator->removeComponent<Velocity>(movers[11]);
+        coordinator->removeComponent<PlayerTag>(statics[0]);
+        coordinator->getComponent<Health>(statics[1]).current = 1.0f;
+        REQUIRE(physicsSystem->getEntityCount() == 299);
+
+        coordinator->restore(saved);
+
+        REQUIRE(coordinator->getLivingEntityCount() == 500);
+        REQUIRE(coordinator->isAlive(movers[10]));
+        REQUIRE_FALSE(coordinator->isAlive(spawned));
+        REQUIRE(coordinator->hasComponent<Velocity>(movers[11]));
+        REQUIRE(coordinator->hasComponent<PlayerTag>(statics[0]));
+        REQUIRE(coordinator->getComponentCount<Transform>() == 500);
+        REQUIRE(coordinator->getComponentCount<Velocity>() == 300);
+        REQUIRE(std::as_const(*coordinator).getComponent<Health>(statics[1]).current == Catch::Approx(100.0f));
+        for (Entity entity : movers) {
+            REQUIRE(std::as_const(*coordinator).getComponent<Transform>(entity).position[0] == Catch::Approx(0.0f));
+        }
+        REQUIRE(physicsSystem->getEntityCount() == 300);
+
+        // Recreating entities hands out the handles the snapshot never saw again
+        REQUIRE(coordinator->createEntity() == spawned);
+    }
+
+    SECTION("A snapshot can be restored repeatedly") {
+        for (int round = 0; round < 3; ++round) {
+            physicsSystem->update(1.0f);
+            coordinator->restore(saved);
+            REQUIRE(std::as_const(*coordinator).getComponent<Transform>(movers[0]).position[0] == Catch::Approx(0.0f));
+        }
+    }
+
+    SECTION("Restored components count as changed") {
+        const ChangeTick since = coordinator->advanceChangeTick();
+        coordinator->restore(saved);
+
+        size_t changed = 0;
+        coordinator->view<const Transform>().changedSince<Transform>(since).each([&changed](const Transform&) {
+            ++changed;
+        });
+        REQUIRE(changed == 500);
+    }
+
+    SECTION("Delta snapshots store only changed blocks") {
+        // Only the movers change, and they were created first so they share blocks
+        physicsSystem->update(1.0f);
+
+        WorldSnapshot delta;
+        coordinator->snapshot(delta, saved);
+        REQUIRE(delta.isDelta());
+        REQUIRE(delta.getBlockCount() == saved.getBlockCount());
+        REQUIRE(delta.getStoredBlockCount() > 0);
+        REQUIRE(delta.getStoredBlockCount() < saved.getStoredBlockCount());
+        REQUIRE(delta.getStoredBytes() < saved.getStoredBytes());
+
+        // A second delta on top of the first
+        physicsSystem->update(1.0f);
+        WorldSnapshot secondDelta;
+        coordinator->snapshot(secondDelta, delta);
+
+        physicsSystem->update(1.0f);
+        coordinator->destroyEntity(statics[5]);
+
+        coordinator->restore(delta);
+        REQUIRE(std::as_const(*coordinator).getComponent<Transform>(movers[0]).position[0] == Catch::Approx(1.0f));
+        REQUIRE(coordinator->isAlive(statics[5]));
+
+        coordinator->restore(secondDelta);
+        REQUIRE(std::as_const(*coordinator).getComponent<Transform>(movers[299]).position[0] == Catch::Approx(2.0f));
+
+        coordinator->restore(saved);
+        REQUIRE(std::as_const(*coordinator).getComponent<Transform>(movers[0]).position[0] == Catch::Approx(0.0f));
+    }
+
+    SECTION("Retaking a snapshot reuses its arena") {
+        const size_t capacity = saved.getCapacity();
+        physicsSystem->update(1.0f);
+        coordinator->snapshot(saved);
+        REQUIRE(saved.getCapacity() == capacity);
+    }
+
+    SECTION("Components that are not trivially copyable are rejected") {
+        coordinator->registerComponent<Label>();
+        REQUIRE(coordinator->canSnapshot());
+
+        coordinator->addComponent(statics[2], Label{ "static" });
+        REQUIRE_FALSE(coordinator->canSnapshot());
+        REQUIRE_THROWS_AS(coordinator->snapshot(saved), std::runtime_error);
+
+        // Restoring a snapshot without them removes them
+        coordinator->restore(saved);
+        REQUIRE_FALSE(coordinator->hasComponent<Label>(statics[2]));
+        REQUIRE(coordinator->canSnapshot());
+
+        // Their emptied storage is saved without its contents
+        coordinator->snapshot(saved);
+        coordinator->addComponent(statics[3], Label{ "later" });
+        coordinator->restore(saved);
+        REQUIRE_FALSE(coordinator->hasComponent<Label>(statics[3]));
+        REQUIRE(coordinator->getLivingEntityCount() == 500);
+
+        // An archetype holding them cannot be copied even while it is empty
+        Signature signature;
+        signature.set(coordinator->getComponentType<Label>());
+        std::array<ComponentInfo, MAX_COMPONENTS> infos{};
+        infos[coordinator->getComponentType<Label>()] = ComponentInfo::create<Label>();
+        Archetype archetype(signature, infos);
+        REQUIRE_FALSE(archetype.canSnapshot());
+    }
+}
+
+TEST_CASE("ECS World File", "[ECS][WorldFile]") {
+    auto saveMode = GENERATE(StorageMode::Sparse, StorageMode::Archetype);
+    auto loadMode = GENERATE(StorageMode::Sparse, StorageMode::Archetype);
+    const std::string path = (std::filesystem::temp_directory_path() / "ecs_world_file_test.ecsw").string();
+
+    WorldSchema schema;
+    schema.add<Transform>("Transform")
+        .add<Velocity>("Velocity")
+        .add<Health>("Health")
+        .add<PlayerTag>("PlayerTag")
+        .add<Label>("Label",
+            [](const Label& label, EncodedWriter& writer) { writer.writeString(label.text); },
+            [](EncodedReader& reader) { return Label{ reader.readString() }; });
+
+    auto registerComponents = [](Coordinator& coordinator) {
+        coordinator.registerComponent<Transform>();
+        coordinator.registerComponent<Velocity>();
+        coordinator.registerComponent<Health>();
+        coordinator.registerComponent<PlayerTag>();
+        coordinator.registerComponent<Label>();
+    };
+
+    auto source = createCoordinator(saveMode);
+    registerComponents(*source);
+    auto movers = source->createEntities(300, Transform{}, Velocity{ math::Vec3f{1.0f, 0.0f, 0.0f} });
+    auto statics = source->createEntities(200, Transform{ math::Vec3f{5.0f, 0.0f, 0.0f} }, Health{ 50.0f });
+    source->addComponent(statics[0], PlayerTag{});
+    source->addComponent(statics[1], Label{ "door" });
+    source->getComponent<Transform>(movers[3]).position = math::Vec3f{ 3.0f, 4.0f, 5.0f };
+    source->destroyEntity(movers[7]);
+    source->saveWorld(path, schema);
+
+    auto loaded = createCoordinator(loadMode);
+    registerComponents(*loaded);
+    auto physicsSystem = loaded->registerSystem<PhysicsSystem>(loaded.get());
+    Signature signature;
+    signature.set(loaded->getComponentType<Transform>());
+    signature.set(loaded->getComponentType<Velocity>());
+    loaded->setSystemSignature<PhysicsSystem>(signature);
+
+    loaded->loadWorld(path, schema);
+
+    SECTION("Entities, handles and components match the saved world") {
+        REQUIRE(loaded->getLivingEntityCount() == 499);
+        REQUIRE(loaded->isAlive(movers[0]));
+        REQUIRE(loaded->isAlive(statics[199]));
+        REQUIRE_FALSE(loaded->isAlive(movers[7]));
+        REQUIRE(loaded->getComponentCount<Transform>() == 499);
+        REQUIRE(loaded->getComponentCount<Velocity>() == 299);
+        REQUIRE(loaded->getComponentCount<Health>() == 200);
+
+        const Coordinator& world = *loaded;
+        REQUIRE(world.getComponent<Transform>(movers[3]).position[1] == Catch::Approx(4.0f));
+        REQUIRE(world.getComponent<Transform>(statics[10]).position[0] == Catch::Approx(5.0f));
+        REQUIRE(world.getComponent<Velocity>(movers[299]).linear[0] == Catch::Approx(1.0f));
+        REQUIRE(world.getComponent<Health>(statics[4]).current == Catch::Approx(50.0f));
+        REQUIRE(loaded->hasComponent<PlayerTag>(statics[0]));
+        REQUIRE_FALSE(loaded->hasComponent<PlayerTag>(statics[1]));
+        REQUIRE(world.getComponent<Label>(statics[1]).text == "door");
+        REQUIRE_FALSE(loaded->hasComponent<Label>(statics[2]));
+        REQUIRE(physicsSystem->getEntityCount() == 299);
+
+        // The slot freed before saving is reissued with a newer generation
+        Entity reused = loaded->createEntity();
+        REQUIRE(entityIndex(reused) == entityIndex(movers[7]));
+        REQUIRE(reused != movers[7]);
+    }
+
+    SECTION("Loaded components can be written and changed structurally") {
+        physicsSystem->update(1.0f);
+        REQUIRE(std::as_const(*loaded).getComponent<Transform>(movers[0]).position[0] == Catch::Approx(1.0f));
+
+        loaded->destroyEntity(movers[0]);
+        loaded->removeComponent<Velocity>(movers[1]);
+        loaded->addComponent(statics[2], Velocity{});
+        loaded->createEntities(1000, Transform{}, Health{});
+        REQUIRE(loaded->getComponentCount<Transform>() == 1498);
+        REQUIRE(physicsSystem->getEntityCount() == 298);
+        REQUIRE(std::as_const(*loaded).getComponent<Transform>(movers[3]).position[2] == Catch::Approx(5.0f));
+
+        // Writes went to private pages, the file keeps the saved values
+        auto again = createCoordinator(loadMode);
+        registerComponents(*again);
+        again->loadWorld(path, schema);
+        REQUIRE(std::as_const(*again).getComponent<Transform>(movers[2]).position[0] == Catch::Approx(0.0f));
+        REQUIRE(again->hasComponent<Velocity>(movers[1]));
+    }
+
+    SECTION("Loaded components count as changed") {
+        size_t changed = 0;
+        loaded->view<const Transform>().changedSince<Transform>(0).each([&changed](const Transform&) {
+            ++changed;
+        });
+        REQUIRE(changed == 499);
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("ECS World File Errors", "[ECS][WorldFile]") {
+    const std::string path = (std::filesystem::temp_directory_path() / "ecs_world_file_errors.ecsw").string();
+
+    WorldSchema schema;
+    schema.add<Transform>("Transform");
+
+    auto coordinator = createCoordinator();
+    coordinator->registerComponent<Transform>();
+    coordinator->registerComponent<Health>();
+    coordinator->registerComponent<Label>();
+    auto entities = coordinator->createEntities(10, Transform{});
+
+    // Saves the world, corrupts the file and checks that loading fails before anything is created
+    auto requireRejected = [&](const WorldSchema& saveSchema, auto&& corrupt) {
+        coordinator->saveWorld(path, saveSchema);
+        std::vector<std::byte> bytes(std::filesystem::file_size(path));
+        std::ifstream(path, std::ios::binary).read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        WorldFileHeader header;
+        std::memcpy(&header, bytes.data(), sizeof(header));
+        corrupt(bytes, header);
+        std::memcpy(bytes.data(), &header, sizeof(header));
+        std::ofstream(path, std::ios::binary | std::ios::trunc).write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+
+        auto target = createCoordinator();
+        target->registerComponent<Transform>();
+        target->registerComponent<Health>();
+        target->registerComponent<Label>();
+        REQUIRE_THROWS_AS(target->loadWorld(path, saveSchema), std::runtime_error);
+        REQUIRE(target->getLivingEntityCount() == 0);
+    };
+    auto columnAt = [](std::vector<std::byte>& bytes, const WorldFileHeader& header, size_t index) {
+        return bytes.data() + header.columnsOffset + index * sizeof(WorldFileColumn);
+    };
+
+    SECTION("Components outside the schema cannot be saved") {
+        coordinator->addComponent(coordinator->createEntity(), Health{});
+        REQUIRE_THROWS_AS(coordinator->saveWorld(path, schema), std::runtime_error);
+    }
+
+    SECTION("Missing and malformed files are rejected") {
+        auto target = createCoordinator();
+        target->registerComponent<Transform>();
+        REQUIRE_THROWS_AS(target->loadWorld(path + ".missing", schema), std::runtime_error);
+
+        std::ofstream(path, std::ios::binary) << std::string(256, 'x');
+        REQUIRE_THROWS_AS(target->loadWorld(path, schema), std::runtime_error);
+        REQUIRE(target->getLivingEntityCount() == 0);
+    }
+
+    SECTION("Columns must be in the loading schema") {
+        coordinator->saveWorld(path, WorldSchema(schema).add<Health>("Health"));
+        auto target = createCoordinator();
+        target->registerComponent<Transform>();
+        REQUIRE_THROWS_AS(target->loadWorld(path, schema), std::runtime_error);
+        REQUIRE(target->getLivingEntityCount() == 0);
+    }
+
+    SECTION("The living count and free list must match the entity table") {
+        // Free list: 5 -> 3
+        coordinator->destroyEntity(entities[3]);
+        coordinator->destroyEntity(entities[5]);
+
+        requireRejected(schema, [](std::vector<std::byte>&, WorldFileHeader& header) { ++header.livingEntityCount; });
+        requireRejected(schema, [](std::vector<std::byte>&, WorldFileHeader& header) { header.freeHead = EntityManager::NULL_INDEX; });
+        requireRejected(schema, [&](std::vector<std::byte>&, WorldFileHeader& header) { header.freeHead = entityIndex(entities[0]); });
+        requireRejected(schema, [&](std::vector<std::byte>& bytes, WorldFileHeader& header) {
+            // Close the list into a cycle
+            auto* slots = reinterpret_cast<Entity*>(bytes.data() + header.slotsOffset);
+            slots[entityIndex(entities[3])] = makeEntity(entityIndex(entities[5]), entityGeneration(slots[entityIndex(entities[3])]));
+        });
+    }
+
+    SECTION("Columns and their owners must not repeat") {
+        coordinator->addComponent(entities[0], Health{});
+        const WorldSchema twoColumns = WorldSchema(schema).add<Health>("Health");
+
+        requireRejected(twoColumns, [&](std::vector<std::byte>& bytes, WorldFileHeader& header) {
+            std::memcpy(columnAt(bytes, header, 1), columnAt(bytes, header, 0), sizeof(WorldFileColumn));
+        });
+        requireRejected(twoColumns, [&](std::vector<std::byte>& bytes, WorldFileHeader& header) {
+            WorldFileColumn column;
+            std::memcpy(&column, columnAt(bytes, header, 0), sizeof(column));
+            auto* owners = reinterpret_cast<Entity*>(bytes.data() + column.entitiesOffset);
+            owners[1] = owners[0];
+        });
+    }
+
+    SECTION("Encoded value offsets are checked before the world is filled") {
+        coordinator->addComponent(entities[0], Label{ "crate" });
+        coordinator->addComponent(entities[1], Label{ "barrel" });
+        const WorldSchema encoded = WorldSchema(schema).add<Label>("Label",
+            [](const Label& label, EncodedWriter& writer) { writer.writeString(label.text); },
+            [](EncodedReader& reader) { return Label{ reader.readString() }; });
+
+        requireRejected(encoded, [&](std::vector<std::byte>& bytes, WorldFileHeader& header) {
+            for (size_t index = 0; index < header.columnCount; ++index) {
+                WorldFileColumn column;
+                std::memcpy(&column, columnAt(bytes, header, index), sizeof(column));
+                if (column.kind == WorldColumnKind::Encoded) {
+                    auto* offsets = reinterpret_cast<std::uint64_t*>(bytes.data() + column.valuesOffset);
+                    offsets[column.count] = bytes.size();
+                }
+            }
+        });
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("ECS Command Buffer", "[ECS][Commands]") {
+    auto mode = GENERATE(StorageMode::Sparse, StorageMode::Archetype);
+    auto coordinator = createCoordinator(mode);
+    coordinator->registerComponent<Transform>();
+    coordinator->registerComponent<Velocity>();
+    coordinator->registerComponent<Health>();
+    coordinator->registerComponent<Label>();
+
+    auto physicsSystem = coordinator->registerSystem<PhysicsSystem>(coordinator.get());
+    Signature physicsSignature;
+    physicsSignature.set(coordinator->getComponentType<Transform>());
+    physicsSignature.set(coordinator->getComponentType<Velocity>());
+    coordinator->setSystemSignature<PhysicsSystem>(physicsSignature);
+
+    EntityCommandBuffer& commands = coordinator->getCommandBuffer();
+    auto entities = coordinator->createEntities(8, Transform{});
+
+    SECTION("Nothing changes until playback") {
+        commands.destroyEntity(entities[0]);
+        commands.addComponent(entities[1], Velocity{});
+        commands.createEntity(Transform{}, Velocity{}, Label{ "spawned" });
+        REQUIRE(commands.getCommandCount() == 3);
+        REQUIRE(coordinator->getLivingEntityCount() == 8);
+        REQUIRE(physicsSystem->getEntityCount() == 0);
+
+        coordinator->playbackCommands();
+        REQUIRE(commands.isEmpty());
+        REQUIRE_FALSE(coordinator->isAlive(entities[0]));
+        REQUIRE(coordinator->hasComponent<Velocity>(entities[1]));
+        REQUIRE(coordinator->getLivingEntityCount() == 8);
+        REQUIRE(physicsSystem->getEntityCount() == 2);
+        REQUIRE(coordinator->getComponentCount<Label>() == 1);
+
+        for (auto [entity, label] : coordinator->view<Label>()) {
+            REQUIRE(label.text == "spawned");
+            REQUIRE(physicsSystem->hasEntity(entity));
+        }
+    }
+
+    SECTION("A destroy makes the entity's other commands moot") {
+        commands.addComponent(entities[2], Velocity{});
+        commands.destroyEntity(entities[2]);
+        commands.destroyEntity(entities[2]);
+        commands.addComponent(entities[2], Health{});
+        coordinator->playbackCommands();
+
+        REQUIRE_FALSE(coordinator->isAlive(entities[2]));
+        REQUIRE(coordinator->getComponentCount<Velocity>() == 0);
+        REQUIRE(coordinator->getComponentCount<Health>() == 0);
+        REQUIRE(coordinator->getLivingEntityCount() == 7);
+    }
+
+    SECTION("Commands on stale handles are dropped") {
+        coordinator->destroyEntity(entities[3]);
+        Entity reused = coordinator->createEntity();
+        REQUIRE(entityIndex(reused) == entityIndex(entities[3]));
+
+        commands.addComponent(entities[3], Health{});
+        commands.destroyEntity(entities[3]);
+        coordinator->playbackCommands();
+
+        REQUIRE(coordinator->isAlive(reused));
+        REQUIRE_FALSE(coordinator->hasComponent<Health>(reused));
+    }
+
+    SECTION("Adds overwrite and removes of missing components are ignored") {
+        commands.addComponent(entities[4], Health{ 10.0f });
+        commands.addComponent(entities[4], Health{ 20.0f });
+        commands.removeComponent<Velocity>(entities[4]);
+        commands.removeComponent<Transform>(entities[5]);
+        coordinator->playbackCommands();
+
+        REQUIRE(coordinator->getComponent<Health>(entities[4]).maximum == Catch::Approx(20.0f));
+        REQUIRE(coordinator->getComponentCount<Health>() == 1);
+        REQUIRE_FALSE(coordinator->hasComponent<Transform>(entities[5]));
+        REQUIRE(coordinator->hasComponent<Transform>(entities[4]));
+    }
+
+    SECTION("Unplayed payloads are released by clear") {
+        commands.addComponent(entities[0], Label{ std::string(100, 'x') });
+        commands.createEntity(Label{ std::string(100, 'y') });
+        commands.clear();
+        coordinator->playbackCommands();
+
+        REQUIRE(coordinator->getComponentCount<Label>() == 0);
+        REQUIRE(coordinator->getLivingEntityCount() == 8);
+    }
+
+    SECTION("Worker threads record concurrently") {
+        JobSystem jobs(3);
+        auto many = coordinator->createEntities(4000, Transform{});
+
+        jobs.parallelFor(many.size(), 64, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                if (i % 2 == 0) {
+                    commands.destroyEntity(many[i]);
+                } else {
+                    commands.addComponent(many[i], Velocity{ math::Vec3f{static_cast<float>(i), 0.0f, 0.0f} });
+                }
+                if (i % 100 == 0) {
+                    commands.createEntity(Transform{}, Label{ "wave" });
+                }
+            }
+        });
+        REQUIRE(commands.getCommandCount() == 4040);
+
+        coordinator->playbackCommands();
+        REQUIRE(coordinator->getLivingEntityCount() == 8 + 2000 + 40);
+        REQUIRE(physicsSystem->getEntityCount() == 2000);
+        REQUIRE(coordinator->getComponentCount<Label>() == 40);
+
+        size_t wrong = 0;
+        for (size_t i = 1; i < many.size(); i += 2) {
+            wrong += coordinator->getComponent<Velocity>(many[i]).linear[0] == static_cast<float>(i) ? 0 : 1;
+        }
+        REQUIRE(wrong == 0);
+    }
+
+    SECTION("Commands on one entity apply in system order, not recording order") {
+        // The later system records first, from another thread
+        std::thread laterSystem([&] {
+            EventSourceScope source(2);
+            commands.addComponent(entities[0], Health{ 2.0f });
+            commands.createEntity(Label{ "later" });
+        });
+        laterSystem.join();
+        {
+            EventSourceScope source(1);
+            commands.addComponent(entities[0], Health{ 1.0f });
+            commands.createEntity(Label{ "earlier" });
+        }
+        coordinator->playbackCommands();
+
+        REQUIRE(coordinator->getComponent<Health>(entities[0]).maximum == Catch::Approx(2.0f));
+        // Creations are ordered the same way, so the earlier system's entity is created first
+        Entity earlier = NULL_ENTITY;
+        Entity later = NULL_ENTITY;
+        for (auto [entity, label] : coordinator->view<Label>()) {
+            (label.text == "earlier" ? earlier : later) = entity;
+        }
+        REQUIRE(earlier != NULL_ENTITY);
+        REQUIRE(later != NULL_ENTITY);
+        REQUIRE(entityIndex(earlier) < entityIndex(later));
+    }
+
+    SECTION("A thread alternating between buffers keeps one stream in each") {
+        EntityCommandBuffer other;
+        auto frame = [&] {
+            for (int i = 0; i < 4; ++i) {
+                commands.addComponent(entities[0], Health{ static_cast<float>(i) });
+                other.addComponent(entities[1], Health{ static_cast<float>(i) });
+            }
+            commands.clear();
+            other.clear();
+        };
+        frame();
+
+        const uint64_t allocations = SystemProfiler::threadAllocationCount();
+        for (int i = 0; i < 100; ++i) {
+            frame();
+        }
+        if constexpr (ALLOCATION_COUNTING_ENABLED) {
+            REQUIRE(SystemProfiler::threadAllocationCount() == allocations);
+        }
+        REQUIRE(commands.isEmpty());
+    }
+
+    SECTION("Health system deaths are applied after all systems update") {
+        coordinator->registerSystem<HealthSystem>(coordinator.get());
+        Signature healthSignature;
+        healthSignature.set(coordinator->getComponentType<Health>());
+        coordinator->setSystemSignature<HealthSystem>(healthSignature);
+
+        coordinator->addComponent(entities[6], Health{ 0.0f });
+        coordinator->addComponent(entities[7], Health{ 5.0f });
+
+        JobSystem jobs(2);
+        coordinator->updateSystems(0.016f, jobs);
+
+        REQUIRE_FALSE(coordinator->isAlive(entities[6]));
+        REQUIRE(coordinator->isAlive(entities[7]));
+        REQUIRE(commands.isEmpty());
+    }
+}
+
+namespace {
+
+    /**
+     * @brief System that records when it ran, for scheduling tests
+     */
+    class RecordingSystem : public System {
+    private:
+        std::vector<int>& mLog;
+        std::mutex& mLogMutex;
+        int mId;
+
+    public:
+        RecordingSystem(std::vector<int>& log, std::mutex& logMutex, int id)
+            : mLog(log), mLogMutex(logMutex), mId(id) {}
+
+        template<typename... Ts>
+        void reads() { declareReads<Ts...>(); }
+
+        template<typename... Ts>
+        void writes() { declareWrites<Ts...>(); }
+
+        std::thread::id lastThread;
+
+        void update(float) override {
+            lastThread = std::this_thread::get_id();
+            std::lock_guard<std::mutex> lock(mLogMutex);
+            mLog.push_back(mId);
+        }
+    };
+
+    template<int Id>
+    class NumberedSystem : public RecordingSystem {
+    public:
+        using RecordingSystem::RecordingSystem;
+    };
+
+} // namespace
+
+TEST_CASE("ECS Job System", "[ECS][Jobs]") {
+    const size_t workerCount = GENERATE(0, 1, 4);
+    JobSystem jobs(workerCount);
+    REQUIRE(jobs.getConcurrency() == workerCount + 1);
+
+    SECTION("Every submitted job runs before wait returns") {
+        std::atomic<int> sum{ 0 };
+        JobSystem::WaitGroup group;
+        for (int i = 1; i <= 1000; ++i) {
+            jobs.submit(group, [&sum, i] { sum += i; });
+        }
+        jobs.wait(group);
+
+        REQUIRE(group.isDone());
+        REQUIRE(sum == 500500);
+    }
+
+    SECTION("Jobs can spawn jobs into the same group") {
+        std::atomic<int> count{ 0 };
+        JobSystem::WaitGroup group;
+        for (int i = 0; i < 10; ++i) {
+            jobs.submit(group, [&] {
+                for (int j = 0; j < 10; ++j) {
+                    jobs.submit(group, [&count] { ++count; });
+                }
+            });
+        }
+        jobs.wait(group);
+
+        REQUIRE(count == 100);
+    }
+}
+
+TEST_CASE("ECS Parallel Scheduling", "[ECS][Scheduler]") {
+    auto coordinator = createCoordinator();
+    coordinator->registerComponent<Transform>();
+    coordinator->registerComponent<Velocity>();
+    coordinator->registerComponent<Health>();
+
+    std::vector<int> log;
+    std::mutex logMutex;
+    JobSystem jobs(3);
+
+    SECTION("Conflicting systems keep registration order") {
+        auto first = coordinator->registerSystem<NumberedSystem<1>>(log, logMutex, 1);
+        auto second = coordinator->registerSystem<NumberedSystem<2>>(log, logMutex, 2);
+        auto third = coordinator->registerSystem<NumberedSystem<3>>(log, logMutex, 3);
+        first->writes<Transform>();
+        second->reads<Transform>();
+        second->writes<Velocity>();
+        third->writes<Transform, Velocity>();
+
+        for (int frame = 0; frame < 50; ++frame) {
+            log.clear();
+            coordinator->updateSystems(0.016f, jobs);
+            REQUIRE(log == std::vector<int>{ 1, 2, 3 });
+        }
+    }
+
+    SECTION("Readers and disjoint writers do not depend on each other") {
+        auto first = coordinator->registerSystem<NumberedSystem<1>>(log, logMutex, 1);
+        auto second = coordinator->registerSystem<NumberedSystem<2>>(log, logMutex, 2);
+        auto third = coordinator->registerSystem<NumberedSystem<3>>(log, logMutex, 3);
+        first->reads<Transform>();
+        second->reads<Transform>();
+        third->writes<Health>();
+
+        REQUIRE_FALSE(first->conflictsWith(*second));
+        REQUIRE_FALSE(first->conflictsWith(*third));
+
+        coordinator->updateSystems(0.016f, jobs);
+        std::sort(log.begin(), log.end());
+        REQUIRE(log == std::vector<int>{ 1, 2, 3 });
+    }
+
+    SECTION("Undeclared systems run alone on the calling thread") {
+        auto before = coordinator->registerSystem<NumberedSystem<1>>(log, logMutex, 1);
+        auto barrier = coordinator->registerSystem<NumberedSystem<2>>(log, logMutex, 2);
+        auto after = coordinator->registerSystem<NumberedSystem<3>>(log, logMutex, 3);
+        before->reads<Transform>();
+        after->reads<Transform>();
+
+        REQUIRE(barrier->isExclusive());
+        REQUIRE(barrier->conflictsWith(*before));
+
+        for (int frame = 0; frame < 50; ++frame) {
+            log.clear();
+            coordinator->updateSystems(0.016f, jobs);
+            REQUIRE(log == std::vector<int>{ 1, 2, 3 });
+            REQUIRE(barrier->lastThread == std::this_thread::get_id());
+        }
+    }
+
+    SECTION("Parallel physics matches the sequential result") {
+        auto physicsSystem = coordinator->registerSystem<PhysicsSystem>(coordinator.get());
+        Signature physicsSignature;
+        physicsSignature.set(coordinator->getComponentType<Transform>());
+        physicsSignature.set(coordinator->getComponentType<Velocity>());
+        coordinator->setSystemSignature<PhysicsSystem>(physicsSignature);
+
+        Entity entity = coordinator->createEntity();
+        coordinator->addComponent(entity, Transform{});
+        coordinator->addComponent(entity, Velocity{ math::Vec3f{2.0f, 0.0f, 0.0f} });
+
+        coordinator->updateSystems(0.5f, jobs);
+        REQUIRE(coordinator->getComponent<Transform>(entity).position[0] == Catch::Approx(1.0f));
+    }
+}
+
+namespace {
+
+    /// Makes exactly one heap allocation per update
+    class AllocatingSystem : public System {
+    public:
+        std::unique_ptr<int> held;
+
+        AllocatingSystem() {
+            declareReads<Transform>();
+        }
+
+        void update(float) override {
+            held = std::make_unique<int>(static_cast<int>(getEntityCount()));
+        }
+    };
+
+} // namespace
+
+TEST_CASE("ECS System Profiler", "[ECS][Profiler]") {
+    auto coordinator = createCoordinator();
+    coordinator->registerComponent<Transform>();
+    coordinator->registerComponent<Velocity>();
+
+    std::vector<int> log;
+    std::mutex logMutex;
+    auto numbered = coordinator->registerSystem<NumberedSystem<1>>(log, logMutex, 1);
+    numbered->reads<Transform>();
+    coordinator->registerSystem<AllocatingSystem>();
+
+    Signature signature;
+    signature.set(coordinator->getComponentType<Transform>());
+    coordinator->setSystemSignature<NumberedSystem<1>>(signature);
+    coordinator->setSystemSignature<AllocatingSystem>(signature);
+
+    for (int i = 0; i < 5; ++i) {
+        Entity entity = coordinator->createEntity();
+        coordinator->addComponent(entity, Transform{});
+    }
+
+    SECTION("Nothing is recorded before the first update") {
+        auto stats = coordinator->getSystemProfiler().getStats();
+        REQUIRE(stats.size() == 2);
+        REQUIRE(stats[0].sampleCount == 0);
+        REQUIRE(stats[1].name.find("AllocatingSystem") != std::string::npos);
+    }
+
+    if constexpr (SYSTEM_PROFILING_ENABLED) {
+        SECTION("Updates are timed with their entity and allocation counts") {
+            JobSystem jobs(2);
+            for (int frame = 0; frame < 10; ++frame) {
+                if (frame % 2 == 0) {
+                    coordinator->updateSystems(0.016f);
+                } else {
+                    coordinator->updateSystems(0.016f, jobs);
+                }
+            }
+
+            auto stats = coordinator->getSystemProfiler().getStats();
+            REQUIRE(stats.size() == 2);
+            for (const auto& system : stats) {
+                REQUIRE(system.sampleCount == 10);
+                REQUIRE(system.entityCount == 5);
+                REQUIRE(system.minMs >= 0.0);
+                REQUIRE(system.minMs <= system.avgMs);
+                REQUIRE(system.avgMs <= system.p99Ms);
+            }
+            if constexpr (ALLOCATION_COUNTING_ENABLED) {
+                REQUIRE(stats[1].lastAllocations == 1);
+                REQUIRE(stats[1].totalAllocations == 10);
+            }
+        }
+
+        SECTION("The history keeps the most recent updates") {
+            for (size_t frame = 0; frame < SystemProfiler::HISTORY_SIZE + 20; ++frame) {
+                coordinator->updateSystems(0.016f);
+            }
+            auto stats = coordinator->getSystemProfiler().getStats();
+            REQUIRE(stats[0].sampleCount == SystemProfiler::HISTORY_SIZE);
+            if constexpr (ALLOCATION_COUNTING_ENABLED) {
+                REQUIRE(stats[1].totalAllocations == SystemProfiler::HISTORY_SIZE + 20);
+            }
+
+            coordinator->getSystemProfiler().reset();
+            REQUIRE(coordinator->getSystemProfiler().getStats()[0].sampleCount == 0);
+        }
+
+        SECTION("Updates export as Chrome trace events") {
+            coordinator->updateSystems(0.016f);
+            coordinator->updateSystems(0.016f);
+
+            std::ostringstream trace;
+            coordinator->getSystemProfiler().writeChromeTrace(trace);
+            const std::string json = trace.str();
+
+            REQUIRE(json.rfind("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 0) == 0);
+            size_t events = 0;
+            for (size_t at = json.find("\"ph\":\"X\""); at != std::string::npos; at = json.find("\"ph\":\"X\"", at + 1)) {
+                ++events;
+            }
+            REQUIRE(events == 4);
+            REQUIRE(json.find("AllocatingSystem") != std::string::npos);
+            REQUIRE((json.find("\"allocations\":1") != std::string::npos) == ALLOCATION_COUNTING_ENABLED);
+            REQUIRE(json.find("\"thread_name\"") != std::string::npos);
+        }
+
+        SECTION("Updates share the trace clock and thread tracks with core::Trace") {
+            const int64_t before = core::chrome::now();
+            coordinator->updateSystems(0.016f);
+            const int64_t after = core::chrome::now();
+
+            std::ostringstream trace;
+            core::chrome::TraceEventWriter writer(trace);
+            writer.threadName(core::chrome::threadId(), "Main");
+            coordinator->getSystemProfiler().writeTraceEvents(writer);
+            writer.finish();
+            const std::string json = trace.str();
+
+            const std::string tid = "\"tid\":" + std::to_string(core::chrome::threadId()) + ",";
+            size_t events = 0;
+            for (size_t at = json.find("\"ph\":\"X\""); at != std::string::npos; at = json.find("\"ph\":\"X\"", at + 1)) {
+                ++events;
+                REQUIRE(json.compare(json.find("\"tid\":", at), tid.size(), tid) == 0);
+                const double ts = std::stod(json.substr(json.find("\"ts\":", at) + 5));
+                REQUIRE(ts >= static_cast<double>(before / 1000));
+                REQUIRE(ts <= static_cast<double>(after) / 1000.0);
+            }
+            REQUIRE(events == 2);
+            REQUIRE(json.find("\"thread_name\"") == json.rfind("\"thread_name\""));
+        }
+    }
+}
+
+TEST_CASE("ECS Parallel Iteration", "[ECS][Jobs]") {
+    auto mode = GENERATE(StorageMode::Sparse, StorageMode::Archetype);
+    auto coordinator = createCoordinator(mode);
+    coordinator->registerComponent<Transform>();
+    coordinator->registerComponent<Velocity>();
+
+    constexpr size_t entityCount = 10000;
+    for (size_t i = 0; i < entityCount; ++i) {
+        Entity entity = coordinator->createEntity();
+        coordinator->addComponent(entity, Transform{});
+        if (i % 3 != 0) {
+            coordinator->addComponent(entity, Velocity{ math::Vec3f{static_cast<float>(i), 0.0f, 0.0f} });
+        }
+    }
+
+    JobSystem jobs(3);
+
+    SECTION("Every matching entity is written exactly once") {
+        const size_t grainSize = GENERATE(1, 100, 1024, 100000);
+
+        coordinator->view<Transform, Velocity>().parallelForEach(jobs, [](Transform& transform, const Velocity& velocity) {
+            transform.position = transform.position + velocity.linear;
+        }, grainSize);
+
+        size_t moved = 0;
+        size_t wrong = 0;
+        coordinator->view<Transform, Velocity>().each([&](const Transform& transform, const Velocity& velocity) {
+            wrong += transform.position[0] == velocity.linear[0] ? 0 : 1;
+            ++moved;
+        });
+        REQUIRE(wrong == 0);
+        REQUIRE(moved == entityCount - (entityCount + 2) / 3);
+    }
+
+    SECTION("Physics system uses the coordinator's job pool") {
+        auto physicsSystem = coordinator->registerSystem<PhysicsSystem>(coordinator.get());
+        coordinator->setJobSystem(&jobs);
+
+        physicsSystem->update(0.5f);
+
+        size_t wrong = 0;
+        coordinator->view<Transform, Velocity>().each([&wrong](const Transform& transform, const Velocity& velocity) {
+            wrong += transform.position[0] == Catch::Approx(velocity.linear[0] * 0.5f) ? 0 : 1;
+        });
+        REQUIRE(wrong == 0);
+    }
+
+    SECTION("Grains are rounded to whole cache lines") {
+        const size_t lineElements = CACHE_LINE_SIZE / std::gcd(CACHE_LINE_SIZE, sizeof(Transform));
+        REQUIRE(View<Transform>::alignGrain(1, lineElements) * sizeof(Transform) % CACHE_LINE_SIZE == 0);
+        REQUIRE(View<Transform>::alignGrain(100, 16) == 112);
+        REQUIRE(View<Transform>::alignGrain(0, 16) == 16);
+    }
+}
+
+namespace {
+
+    struct TestMoveEvent {
+        float x = 0.0f;
+        float y = 0.0f;
+
+        TestMoveEvent(float x, float y) : x(x), y(y) {}
+    };
+
+    /// Counts copies, to check events are constructed in place
+    struct TestNamedEvent {
+        static inline int copies = 0;
+        std::string name;
+
+        explicit TestNamedEvent(std::string name) : name(std::move(name)) {}
+        TestNamedEvent(const TestNamedEvent& other) : name(other.name) { ++copies; }
+        TestNamedEvent(TestNamedEvent&&) = default;
+        TestNamedEvent& operator=(const TestNamedEvent&) = default;
+        TestNamedEvent& operator=(TestNamedEvent&&) = default;
+    };
+}
+
+TEST_CASE("ECS Event Bus", "[ECS][Events]") {
+    EventBus bus;
+
+    SECTION("Event types get distinct, stable IDs") {
+        REQUIRE(eventTypeId<TestMoveEvent>() == eventTypeId<TestMoveEvent>());
+        REQUIRE(eventTypeId<TestMoveEvent>() != eventTypeId<TestNamedEvent>());
+    }
+
+    SECTION("Events become readable in the next frame, in emission order, without copies") {
+        TestNamedEvent::copies = 0;
+        bus.emit<TestNamedEvent>("first");
+        bus.emit<TestNamedEvent>("second");
+        bus.emit<TestMoveEvent>(1.0f, 2.0f);
+        REQUIRE(bus.read<TestNamedEvent>().empty());
+        REQUIRE(bus.getTotalEventCount() == 0);
+
+        bus.update();
+        std::span<const TestNamedEvent> named = bus.read<TestNamedEvent>();
+        REQUIRE(named.size() == 2);
+        REQUIRE(named[0].name == "first");
+        REQUIRE(named[1].name == "second");
+        REQUIRE(bus.read<TestMoveEvent>()[0].y == 2.0f);
+        REQUIRE(TestNamedEvent::copies == 0);
+
+        REQUIRE(bus.getEventCount<TestNamedEvent>() == 2);
+        REQUIRE(bus.getTotalEventCount() == 3);
+    }
+
+    SECTION("Every reader sees a frame's events until the frame after it ends") {
+        bus.emit<TestMoveEvent>(1.0f, 0.0f);
+        bus.update();
+
+        // Emitting during frame N + 1 does not disturb what is read in it
+        bus.emit<TestMoveEvent>(2.0f, 0.0f);
+        for (int reader = 0; reader < 3; ++reader) {
+            std::span<const TestMoveEvent> events = bus.read<TestMoveEvent>();
+            REQUIRE(events.size() == 1);
+            REQUIRE(events[0].x == 1.0f);
+        }
+
+        bus.update();
+        REQUIRE(bus.read<TestMoveEvent>().size() == 1);
+        REQUIRE(bus.read<TestMoveEvent>()[0].x == 2.0f);
+
+        bus.update();
+        REQUIRE(bus.read<TestMoveEvent>().empty());
+    }
+
+    SECTION("Unknown event types read as empty") {
+        REQUIRE(bus.read<TestMoveEvent>().empty());
+        REQUIRE(bus.getEventCount<TestMoveEvent>() == 0);
+        bus.update();
+        REQUIRE(bus.read<TestMoveEvent>().empty());
+    }
+
+    SECTION("Buffers keep their storage across frames") {
+        auto emitFrame = [&bus] {
+            for (int i = 0; i < 100; ++i) {
+                bus.emit<TestMoveEvent>(static_cast<float>(i), 0.0f);
+            }
+            bus.update();
+        };
+        emitFrame();
+        const TestMoveEvent* storage = bus.read<TestMoveEvent>().data();
+
+        for (int frame = 0; frame < 3; ++frame) {
+            const uint64_t allocations = SystemProfiler::threadAllocationCount();
+            emitFrame();
+            if constexpr (ALLOCATION_COUNTING_ENABLED) {
+                REQUIRE(SystemProfiler::threadAllocationCount() == allocations);
+            }
+            REQUIRE(bus.read<TestMoveEvent>().data() == storage);
+            REQUIRE(bus.getEventCount<TestMoveEvent>() == 100);
+        }
+    }
+
+    SECTION("Clearing all drops readable and pending events") {
+        bus.emit<TestMoveEvent>(1.0f, 1.0f);
+        bus.update();
+        bus.emit<TestNamedEvent>("pending");
+
+        bus.clearAll();
+        REQUIRE(bus.read<TestMoveEvent>().empty());
+        bus.update();
+        REQUIRE(bus.read<TestNamedEvent>().empty());
+        REQUIRE(bus.getTotalEventCount() == 0);
+    }
+
+    SECTION("The logging hook sees each event once, by type ID, when it becomes readable") {
+        std::vector<EventType> types;
+        float loggedX = 0.0f;
+        bus.setLoggingHook([&](EventType type, const void* event, size_t size) {
+            types.push_back(type);
+            if (type == eventTypeId<TestMoveEvent>()) {
+                REQUIRE(size == sizeof(TestMoveEvent));
+                loggedX = static_cast<const TestMoveEvent*>(event)->x;
+            }
+        });
+
+        bus.emit<TestMoveEvent>(3.0f, 4.0f);
+        bus.emit<TestMoveEvent>(5.0f, 6.0f);
+        REQUIRE(types.empty());
+
+        bus.update();
+        REQUIRE(types == std::vector<EventType>{ eventTypeId<TestMoveEvent>(), eventTypeId<TestMoveEvent>() });
+        REQUIRE(loggedX == 5.0f);
+
+        bus.update();
+        REQUIRE(types.size() == 2);
+    }
+
+    SECTION("Events of different threads merge in emitting-system order") {
+        // Sources are emitted in reverse of their thread start, so thread order alone would be wrong
+        constexpr int threadCount = 8;
+        constexpr int eventsPerThread = 1000;
+        std::vector<std::thread> threads;
+        std::atomic<int> ready{ 0 };
+        for (int t = 0; t < threadCount; ++t) {
+            threads.emplace_back([&bus, &ready, t] {
+                ++ready;
+                while (ready.load() < threadCount) {
+                }
+                EventSourceScope source(static_cast<uint32_t>(threadCount - t));
+                for (int i = 0; i < eventsPerThread; ++i) {
+                    bus.emit<TestMoveEvent>(static_cast<float>(threadCount - t), static_cast<float>(i));
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        bus.emit<TestMoveEvent>(0.0f, 0.0f);
+        bus.update();
+
+        std::span<const TestMoveEvent> events = bus.read<TestMoveEvent>();
+        REQUIRE(events.size() == threadCount * eventsPerThread + 1);
+        size_t outOfOrder = 0;
+        for (size_t i = 1; i < events.size(); ++i) {
+            const TestMoveEvent& previous = events[i - 1];
+            const TestMoveEvent& current = events[i];
+            const bool ordered = previous.x < current.x || (previous.x == current.x && previous.y + 1.0f == current.y);
+            outOfOrder += ordered ? 0 : 1;
+        }
+        REQUIRE(outOfOrder == 0);
+        REQUIRE(events.front().x == 0.0f);
+    }
+
+    SECTION("Threads beyond the lane count share the overflow lane") {
+        // Every thread stays alive until all have emitted, so none can reuse another's lane
+        constexpr int threadCount = static_cast<int>(MAX_EVENT_THREADS) + 36;
+        constexpr int eventsPerThread = 100;
+        std::atomic<int> handled{ 0 };
+        auto subscription = bus.subscribe<TestMoveEvent>([](void* counter, const TestMoveEvent&) {
+            ++*static_cast<std::atomic<int>*>(counter);
+        }, &handled);
+
+        std::vector<std::thread> threads;
+        std::atomic<int> emitted{ 0 };
+        for (int t = 0; t < threadCount; ++t) {
+            threads.emplace_back([&bus, &emitted, t] {
+                EventSourceScope source(static_cast<uint32_t>(t + 1));
+                for (int i = 0; i < eventsPerThread; ++i) {
+                    bus.emit<TestMoveEvent>(static_cast<float>(t), static_cast<float>(i));
+                }
+                ++emitted;
+                while (emitted.load() < threadCount) {
+                    std::this_thread::yield();
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        bus.unsubscribe(subscription);
+        bus.update();
+
+        std::span<const TestMoveEvent> events = bus.read<TestMoveEvent>();
+        REQUIRE(events.size() == threadCount * eventsPerThread);
+        REQUIRE(handled.load() == threadCount * eventsPerThread);
+        size_t outOfOrder = 0;
+        for (size_t i = 0; i < events.size(); ++i) {
+            outOfOrder += events[i].x == static_cast<float>(i / eventsPerThread) && events[i].y == static_cast<float>(i % eventsPerThread) ? 0 : 1;
+        }
+        REQUIRE(outOfOrder == 0);
+    }
+
+    SECTION("Events of a system's parallel jobs merge by job, between its own events") {
+        JobSystem jobs(4);
+        for (int attempt = 0; attempt < 10; ++attempt) {
+            std::thread earlierSystem([&bus] {
+                EventSourceScope source(1);
+                bus.emit<TestMoveEvent>(-1.0f, 0.0f);
+            });
+            {
+                EventSourceScope source(2);
+                bus.emit<TestMoveEvent>(0.0f, 0.0f);
+                jobs.parallelFor(100, 10, [&bus](size_t begin, size_t end) {
+                    for (size_t i = begin; i < end; ++i) {
+                        bus.emit<TestMoveEvent>(1.0f, static_cast<float>(i));
+                    }
+                });
+                bus.emit<TestMoveEvent>(2.0f, 0.0f);
+            }
+            earlierSystem.join();
+            bus.update();
+
+            std::span<const TestMoveEvent> events = bus.read<TestMoveEvent>();
+            REQUIRE(events.size() == 103);
+            REQUIRE(events[0].x == -1.0f);
+            REQUIRE(events[1].x == 0.0f);
+            size_t outOfOrder = 0;
+            for (size_t i = 0; i < 100; ++i) {
+                outOfOrder += events[i + 2].y == static_cast<float>(i) ? 0 : 1;
+            }
+            REQUIRE(outOfOrder == 0);
+            REQUIRE(events[102].x == 2.0f);
+        }
+    }
+
+    SECTION("Systems tag their events, so a frame reads them in system order") {
+        bus.emit<TestMoveEvent>(-1.0f, 0.0f);
+        {
+            EventSourceScope later(2);
+            bus.emit<TestMoveEvent>(2.0f, 0.0f);
+            {
+                EventSourceScope earlier(1);
+                bus.emit<TestMoveEvent>(1.0f, 0.0f);
+            }
+            bus.emit<TestMoveEvent>(2.0f, 1.0f);
+        }
+        bus.update();
+
+        std::span<const TestMoveEvent> events = bus.read<TestMoveEvent>();
+        REQUIRE(events.size() == 4);
+        REQUIRE(events[0].x == -1.0f);
+        REQUIRE(events[1].x == 1.0f);
+        REQUIRE(events[2].x == 2.0f);
+        REQUIRE(events[2].y == 0.0f);
+        REQUIRE(events[3].y == 1.0f);
+    }
+}
+
+namespace {
+
+    struct TestEventListener {
+        std::vector<float> seen;
+
+        void onMove(const TestMoveEvent& event) { seen.push_back(event.x); }
+    };
+
+    /// Handler context for tests that unsubscribe or subscribe from inside handlers
+    struct TestHandlerState {
+        EventBus* bus = nullptr;
+        std::vector<int> calls;
+        EventSubscription self;
+        EventSubscription other;
+    };
+}
+
+TEST_CASE("ECS Event Handlers", "[ECS][Events]") {
+    EventBus bus;
+
+    SECTION("Handlers run inside emit, in subscription order, and the event is still queued") {
+        TestEventListener first;
+        TestEventListener second;
+        bus.subscribe<TestMoveEvent, &TestEventListener::onMove>(first);
+        bus.subscribe<TestMoveEvent, &TestEventListener::onMove>(second);
+        REQUIRE(bus.getSubscriberCount<TestMoveEvent>() == 2);
+
+        std::vector<int> order;
+        bus.subscribe<TestMoveEvent>([](void* context, const TestMoveEvent&) {
+            static_cast<std::vector<int>*>(context)->push_back(3);
+        }, &order);
+
+        bus.emit<TestMoveEvent>(1.0f, 0.0f);
+        REQUIRE(first.seen == std::vector<float>{ 1.0f });
+        REQUIRE(second.seen == std::vector<float>{ 1.0f });
+        REQUIRE(order.size() == 1);
+
+        bus.update();
+        REQUIRE(bus.read<TestMoveEvent>().size() == 1);
+        REQUIRE(first.seen.size() == 1);
+    }
+
+    SECTION("Unsubscribed handlers are not called again") {
+        TestEventListener listener;
+        EventSubscription subscription = bus.subscribe<TestMoveEvent, &TestEventListener::onMove>(listener);
+        bus.emit<TestMoveEvent>(1.0f, 0.0f);
+
+        REQUIRE(bus.unsubscribe(subscription));
+        REQUIRE_FALSE(bus.unsubscribe(subscription));
+        REQUIRE_FALSE(bus.unsubscribe(EventSubscription{}));
+        bus.emit<TestMoveEvent>(2.0f, 0.0f);
+        REQUIRE(listener.seen == std::vector<float>{ 1.0f });
+        REQUIRE(bus.getSubscriberCount<TestMoveEvent>() == 0);
+    }
+
+    SECTION("A handler can unsubscribe itself and others during a dispatch") {
+        TestHandlerState state;
+        state.bus = &bus;
+        state.self = bus.subscribe<TestMoveEvent>([](void* context, const TestMoveEvent&) {
+            auto& handlerState = *static_cast<TestHandlerState*>(context);
+            handlerState.calls.push_back(1);
+            handlerState.bus->unsubscribe(handlerState.self);
+            handlerState.bus->unsubscribe(handlerState.other);
+        }, &state);
+        state.other = bus.subscribe<TestMoveEvent>([](void* context, const TestMoveEvent&) {
+            static_cast<TestHandlerState*>(context)->calls.push_back(2);
+        }, &state);
+        TestEventListener last;
+        bus.subscribe<TestMoveEvent, &TestEventListener::onMove>(last);
+
+        // The second handler is unsubscribed before its turn, so it misses even the current event
+        bus.emit<TestMoveEvent>(1.0f, 0.0f);
+        bus.emit<TestMoveEvent>(2.0f, 0.0f);
+        REQUIRE(state.calls == std::vector<int>{ 1 });
+        REQUIRE(last.seen == std::vector<float>{ 1.0f, 2.0f });
+        REQUIRE(bus.getSubscriberCount<TestMoveEvent>() == 1);
+
+        bus.update();
+        bus.emit<TestMoveEvent>(3.0f, 0.0f);
+        REQUIRE(last.seen.size() == 3);
+    }
+
+    SECTION("A handler subscribed during a dispatch first sees the next event") {
+        TestHandlerState state;
+        state.bus = &bus;
+        state.self = bus.subscribe<TestMoveEvent>([](void* context, const TestMoveEvent&) {
+            auto& handlerState = *static_cast<TestHandlerState*>(context);
+            handlerState.calls.push_back(1);
+            if (!handlerState.other) {
+                handlerState.other = handlerState.bus->subscribe<TestMoveEvent>([](void* inner, const TestMoveEvent&) {
+                    static_cast<TestHandlerState*>(inner)->calls.push_back(2);
+                }, context);
+            }
+        }, &state);
+
+        bus.emit<TestMoveEvent>(1.0f, 0.0f);
+        REQUIRE(state.calls == std::vector<int>{ 1 });
+        bus.emit<TestMoveEvent>(2.0f, 0.0f);
+        REQUIRE(state.calls == std::vector<int>{ 1, 1, 2 });
+    }
+
+    SECTION("Handlers may emit the event type they handle") {
+        TestNamedEvent::copies = 0;
+        std::vector<std::string> seen;
+        struct Context {
+            EventBus* bus;
+            std::vector<std::string>* seen;
+        } context{ &bus, &seen };
+        bus.subscribe<TestNamedEvent>([](void* raw, const TestNamedEvent& event) {
+            // Emitting may move the lane's events, so the handler is done with event before it emits
+            auto& handlerContext = *static_cast<Context*>(raw);
+            const std::string name = event.name;
+            if (name.size() < 4) {
+                handlerContext.bus->emit<TestNamedEvent>(name + "+");
+            }
+            handlerContext.seen->push_back(name);
+        }, &context);
+
+        bus.emit<TestNamedEvent>("a");
+        REQUIRE(seen == std::vector<std::string>{ "a+++", "a++", "a+", "a" });
+        bus.update();
+        REQUIRE(bus.read<TestNamedEvent>().size() == 4);
+        REQUIRE(TestNamedEvent::copies == 0);
+    }
+
+    SECTION("Dispatching does not allocate") {
+        TestEventListener listener;
+        listener.seen.reserve(200);
+        bus.subscribe<TestMoveEvent, &TestEventListener::onMove>(listener);
+        auto emitFrame = [&bus] {
+            for (int i = 0; i < 100; ++i) {
+                bus.emit<TestMoveEvent>(static_cast<float>(i), 0.0f);
+            }
+            bus.update();
+        };
+        emitFrame();
+
+        const uint64_t allocations = SystemProfiler::threadAllocationCount();
+        emitFrame();
+        if constexpr (ALLOCATION_COUNTING_ENABLED) {
+            REQUIRE(SystemProfiler::threadAllocationCount() == allocations);
+        }
+        REQUIRE(listener.seen.size() == 200);
+    }
+}
+
+TEST_CASE("ECS Event Log", "[ECS][Events]") {
+    const std::string path = (std::filesystem::temp_directory_path() / "ecs_event_log_test.ecse").string();
+    EventBus bus;
+
+    SECTION("A recording replays the same events in the same frames") {
+        {
+            EventRecorder recorder(bus, path, 0.02f);
+            recorder.addType<TestMoveEvent>("TestMoveEvent");
+            recorder.start();
+
+            bus.emit<TestMoveEvent>(1.0f, 0.0f);
+            bus.emit<TestMoveEvent>(2.0f, 0.0f);
+            bus.update();
+            bus.update();
+            bus.emit<TestMoveEvent>(3.0f, 0.0f);
+            bus.emit<TestNamedEvent>("not recorded");
+            bus.update();
+
+            // The frame in progress when recording stops is left out
+            bus.emit<TestMoveEvent>(4.0f, 0.0f);
+            REQUIRE(recorder.getRecordedFrameCount() == 3);
+            recorder.stop();
+        }
+
+        EventReplay replay(path);
+        replay.addType<TestMoveEvent>("TestMoveEvent");
+        REQUIRE(replay.getFrameCount() == 3);
+        REQUIRE(replay.getTimestep() == 0.02f);
+
+        std::vector<std::vector<float>> frames;
+        while (!replay.isFinished()) {
+            std::vector<float>& frame = frames.emplace_back();
+            replay.forEach<TestMoveEvent>([&frame](const TestMoveEvent& event) {
+                frame.push_back(event.x);
+            });
+            replay.nextFrame();
+        }
+        REQUIRE(frames == std::vector<std::vector<float>>{ { 1.0f, 2.0f }, {}, { 3.0f } });
+    }
+
+    SECTION("Recorded input drives InputCollectSystem like SDL did") {
+        auto rawEvent = [](uint32_t type, SDL_Scancode scancode) {
+            SDL_Event event{};
+            event.type = type;
+            if (type != SDL_QUIT) {
+                event.key.keysym.scancode = scancode;
+                event.key.repeat = 0;
+            }
+            return events::RawInputEvent(event);
+        };
+        {
+            EventRecorder recorder(bus, path, 1.0f / 60.0f);
+            events::addInputEventTypes(recorder);
+            recorder.start();
+
+            bus.emit<events::RawInputEvent>(rawEvent(SDL_KEYDOWN, SDL_SCANCODE_W));
+            bus.update();
+            bus.update();
+            bus.emit<events::RawInputEvent>(rawEvent(SDL_KEYUP, SDL_SCANCODE_W));
+            bus.update();
+            bus.emit<events::RawInputEvent>(rawEvent(SDL_QUIT, SDL_SCANCODE_UNKNOWN));
+            bus.update();
+            recorder.stop();
+        }
+
+        EventReplay replay(path);
+        events::addInputEventTypes(replay);
+        InputState inputState;
+        GlobalFlags globalFlags;
+        EventBus replayBus;
+        InputCollectSystem inputCollect;
+        inputCollect.init(&inputState, &globalFlags, &replayBus);
+        inputCollect.setReplay(&replay);
+
+        std::vector<bool> pressed;
+        while (!replay.isFinished()) {
+            inputCollect.update(replay.getTimestep());
+            replayBus.update();
+            pressed.push_back(inputState.isKeyPressed(SDL_SCANCODE_W));
+        }
+        REQUIRE(pressed == std::vector<bool>{ true, true, false, false });
+        REQUIRE(globalFlags.quit);
+        REQUIRE(replayBus.getEventCount<events::RawInputEvent>() == 1);
+        REQUIRE(replayBus.read<events::SceneTransition>().size() == 1);
+        REQUIRE(replayBus.read<events::SceneTransition>()[0].type == events::SceneTransition::Type::QUIT);
+    }
+
+    SECTION("Damaged or mismatched logs are rejected") {
+        {
+            EventRecorder recorder(bus, path, 0.02f);
+            recorder.addType<TestMoveEvent>("TestMoveEvent");
+            recorder.start();
+            bus.emit<TestMoveEvent>(1.0f, 0.0f);
+            bus.update();
+            recorder.stop();
+        }
+        {
+            EventReplay replay(path);
+            REQUIRE_THROWS_AS(replay.addType<uint32_t>("TestMoveEvent"), std::runtime_error);
+        }
+
+        std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+        REQUIRE_THROWS_AS(EventReplay(path), std::runtime_error);
+
+        std::ofstream(path, std::ios::binary | std::ios::trunc) << "not an event log, but long enough to hold a header";
+        REQUIRE_THROWS_AS(EventReplay(path), std::runtime_error);
+    }
+
+    std::filesystem::remove(path);
+}
+
 TEST_CASE("ECS Integration Test", "[ECS][Integration]") {
     auto coordinator = createCoordinator();
 
@@ -47,3 +47,20 @@ TEST_CASE("Registry Debug - Step 3: initializeCommonTypes", "[regdebug]") {
     std::cout << "initializeCommonTypes completed successfully!" << std::endl;
     REQUIRE(true);
 }
+
+TEST_CASE("Registry Debug - Step 4: Cached type IDs match the registry", "[regdebug]") {
+    auto first = createCoordinator();
+    auto second = createCoordinator();
+
+    // Register in different orders; IDs must still agree with the registry
+    first->registerComponent<Transform>();
+    first->registerComponent<Health>();
+    second->registerComponent<Health>();
+    second->registerComponent<Transform>();
+
+    REQUIRE(first->getComponentType<Transform>() == ComponentTypeRegistry::getOrRegisterType<Transform>());
+    REQUIRE(first->getComponentType<Health>() == ComponentTypeRegistry::getOrRegisterType<Health>());
+    REQUIRE(second->getComponentType<Transform>() == first->getComponentType<Transform>());
+    REQUIRE(second->getComponentType<Health>() == first->getComponentType<Health>());
+    REQUIRE(ComponentManager::typeId<Velocity>() == ComponentTypeRegistry::getOrRegisterType<Velocity>());
+}
@@ -84,6 +84,40 @@ TEST_CASE("Scene System Integration Tests", "[scene_integration]") {
         std::cout << "✅ Transform system integration successful!" << std::endl;
     }
     
+    SECTION("Transform Sync Follows Component Changes") {
+        auto coordinator = ecs::createCoordinator();
+        coordinator->registerComponent<ecs::components::Transform>();
+
+        ecs::Entity parentEntity = coordinator->createEntity();
+        ecs::Entity childEntity = coordinator->createEntity();
+        coordinator->addComponent(parentEntity, ecs::components::Transform{ math::Vec3f{1.0f, 0.0f, 0.0f} });
+        coordinator->addComponent(childEntity, ecs::components::Transform{ math::Vec3f{0.0f, 2.0f, 0.0f} });
+
+        SceneNode root(parentEntity, "Parent");
+        SceneNode* child = root.addChild(std::make_unique<SceneNode>(childEntity, "Child"));
+
+        TransformSyncSystem transformSync;
+        transformSync.setCoordinator(coordinator.get());
+        transformSync.registerNode(parentEntity, &root);
+        transformSync.registerNode(childEntity, child);
+
+        transformSync.update(0.016f);
+        REQUIRE(child->getWorldMatrix()(0, 3) == 1.0f);
+        REQUIRE(child->getWorldMatrix()(1, 3) == 2.0f);
+
+        // Writing the child's Transform is picked up without touching the node
+        coordinator->getComponent<ecs::components::Transform>(childEntity).position[1] = 5.0f;
+        transformSync.update(0.016f);
+        REQUIRE(child->getWorldMatrix()(1, 3) == 5.0f);
+        REQUIRE_FALSE(root.isTransformDirty());
+
+        // A parent change reaches the child's world matrix
+        coordinator->getComponent<ecs::components::Transform>(parentEntity).position[0] = 3.0f;
+        transformSync.update(0.016f);
+        REQUIRE(child->getWorldMatrix()(0, 3) == 3.0f);
+        REQUIRE(child->getWorldMatrix()(1, 3) == 5.0f);
+    }
+    
     SECTION("Scene Manager Operations") {
         std::cout << "Testing scene manager operations..." << std::endl;
         
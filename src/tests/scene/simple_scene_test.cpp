@@ -4,6 +4,8 @@
 #include "../../ecs/components/CommonComponents.h"
 #include "../../ecs/systems/TransformSyncSystem.h"
 #include "../../ecs/ECS.h"
+#include <filesystem>
+#include <string>
 
 using namespace scene;
 using namespace ecs;
@@ -60,3 +62,30 @@ TEST_CASE("Simple Scene Test", "[simplescene]") {
         }());
     }
 }
+
+TEST_CASE("Scene world file round trip", "[simplescene][WorldFile]") {
+    const std::string path = (std::filesystem::temp_directory_path() / "scene_world_file_test.ecsw").string();
+
+    // Built in code, as scenes do in onAttach
+    SimpleTestScene source;
+    auto* sourceCoordinator = source.getCoordinator();
+    Entity player = sourceCoordinator->createEntity();
+    sourceCoordinator->addComponent(player, ecs::components::Transform{ math::Vec3f{1.0f, 2.0f, 0.0f} });
+    sourceCoordinator->addComponent(player, ecs::components::Renderable2D::createSprite("player", math::Vec2f(32.0f, 32.0f), 5));
+    sourceCoordinator->addComponent(player, ecs::components::PlayerTag{});
+    sourceCoordinator->createEntities(100, ecs::components::Transform{}, ecs::components::Health{ 20.0f });
+    source.saveWorld(path);
+
+    SimpleTestScene loaded;
+    loaded.loadWorld(path);
+    const Coordinator& coordinator = *loaded.getCoordinator();
+
+    REQUIRE(coordinator.getLivingEntityCount() == 101);
+    REQUIRE(coordinator.getComponent<ecs::components::Transform>(player).position[1] == 2.0f);
+    REQUIRE(coordinator.hasComponent<ecs::components::PlayerTag>(player));
+    REQUIRE(coordinator.getComponent<ecs::components::Renderable2D>(player).textureId == "player");
+    REQUIRE(coordinator.getComponent<ecs::components::Renderable2D>(player).layer == 5);
+    REQUIRE(coordinator.getComponentCount<ecs::components::Health>() == 100);
+
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,96 @@
+#include <catch2/catch_test_macros.hpp>
+#include "../core/Trace.h"
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace core;
+
+namespace {
+
+    size_t countOccurrences(const std::string& text, const std::string& pattern) {
+        size_t count = 0;
+        for (size_t at = text.find(pattern); at != std::string::npos; at = text.find(pattern, at + 1)) {
+            ++count;
+        }
+        return count;
+    }
+
+    std::string dumpTrace() {
+        std::ostringstream out;
+        Trace::writeChromeTrace(out);
+        return out.str();
+    }
+
+} // namespace
+
+TEST_CASE("Trace zones", "[trace]") {
+    Trace::clear();
+
+    SECTION("Recorded zones are written as complete events") {
+        const int64_t start = Trace::now();
+        Trace::record("TraceTest::zone", start, start + 1500);
+
+        const std::string json = dumpTrace();
+        REQUIRE(json.rfind("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 0) == 0);
+        REQUIRE(countOccurrences(json, "\"name\":\"TraceTest::zone\"") == 1);
+        REQUIRE(json.find("\"dur\":1.500") != std::string::npos);
+    }
+
+    SECTION("Clearing drops earlier zones") {
+        const int64_t start = Trace::now();
+        Trace::record("TraceTest::cleared", start, start + 10);
+        Trace::clear();
+        Trace::record("TraceTest::kept", Trace::now(), Trace::now());
+
+        const std::string json = dumpTrace();
+        REQUIRE(json.find("TraceTest::cleared") == std::string::npos);
+        REQUIRE(json.find("TraceTest::kept") != std::string::npos);
+    }
+
+    SECTION("A full ring keeps the most recent zones") {
+        const int64_t start = Trace::now();
+        for (size_t i = 0; i < Trace::THREAD_BUFFER_SIZE; ++i) {
+            Trace::record("TraceTest::old", start, start);
+        }
+        for (size_t i = 0; i < Trace::THREAD_BUFFER_SIZE; ++i) {
+            Trace::record("TraceTest::new", start, start);
+        }
+
+        const std::string json = dumpTrace();
+        REQUIRE(countOccurrences(json, "TraceTest::old") == 0);
+        REQUIRE(countOccurrences(json, "TraceTest::new") == Trace::THREAD_BUFFER_SIZE);
+    }
+
+    SECTION("Each thread records into its own named track") {
+        std::vector<std::thread> threads;
+        for (int i = 0; i < 4; ++i) {
+            threads.emplace_back([i] {
+                Trace::setThreadName("TraceTest worker " + std::to_string(i));
+                for (int zone = 0; zone < 100; ++zone) {
+                    Trace::record("TraceTest::worker", Trace::now(), Trace::now());
+                }
+            });
+        }
+        // Dumping while the workers record only skips zones being rewritten
+        for (int dump = 0; dump < 10; ++dump) {
+            REQUIRE_FALSE(dumpTrace().empty());
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        const std::string json = dumpTrace();
+        REQUIRE(countOccurrences(json, "TraceTest::worker") == 400);
+        REQUIRE(countOccurrences(json, "TraceTest worker") == 4);
+    }
+
+    SECTION("TRACE_ZONE records only when trace zones are compiled in") {
+        {
+            TRACE_ZONE("TraceTest::macro");
+        }
+        const std::string json = dumpTrace();
+        REQUIRE(countOccurrences(json, "TraceTest::macro") == (TRACE_ZONES_ENABLED ? 1u : 0u));
+    }
+}